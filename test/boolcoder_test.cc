@@ -96,3 +96,44 @@ TEST(VP10, TestBitIO) {
     }
   }
 }
+
+TEST(VP10, TestBitIOLiteral) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kItemsToTest = 1000;
+  const int kBufferSize = 10000;
+  int data[kItemsToTest], bits[kItemsToTest];
+  uint8_t probas[kItemsToTest];
+
+  for (int n = 0; n < num_tests; ++n) {
+    // Interleave literals of up to 24 bits with bits of any probability, so
+    // that the literals start at every position of the reader's value.
+    for (int i = 0; i < kItemsToTest; ++i) {
+      bits[i] = (i & 1) ? 1 + rnd(24) : 0;
+      data[i] = bits[i] ? static_cast<int>(rnd.Rand31() >> (31 - bits[i]))
+                        : rnd(2);
+      probas[i] = static_cast<uint8_t>(1 + rnd(255));
+    }
+
+    vpx_writer bw;
+    uint8_t bw_buffer[kBufferSize];
+    vpx_start_encode(&bw, bw_buffer);
+    for (int i = 0; i < kItemsToTest; ++i) {
+      if (bits[i])
+        vpx_write_literal(&bw, data[i], bits[i]);
+      else
+        vpx_write(&bw, data[i], probas[i]);
+    }
+    vpx_stop_encode(&bw);
+
+    // Give the reader the exact size, so that it reaches the end of the
+    // buffer in the middle of the literals.
+    vpx_reader br;
+    vpx_reader_init(&br, bw_buffer, bw.pos, NULL, NULL);
+    for (int i = 0; i < kItemsToTest; ++i) {
+      const int value =
+          bits[i] ? vpx_read_literal(&br, bits[i]) : vpx_read(&br, probas[i]);
+      GTEST_ASSERT_EQ(data[i], value) << "pos: " << i << " bits: " << bits[i];
+    }
+    EXPECT_FALSE(vpx_reader_has_error(&br));
+  }
+}
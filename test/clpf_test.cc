@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp10_rtcd.h"
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+// The block is surrounded by a one pixel border for its neighbours.
+const int kStride = 16;
+const int kBufSize = kStride * 10;
+const int kNumTests = 10000;
+const int kNumSpeedTests = 10000000;
+
+typedef void (*ClpfBlockFunc)(const uint8_t *src, uint8_t *dst, int sstride,
+                              int dstride, int has_top, int has_left,
+                              int has_bottom, int has_right, int width,
+                              int height);
+
+// <optimized, reference, width, height>
+typedef std::tr1::tuple<ClpfBlockFunc, ClpfBlockFunc, int, int> ClpfParam;
+
+class ClpfBlockTest : public ::testing::TestWithParam<ClpfParam> {
+ public:
+  virtual ~ClpfBlockTest() {}
+  virtual void SetUp() {
+    clpf_ = GET_PARAM(0);
+    ref_clpf_ = GET_PARAM(1);
+    width_ = GET_PARAM(2);
+    height_ = GET_PARAM(3);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  ClpfBlockFunc clpf_;
+  ClpfBlockFunc ref_clpf_;
+  int width_;
+  int height_;
+};
+
+TEST_P(ClpfBlockTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[kBufSize]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kBufSize]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[kBufSize]);
+  const uint8_t *const block = src + kStride + 1;
+  for (int i = 0; i < kNumTests; ++i) {
+    const int edges = i & 15;
+    const int mode = rnd.Rand8() % 3;
+    const int base = rnd.Rand8();
+    for (int j = 0; j < kBufSize; ++j) {
+      if (mode == 0) {
+        src[j] = rnd.Rand8();
+      } else if (mode == 1) {
+        // Flat areas with small steps, and the extreme values.
+        src[j] = clamp(base + (rnd.Rand8() % 3) - 1, 0, 255);
+      } else {
+        src[j] = (rnd.Rand8() & 1) ? 255 : 0;
+      }
+    }
+    memset(dst, 0, sizeof(dst));
+    memset(ref_dst, 0, sizeof(ref_dst));
+    ref_clpf_(block, ref_dst, kStride, kStride, edges & 1, edges & 2,
+              edges & 4, edges & 8, width_, height_);
+    ASM_REGISTER_STATE_CHECK(clpf_(block, dst, kStride, kStride, edges & 1,
+                                   edges & 2, edges & 4, edges & 8, width_,
+                                   height_));
+    for (int j = 0; j < kBufSize; ++j) {
+      ASSERT_EQ(ref_dst[j], dst[j])
+          << "test " << i << " row " << j / kStride << " col " << j % kStride
+          << " edges " << edges;
+    }
+  }
+}
+
+TEST_P(ClpfBlockTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[kBufSize]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kBufSize]);
+  const uint8_t *const block = src + kStride + 1;
+  vpx_usec_timer ref_timer, timer;
+  for (int j = 0; j < kBufSize; ++j) src[j] = rnd.Rand8();
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    ref_clpf_(block, dst, kStride, kStride, 1, 1, 1, 1, width_, height_);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    clpf_(block, dst, kStride, kStride, 1, 1, 1, 1, width_, height_);
+  vpx_usec_timer_mark(&timer);
+
+  printf("clpf %dx%d: reference %d us, optimized %d us\n", width_, height_,
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, ClpfBlockTest,
+    ::testing::Values(make_tuple(&vp10_clpf_block_sse2, &vp10_clpf_block_c, 8,
+                                 8),
+                      make_tuple(&vp10_clpf_block_sse2, &vp10_clpf_block_c, 8,
+                                 4),
+                      make_tuple(&vp10_clpf_block_sse2, &vp10_clpf_block_c, 4,
+                                 4)));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ClpfBlockTest,
+    ::testing::Values(make_tuple(&vp10_clpf_block_avx2, &vp10_clpf_block_c, 8,
+                                 8),
+                      make_tuple(&vp10_clpf_block_avx2, &vp10_clpf_block_c, 8,
+                                 4),
+                      make_tuple(&vp10_clpf_block_avx2, &vp10_clpf_block_c, 4,
+                                 4)));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -814,6 +814,19 @@ INSTANTIATE_TEST_CASE_P(
                                  &vp10_iht16x16_256_add_sse2, 3, VPX_BITS_8)));
 #endif  // HAVE_SSE2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 
+#if HAVE_AVX2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Trans16x16HT,
+    ::testing::Values(make_tuple(&vp10_fht16x16_avx2,
+                                 &vp10_iht16x16_256_add_avx2, 0, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2,
+                                 &vp10_iht16x16_256_add_avx2, 1, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2,
+                                 &vp10_iht16x16_256_add_avx2, 2, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2,
+                                 &vp10_iht16x16_256_add_avx2, 3, VPX_BITS_8)));
+#endif  // HAVE_AVX2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
 #if HAVE_SSE2 && CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 INSTANTIATE_TEST_CASE_P(
     SSE2, Trans16x16DCT,
@@ -850,6 +863,19 @@ INSTANTIATE_TEST_CASE_P(
                                  3167, VPX_BITS_12)));
 #endif  // HAVE_SSE2 && CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 
+#if HAVE_AVX2 && CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Trans16x16HT,
+    ::testing::Values(make_tuple(&vp10_fht16x16_avx2, &vp10_iht16x16_256_add_c,
+                                 0, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_iht16x16_256_add_c,
+                                 1, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_iht16x16_256_add_c,
+                                 2, VPX_BITS_8),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_iht16x16_256_add_c,
+                                 3, VPX_BITS_8)));
+#endif  // HAVE_AVX2 && CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
 #if HAVE_MSA && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
 INSTANTIATE_TEST_CASE_P(MSA, Trans16x16DCT,
                         ::testing::Values(make_tuple(&vpx_fdct16x16_msa,
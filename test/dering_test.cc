@@ -0,0 +1,447 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp10_rtcd.h"
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+extern "C" {
+#include "vp10/common/od_dering.h"
+}
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+// Value od_dering() stores in the border of its input buffer for the pixels
+// outside the frame.
+const int kVeryLarge = 30000;
+const int kBufSize = OD_FILT_BSTRIDE * OD_FILT_BSTRIDE;
+const int kOutStride = 16;
+const int kNumTests = 10000;
+const int kNumSpeedTests = 1000000;
+
+typedef void (*DirectionFunc)(int16_t *y, int ystride, const int16_t *in,
+                              int threshold, int dir);
+typedef void (*OrthogonalFunc)(int16_t *y, int ystride, const int16_t *in,
+                               const int16_t *x, int xstride, int threshold,
+                               int dir);
+typedef int (*DirFindFunc)(const int16_t *img, int stride, int32_t *var,
+                           int coeff_shift);
+typedef uint64_t (*DeringSseFunc)(const int16_t *a, int a_stride,
+                                  const int16_t *b, int b_stride, int width,
+                                  int height);
+
+// <optimized, reference, log2 block size>
+typedef std::tr1::tuple<DirectionFunc, DirectionFunc, int> DirectionParam;
+typedef std::tr1::tuple<OrthogonalFunc, OrthogonalFunc, int> OrthogonalParam;
+typedef std::tr1::tuple<DirFindFunc, DirFindFunc> DirFindParam;
+typedef std::tr1::tuple<DeringSseFunc, DeringSseFunc> DeringSseParam;
+
+// Fills the deringing input buffer with pixels of depth 'bd', some of them
+// close to each other so that they pass the threshold tests, and some of the
+// border set to kVeryLarge as od_dering() does at the frame edges.
+void FillInput(ACMRandom *rnd, int16_t *buf, int bd) {
+  const int mode = rnd->Rand8() % 3;
+  const int mask = (1 << bd) - 1;
+  const int base = rnd->Rand16() & mask;
+  for (int i = 0; i < kBufSize; ++i) {
+    if (mode == 0) {
+      buf[i] = rnd->Rand16() & mask;
+    } else {
+      buf[i] = clamp(base + (rnd->Rand8() % 32) - 16, 0, mask);
+    }
+  }
+  if (mode == 2) {
+    const int edge = rnd->Rand8() % 4;
+    for (int i = 0; i < OD_FILT_BSTRIDE; ++i) {
+      for (int j = 0; j < OD_FILT_BORDER; ++j) {
+        switch (edge) {
+          case 0: buf[j * OD_FILT_BSTRIDE + i] = kVeryLarge; break;
+          case 1: buf[i * OD_FILT_BSTRIDE + j] = kVeryLarge; break;
+          case 2:
+            buf[(OD_FILT_BSTRIDE - 1 - j) * OD_FILT_BSTRIDE + i] = kVeryLarge;
+            break;
+          default:
+            buf[i * OD_FILT_BSTRIDE + OD_FILT_BSTRIDE - 1 - j] = kVeryLarge;
+            break;
+        }
+      }
+    }
+  }
+}
+
+int RandomThreshold(ACMRandom *rnd, int bd) {
+  // Include thresholds beyond the usual range to exercise the 16-bit sums.
+  if (rnd->Rand8() < 16) return rnd->Rand16() & 0x7fff;
+  return rnd->Rand8() % (64 << (bd - 8));
+}
+
+// The block is placed at the far corner of the superblock to check that the
+// kernels do not read past the border.
+const int16_t *BlockStart(const int16_t *buf, int log_size) {
+  const int offset = OD_FILT_BORDER + OD_BSIZE_MAX - (1 << log_size);
+  return buf + offset * OD_FILT_BSTRIDE + offset;
+}
+
+class DeringDirectionTest : public ::testing::TestWithParam<DirectionParam> {
+ public:
+  virtual ~DeringDirectionTest() {}
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    log_size_ = GET_PARAM(2);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  DirectionFunc filter_;
+  DirectionFunc ref_filter_;
+  int log_size_;
+};
+
+TEST_P(DeringDirectionTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, in[kBufSize]);
+  DECLARE_ALIGNED(16, int16_t, out[8 * kOutStride]);
+  DECLARE_ALIGNED(16, int16_t, ref_out[8 * kOutStride]);
+  const int size = 1 << log_size_;
+  for (int i = 0; i < kNumTests; ++i) {
+    const int bd = 8 + 2 * (i % 3);
+    const int threshold = RandomThreshold(&rnd, bd);
+    const int dir = rnd.Rand8() % 8;
+    FillInput(&rnd, in, bd);
+    memset(out, 0, sizeof(out));
+    memset(ref_out, 0, sizeof(ref_out));
+    ref_filter_(ref_out, kOutStride, BlockStart(in, log_size_), threshold,
+                dir);
+    ASM_REGISTER_STATE_CHECK(
+        filter_(out, kOutStride, BlockStart(in, log_size_), threshold, dir));
+    for (int r = 0; r < size; ++r) {
+      for (int c = 0; c < kOutStride; ++c) {
+        ASSERT_EQ(ref_out[r * kOutStride + c], out[r * kOutStride + c])
+            << "test " << i << " row " << r << " col " << c
+            << " threshold " << threshold << " dir " << dir;
+      }
+    }
+  }
+}
+
+TEST_P(DeringDirectionTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, in[kBufSize]);
+  DECLARE_ALIGNED(16, int16_t, out[8 * kOutStride]);
+  const int16_t *const block = BlockStart(in, log_size_);
+  vpx_usec_timer ref_timer, timer;
+  FillInput(&rnd, in, 8);
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    ref_filter_(out, kOutStride, block, 32, i & 7);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    filter_(out, kOutStride, block, 32, i & 7);
+  vpx_usec_timer_mark(&timer);
+
+  printf("direction %dx%d: reference %d us, optimized %d us\n",
+         1 << log_size_, 1 << log_size_,
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+
+class DeringOrthogonalTest : public ::testing::TestWithParam<OrthogonalParam> {
+ public:
+  virtual ~DeringOrthogonalTest() {}
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    log_size_ = GET_PARAM(2);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  OrthogonalFunc filter_;
+  OrthogonalFunc ref_filter_;
+  int log_size_;
+};
+
+TEST_P(DeringOrthogonalTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, in[kBufSize]);
+  DECLARE_ALIGNED(16, int16_t, x[8 * kOutStride]);
+  DECLARE_ALIGNED(16, int16_t, out[8 * kOutStride]);
+  DECLARE_ALIGNED(16, int16_t, ref_out[8 * kOutStride]);
+  const int size = 1 << log_size_;
+  for (int i = 0; i < kNumTests; ++i) {
+    const int bd = 8 + 2 * (i % 3);
+    const int mask = (1 << bd) - 1;
+    const int threshold = RandomThreshold(&rnd, bd);
+    const int dir = rnd.Rand8() % 8;
+    const int16_t *const block = BlockStart(in, log_size_);
+    FillInput(&rnd, in, bd);
+    // The unfiltered source is close to the direction-filtered input.
+    for (int r = 0; r < 8; ++r) {
+      for (int c = 0; c < kOutStride; ++c) {
+        x[r * kOutStride + c] =
+            r < size && c < size
+                ? clamp(block[r * OD_FILT_BSTRIDE + c] +
+                            (rnd.Rand8() % 16) - 8, 0, mask)
+                : 0;
+      }
+    }
+    memset(out, 0, sizeof(out));
+    memset(ref_out, 0, sizeof(ref_out));
+    ref_filter_(ref_out, kOutStride, block, x, kOutStride, threshold, dir);
+    ASM_REGISTER_STATE_CHECK(
+        filter_(out, kOutStride, block, x, kOutStride, threshold, dir));
+    for (int r = 0; r < size; ++r) {
+      for (int c = 0; c < kOutStride; ++c) {
+        ASSERT_EQ(ref_out[r * kOutStride + c], out[r * kOutStride + c])
+            << "test " << i << " row " << r << " col " << c
+            << " threshold " << threshold << " dir " << dir;
+      }
+    }
+  }
+}
+
+TEST_P(DeringOrthogonalTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, in[kBufSize]);
+  DECLARE_ALIGNED(16, int16_t, x[8 * kOutStride]);
+  DECLARE_ALIGNED(16, int16_t, out[8 * kOutStride]);
+  const int16_t *const block = BlockStart(in, log_size_);
+  vpx_usec_timer ref_timer, timer;
+  FillInput(&rnd, in, 8);
+  for (int i = 0; i < 8 * kOutStride; ++i) x[i] = rnd.Rand8();
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    ref_filter_(out, kOutStride, block, x, kOutStride, 32, i & 7);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    filter_(out, kOutStride, block, x, kOutStride, 32, i & 7);
+  vpx_usec_timer_mark(&timer);
+
+  printf("orthogonal %dx%d: reference %d us, optimized %d us\n",
+         1 << log_size_, 1 << log_size_,
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+
+class DeringDirFindTest : public ::testing::TestWithParam<DirFindParam> {
+ public:
+  virtual ~DeringDirFindTest() {}
+  virtual void SetUp() {
+    dir_find_ = GET_PARAM(0);
+    ref_dir_find_ = GET_PARAM(1);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  DirFindFunc dir_find_;
+  DirFindFunc ref_dir_find_;
+};
+
+TEST_P(DeringDirFindTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, img[8 * kOutStride]);
+  for (int i = 0; i < kNumTests; ++i) {
+    const int bd = 8 + 2 * (i % 3);
+    const int mask = (1 << bd) - 1;
+    const int mode = rnd.Rand8() % 3;
+    int32_t var, ref_var;
+    int dir, ref_dir;
+    for (int j = 0; j < 8 * kOutStride; ++j) {
+      if (mode == 0) {
+        img[j] = rnd.Rand16() & mask;
+      } else if (mode == 1) {
+        // Extreme values maximize the partial sums.
+        img[j] = (rnd.Rand8() & 1) ? mask : 0;
+      } else {
+        // A directional edge with some noise.
+        const int r = j / kOutStride, c = j % kOutStride;
+        img[j] = clamp(((r * (i % 5) + c * (i % 7)) & 4 ? mask : 0) +
+                           (rnd.Rand8() % 32) - 16, 0, mask);
+      }
+    }
+    ref_dir = ref_dir_find_(img, kOutStride, &ref_var, bd - 8);
+    ASM_REGISTER_STATE_CHECK(dir = dir_find_(img, kOutStride, &var, bd - 8));
+    ASSERT_EQ(ref_dir, dir) << "test " << i;
+    ASSERT_EQ(ref_var, var) << "test " << i;
+  }
+}
+
+TEST_P(DeringDirFindTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, img[8 * kOutStride]);
+  vpx_usec_timer ref_timer, timer;
+  int32_t var;
+  for (int j = 0; j < 8 * kOutStride; ++j) img[j] = rnd.Rand8();
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumSpeedTests; ++i)
+    ref_dir_find_(img, kOutStride, &var, 0);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumSpeedTests; ++i) dir_find_(img, kOutStride, &var, 0);
+  vpx_usec_timer_mark(&timer);
+
+  printf("dir_find8: reference %d us, optimized %d us\n",
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+
+#if CONFIG_VP10_ENCODER
+class DeringSseTest : public ::testing::TestWithParam<DeringSseParam> {
+ public:
+  virtual ~DeringSseTest() {}
+  virtual void SetUp() {
+    sse_ = GET_PARAM(0);
+    ref_sse_ = GET_PARAM(1);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  DeringSseFunc sse_;
+  DeringSseFunc ref_sse_;
+};
+
+TEST_P(DeringSseTest, MatchesReference) {
+  const int kSseStride = 72;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, a[64 * kSseStride]);
+  DECLARE_ALIGNED(16, int16_t, b[64 * kSseStride]);
+  for (int i = 0; i < kNumTests / 10; ++i) {
+    const int bd = 8 + 2 * (i % 3);
+    const int mask = (1 << bd) - 1;
+    // Superblocks at the frame edges have any multiple of 8 pixels.
+    const int width = 8 * (1 + rnd.Rand8() % 8);
+    const int height = 8 * (1 + rnd.Rand8() % 8);
+    for (int j = 0; j < 64 * kSseStride; ++j) {
+      if (i & 1) {
+        a[j] = rnd.Rand16() & mask;
+        b[j] = rnd.Rand16() & mask;
+      } else {
+        // The largest differences.
+        a[j] = (rnd.Rand8() & 1) ? mask : 0;
+        b[j] = mask - a[j];
+      }
+    }
+    uint64_t ref_sse = ref_sse_(a, kSseStride, b, kSseStride, width, height);
+    uint64_t sse;
+    ASM_REGISTER_STATE_CHECK(
+        sse = sse_(a, kSseStride, b, kSseStride, width, height));
+    ASSERT_EQ(ref_sse, sse) << "test " << i << " " << width << "x" << height;
+  }
+}
+
+TEST_P(DeringSseTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, a[64 * 64]);
+  DECLARE_ALIGNED(16, int16_t, b[64 * 64]);
+  vpx_usec_timer ref_timer, timer;
+  for (int j = 0; j < 64 * 64; ++j) {
+    a[j] = rnd.Rand8();
+    b[j] = rnd.Rand8();
+  }
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < kNumSpeedTests / 10; ++i)
+    ref_sse_(a, 64, b, 64, 64, 64);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumSpeedTests / 10; ++i) sse_(a, 64, b, 64, 64, 64);
+  vpx_usec_timer_mark(&timer);
+
+  printf("dering_sse 64x64: reference %d us, optimized %d us\n",
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+#endif  // CONFIG_VP10_ENCODER
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(
+    SSE2, DeringDirectionTest,
+    ::testing::Values(make_tuple(&od_filter_dering_direction_4x4_sse2,
+                                 &od_filter_dering_direction_4x4_c, 2),
+                      make_tuple(&od_filter_dering_direction_8x8_sse2,
+                                 &od_filter_dering_direction_8x8_c, 3)));
+INSTANTIATE_TEST_CASE_P(
+    SSE2, DeringOrthogonalTest,
+    ::testing::Values(make_tuple(&od_filter_dering_orthogonal_4x4_sse2,
+                                 &od_filter_dering_orthogonal_4x4_c, 2),
+                      make_tuple(&od_filter_dering_orthogonal_8x8_sse2,
+                                 &od_filter_dering_orthogonal_8x8_c, 3)));
+#endif  // HAVE_SSE2
+
+#if HAVE_SSE2 && CONFIG_VP10_ENCODER
+INSTANTIATE_TEST_CASE_P(
+    SSE2, DeringSseTest,
+    ::testing::Values(make_tuple(&vp10_dering_sse_sse2, &vp10_dering_sse_c)));
+#endif  // HAVE_SSE2 && CONFIG_VP10_ENCODER
+
+#if HAVE_SSSE3
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, DeringDirectionTest,
+    ::testing::Values(make_tuple(&od_filter_dering_direction_4x4_ssse3,
+                                 &od_filter_dering_direction_4x4_c, 2),
+                      make_tuple(&od_filter_dering_direction_8x8_ssse3,
+                                 &od_filter_dering_direction_8x8_c, 3)));
+INSTANTIATE_TEST_CASE_P(
+    SSSE3, DeringOrthogonalTest,
+    ::testing::Values(make_tuple(&od_filter_dering_orthogonal_4x4_ssse3,
+                                 &od_filter_dering_orthogonal_4x4_c, 2),
+                      make_tuple(&od_filter_dering_orthogonal_8x8_ssse3,
+                                 &od_filter_dering_orthogonal_8x8_c, 3)));
+#endif  // HAVE_SSSE3
+
+#if HAVE_SSE4_1
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, DeringDirFindTest,
+    ::testing::Values(make_tuple(&od_dir_find8_sse4_1, &od_dir_find8_c)));
+#endif  // HAVE_SSE4_1
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DeringDirectionTest,
+    ::testing::Values(make_tuple(&od_filter_dering_direction_8x8_avx2,
+                                 &od_filter_dering_direction_8x8_c, 3)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DeringOrthogonalTest,
+    ::testing::Values(make_tuple(&od_filter_dering_orthogonal_8x8_avx2,
+                                 &od_filter_dering_orthogonal_8x8_c, 3)));
+#endif  // HAVE_AVX2
+
+#if HAVE_AVX2 && CONFIG_VP10_ENCODER
+INSTANTIATE_TEST_CASE_P(
+    AVX2, DeringSseTest,
+    ::testing::Values(make_tuple(&vp10_dering_sse_avx2, &vp10_dering_sse_c)));
+#endif  // HAVE_AVX2 && CONFIG_VP10_ENCODER
+}  // namespace
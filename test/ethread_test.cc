@@ -20,11 +20,13 @@
 namespace {
 class VPxEncoderThreadTest
     : public ::libvpx_test::EncoderTest,
-      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+      public ::libvpx_test::CodecTestWith3Params<libvpx_test::TestMode, int,
+                                                 int> {
  protected:
   VPxEncoderThreadTest()
       : EncoderTest(GET_PARAM(0)), encoder_initialized_(false), tiles_(2),
-        encoding_mode_(GET_PARAM(1)), set_cpu_used_(GET_PARAM(2)) {
+        encoding_mode_(GET_PARAM(1)), set_cpu_used_(GET_PARAM(2)),
+        row_mt_(GET_PARAM(3)), thread_pool_(NULL) {
     init_flags_ = VPX_CODEC_USE_PSNR;
     vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
     cfg.w = 1280;
@@ -63,6 +65,9 @@ class VPxEncoderThreadTest
       // Encode 4 column tiles.
       encoder->Control(VP9E_SET_TILE_COLUMNS, tiles_);
       encoder->Control(VP8E_SET_CPUUSED, set_cpu_used_);
+      encoder->Control(VP9E_SET_ROW_MT, row_mt_);
+      if (thread_pool_ != NULL)
+        encoder->Control(VP10_SET_THREAD_POOL, thread_pool_);
       if (encoding_mode_ != ::libvpx_test::kRealTime) {
         encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
         encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
@@ -96,6 +101,8 @@ class VPxEncoderThreadTest
   int tiles_;
   ::libvpx_test::TestMode encoding_mode_;
   int set_cpu_used_;
+  int row_mt_;
+  vpx_codec_thread_pool_t *thread_pool_;
   ::libvpx_test::Decoder *decoder_;
   std::vector<std::string> md5_;
 };
@@ -122,10 +129,20 @@ TEST_P(VPxEncoderThreadTest, EncoderResultTest) {
 
   // Compare to check if two vectors are equal.
   ASSERT_EQ(single_thr_md5, multi_thr_md5);
+
+  // Encode using multiple threads, with the jobs run by a pool of fewer
+  // threads that the decoder shares.
+  thread_pool_ = vpx_codec_thread_pool_create(2);
+  ASSERT_TRUE(thread_pool_ != NULL);
+  decoder_->Control(VP10_SET_THREAD_POOL, thread_pool_);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  vpx_codec_thread_pool_destroy(thread_pool_);
+  thread_pool_ = NULL;
+  ASSERT_EQ(single_thr_md5, md5_);
 }
 
 VP10_INSTANTIATE_TEST_CASE(VPxEncoderThreadTest,
                            ::testing::Values(::libvpx_test::kTwoPassGood,
                                              ::libvpx_test::kOnePassGood),
-                           ::testing::Range(1, 3));
+                           ::testing::Range(1, 3), ::testing::Range(0, 2));
 }  // namespace
@@ -14,6 +14,7 @@
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
+#include "./vp10_rtcd.h"
 #include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
 #include "test/acm_random.h"
@@ -21,6 +22,7 @@
 #include "test/register_state_check.h"
 #include "test/util.h"
 #include "vp10/common/entropy.h"
+#include "vp10/common/quant_common.h"
 #include "vp10/common/scan.h"
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_integer.h"
@@ -342,5 +344,152 @@ INSTANTIATE_TEST_CASE_P(
                                  &vpx_highbd_quantize_b_32x32_c, VPX_BITS_12)));
 #endif  // HAVE_SSE2
 #endif  // CONFIG_VPX_HIGHBITDEPTH
+#else
+typedef void (*QuantizeQmFunc)(const tran_low_t *coeff, intptr_t count,
+                               int skip_block, const int16_t *zbin,
+                               const int16_t *round, const int16_t *quant,
+                               const int16_t *quant_shift, tran_low_t *qcoeff,
+                               tran_low_t *dqcoeff, const int16_t *dequant,
+                               uint16_t *eob, const int16_t *scan,
+                               const int16_t *iscan, const qm_val_t *qm,
+                               const qm_val_t *iqm);
+
+// <optimized, reference, bit_depth, is_32x32, is_fp>
+typedef std::tr1::tuple<QuantizeQmFunc, QuantizeQmFunc, vpx_bit_depth_t, int,
+                        int> QuantizeQmParam;
+
+class VP10QuantizeQmTest : public ::testing::TestWithParam<QuantizeQmParam> {
+ public:
+  virtual ~VP10QuantizeQmTest() {}
+  virtual void SetUp() {
+    quantize_op_ = GET_PARAM(0);
+    ref_quantize_op_ = GET_PARAM(1);
+    bit_depth_ = GET_PARAM(2);
+    is_32x32_ = GET_PARAM(3);
+    is_fp_ = GET_PARAM(4);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Sets up the quantizers for qindex the way vp10_init_quantizer() does:
+  // the DC values first, then the AC ones.
+  void SetQuantizers(ACMRandom *rnd, int qindex, int16_t *zbin,
+                     int16_t *round, int16_t *quant, int16_t *quant_shift,
+                     int16_t *dequant) {
+    const int rounding = rnd->Rand8() >> 1;
+    const int zbin_factor = 64 + rnd->Rand8() % 32;
+    for (int j = 0; j < 8; ++j) {
+      const int q = j ? vp10_ac_quant(qindex, 0, bit_depth_)
+                      : vp10_dc_quant(qindex, 0, bit_depth_);
+      int l = 0;
+      for (int t = q; t > 1; t >>= 1) ++l;
+      if (is_fp_)
+        quant[j] = (1 << 16) / q;
+      else
+        quant[j] = static_cast<int16_t>(1 + (1 << (16 + l)) / q - (1 << 16));
+      round[j] = (rounding * q) >> 7;
+      quant_shift[j] = 1 << (16 - l);
+      zbin[j] = ROUND_POWER_OF_TWO(zbin_factor * q, 7);
+      dequant[j] = q;
+    }
+  }
+
+  QuantizeQmFunc quantize_op_;
+  QuantizeQmFunc ref_quantize_op_;
+  vpx_bit_depth_t bit_depth_;
+  int is_32x32_;
+  int is_fp_;
+};
+
+TEST_P(VP10QuantizeQmTest, OperationCheck) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeff[1024]);
+  DECLARE_ALIGNED(16, int16_t, zbin[8]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff[1024]);
+  qm_val_t qm[1024], iqm[1024];
+  // The transforms add up to 7 bits to the residual for 8 bits of input.
+  const int max_coeff = (1 << (bit_depth_ + 6)) - 1;
+  const int number_of_iterations = 1000;
+
+  for (int i = 0; i < number_of_iterations; ++i) {
+    const int skip_block = i == 0;
+    const TX_SIZE sz = is_32x32_ ? TX_32X32 : (TX_SIZE)(i % 3);
+    const TX_TYPE tx_type = (TX_TYPE)((i >> 2) % 3);
+    const scan_order *const so = &vp10_scan_orders[sz][tx_type];
+    const int count = (4 << sz) * (4 << sz);
+    const int qindex = rnd(256);
+    uint16_t eob = rnd.Rand16(), ref_eob = eob;
+
+    SetQuantizers(&rnd, qindex, zbin, round, quant, quant_shift, dequant);
+    // Mostly small coefficients, which exercise the zbin, with a few large
+    // ones. The weights cover the range of the matrices in quant_common.c.
+    for (int j = 0; j < count; ++j) {
+      const int range = rnd(8) ? 4 * dequant[j != 0] : max_coeff;
+      coeff[j] = rnd(range + 1);
+      if (rnd.Rand8() & 1) coeff[j] = -coeff[j];
+      qm[j] = 10 + rnd(299);
+      iqm[j] = 13 + rnd(402);
+    }
+
+    ref_quantize_op_(coeff, count, skip_block, zbin, round, quant,
+                     quant_shift, ref_qcoeff, ref_dqcoeff, dequant, &ref_eob,
+                     so->scan, so->iscan, qm, iqm);
+    ASM_REGISTER_STATE_CHECK(quantize_op_(
+        coeff, count, skip_block, zbin, round, quant, quant_shift, qcoeff,
+        dqcoeff, dequant, &eob, so->scan, so->iscan, qm, iqm));
+
+    ASSERT_EQ(ref_eob, eob) << "iteration " << i;
+    for (int j = 0; j < count; ++j) {
+      ASSERT_EQ(ref_qcoeff[j], qcoeff[j]) << "iteration " << i << " coeff "
+                                          << j;
+      ASSERT_EQ(ref_dqcoeff[j], dqcoeff[j]) << "iteration " << i << " coeff "
+                                            << j;
+    }
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2
+#if CONFIG_VPX_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VP10QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&vpx_quantize_b_sse2, &vpx_quantize_b_c, VPX_BITS_8, 0, 0),
+        make_tuple(&vpx_quantize_b_32x32_sse2, &vpx_quantize_b_32x32_c,
+                   VPX_BITS_8, 1, 0),
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   VPX_BITS_8, 0, 0),
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   VPX_BITS_10, 0, 0),
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   VPX_BITS_12, 0, 0),
+        make_tuple(&vpx_highbd_quantize_b_32x32_sse2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_8, 1, 0),
+        make_tuple(&vpx_highbd_quantize_b_32x32_sse2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_10, 1, 0),
+        make_tuple(&vpx_highbd_quantize_b_32x32_sse2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_12, 1, 0)));
+#else
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VP10QuantizeQmTest,
+    ::testing::Values(
+        make_tuple(&vpx_quantize_b_sse2, &vpx_quantize_b_c, VPX_BITS_8, 0, 0),
+        make_tuple(&vpx_quantize_b_32x32_sse2, &vpx_quantize_b_32x32_c,
+                   VPX_BITS_8, 1, 0),
+        make_tuple(&vp10_quantize_fp_sse2, &vp10_quantize_fp_c, VPX_BITS_8, 0,
+                   1),
+        make_tuple(&vp10_quantize_fp_32x32_sse2, &vp10_quantize_fp_32x32_c,
+                   VPX_BITS_8, 1, 1)));
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+#endif  // HAVE_SSE2
 #endif  // CONFIG_AOM_QM
 }  // namespace
@@ -25,7 +25,7 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
  protected:
   TileIndependenceTest()
       : EncoderTest(GET_PARAM(0)), md5_fw_order_(), md5_inv_order_(),
-        n_tiles_(GET_PARAM(1)) {
+        md5_mt_(), md5_parse_ahead_(), md5_fp_(), n_tiles_(GET_PARAM(1)) {
     init_flags_ = VPX_CODEC_USE_PSNR;
     vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
     cfg.w = 704;
@@ -34,11 +34,21 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
     fw_dec_ = codec_->CreateDecoder(cfg, 0);
     inv_dec_ = codec_->CreateDecoder(cfg, 0);
     inv_dec_->Control(VP9_INVERT_TILE_DECODE_ORDER, 1);
+    parse_ahead_dec_ = codec_->CreateDecoder(cfg, 0);
+    parse_ahead_dec_->Control(VP10D_SET_PARSE_AHEAD, 1);
+    // Decodes the tile columns in parallel, or with a single tile column
+    // reconstructs the superblock rows in parallel.
+    cfg.threads = 4;
+    mt_dec_ = codec_->CreateDecoder(cfg, 0);
+    fp_dec_ = codec_->CreateDecoder(cfg, VPX_CODEC_USE_FRAME_THREADING, 0);
   }
 
   virtual ~TileIndependenceTest() {
     delete fw_dec_;
     delete inv_dec_;
+    delete mt_dec_;
+    delete parse_ahead_dec_;
+    delete fp_dec_;
   }
 
   virtual void SetUp() {
@@ -65,13 +75,29 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
     md5->Add(img);
   }
 
+  // Adds the frames that the frame parallel decoder has finished, which lag
+  // behind the packets.
+  void AddFrameParallelMD5() {
+    libvpx_test::DxDataIterator dec_iter = fp_dec_->GetDxData();
+    const vpx_image_t *img;
+    while ((img = dec_iter.Next()) != NULL) md5_fp_.Add(img);
+  }
+
   virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
     UpdateMD5(fw_dec_, pkt, &md5_fw_order_);
     UpdateMD5(inv_dec_, pkt, &md5_inv_order_);
+    UpdateMD5(mt_dec_, pkt, &md5_mt_);
+    UpdateMD5(parse_ahead_dec_, pkt, &md5_parse_ahead_);
+    const vpx_codec_err_t res = fp_dec_->DecodeFrame(
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+    ASSERT_EQ(VPX_CODEC_OK, res) << fp_dec_->DecodeError();
+    AddFrameParallelMD5();
   }
 
-  ::libvpx_test::MD5 md5_fw_order_, md5_inv_order_;
-  ::libvpx_test::Decoder *fw_dec_, *inv_dec_;
+  ::libvpx_test::MD5 md5_fw_order_, md5_inv_order_, md5_mt_, md5_parse_ahead_;
+  ::libvpx_test::MD5 md5_fp_;
+  ::libvpx_test::Decoder *fw_dec_, *inv_dec_, *mt_dec_, *parse_ahead_dec_;
+  ::libvpx_test::Decoder *fp_dec_;
 
  private:
   int n_tiles_;
@@ -80,6 +106,8 @@ class TileIndependenceTest : public ::libvpx_test::EncoderTest,
 // run an encode with 2 or 4 tiles, and do the decode both in normal and
 // inverted tile ordering. Ensure that the MD5 of the output in both cases
 // is identical. If so, tiles are considered independent and the test passes.
+// The multi-threaded decode, the one that parses ahead and the frame parallel
+// decode must match as well.
 TEST_P(TileIndependenceTest, MD5Match) {
   const vpx_rational timebase = { 33333333, 1000000000 };
   cfg_.g_timebase = timebase;
@@ -90,6 +118,9 @@ TEST_P(TileIndependenceTest, MD5Match) {
   libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 704, 144,
                                      timebase.den, timebase.num, 0, 30);
   ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  // Flush the frame parallel decoder.
+  ASSERT_EQ(VPX_CODEC_OK, fp_dec_->DecodeFrame(NULL, 0));
+  AddFrameParallelMD5();
 
   const char *md5_fw_str = md5_fw_order_.Get();
   const char *md5_inv_str = md5_inv_order_.Get();
@@ -98,6 +129,9 @@ TEST_P(TileIndependenceTest, MD5Match) {
   // output if it fails. Not sure if it's helpful since it's really just
   // a MD5...
   ASSERT_STREQ(md5_fw_str, md5_inv_str);
+  ASSERT_STREQ(md5_fw_str, md5_mt_.Get());
+  ASSERT_STREQ(md5_fw_str, md5_parse_ahead_.Get());
+  ASSERT_STREQ(md5_fw_str, md5_fp_.Get());
 }
 
 VP10_INSTANTIATE_TEST_CASE(TileIndependenceTest, ::testing::Range(0, 2, 1));
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp10_rtcd.h"
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vp10/common/quant_common.h"
+#include "vp10/common/scan.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+#if !CONFIG_AOM_QM && !CONFIG_VPX_HIGHBITDEPTH
+typedef void (*FdctQuantFunc)(const int16_t *input, int stride,
+                              tran_low_t *coeff, intptr_t n_coeffs,
+                              int skip_block, const int16_t *zbin,
+                              const int16_t *round, const int16_t *quant,
+                              const int16_t *quant_shift, tran_low_t *qcoeff,
+                              tran_low_t *dqcoeff, const int16_t *dequant,
+                              uint16_t *eob, const int16_t *scan,
+                              const int16_t *iscan);
+
+#if HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+// The C versions of the fused functions go through the run time dispatch, so
+// the kernel is checked against the C transform and quantizer instead.
+void fdct32x32_rd_quant_ref(const int16_t *input, int stride,
+                            tran_low_t *coeff, intptr_t n_coeffs,
+                            int skip_block, const int16_t *zbin,
+                            const int16_t *round, const int16_t *quant,
+                            const int16_t *quant_shift, tran_low_t *qcoeff,
+                            tran_low_t *dqcoeff, const int16_t *dequant,
+                            uint16_t *eob, const int16_t *scan,
+                            const int16_t *iscan) {
+  vpx_fdct32x32_rd_c(input, coeff, stride);
+  vp10_quantize_fp_32x32_c(coeff, n_coeffs, skip_block, zbin, round, quant,
+                           quant_shift, qcoeff, dqcoeff, dequant, eob, scan,
+                           iscan);
+}
+#endif  // HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+
+// <optimized, reference, tx_size>
+typedef std::tr1::tuple<FdctQuantFunc, FdctQuantFunc, TX_SIZE>
+    FdctQuantParam;
+
+class Vp10FdctQuantTest : public ::testing::TestWithParam<FdctQuantParam> {
+ public:
+  virtual ~Vp10FdctQuantTest() {}
+  virtual void SetUp() {
+    fdct_quant_ = GET_PARAM(0);
+    ref_fdct_quant_ = GET_PARAM(1);
+    tx_size_ = GET_PARAM(2);
+    size_ = 4 << tx_size_;
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  FdctQuantFunc fdct_quant_;
+  FdctQuantFunc ref_fdct_quant_;
+  TX_SIZE tx_size_;
+  int size_;
+};
+
+TEST_P(Vp10FdctQuantTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, coeff[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_coeff[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff[32 * 32]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff[32 * 32]);
+  DECLARE_ALIGNED(16, int16_t, zbin[8]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+  const int n_coeffs = size_ * size_;
+  const scan_order *const so = &vp10_default_scan_orders[tx_size_];
+  const int count_test_block = 2000;
+
+  for (int i = 0; i < count_test_block; ++i) {
+    const int qindex = rnd(256);
+    const int rounding = rnd(128);
+    const int skip_block = i == 0;
+    uint16_t eob = 0, ref_eob = 0;
+
+    // Quantizers are set up the way vp10_init_quantizer() does for the fp
+    // path: the DC values first, then the AC ones. zbin and quant_shift are
+    // not used by it.
+    for (int j = 0; j < 8; ++j) {
+      dequant[j] = j ? vp10_ac_quant(qindex, 0, VPX_BITS_8)
+                     : vp10_dc_quant(qindex, 0, VPX_BITS_8);
+      quant[j] = (1 << 16) / dequant[j];
+      round[j] = (rounding * dequant[j]) >> 7;
+      zbin[j] = 0;
+      quant_shift[j] = 0;
+    }
+
+    // Residuals range from small to the 8-bit extremes.
+    const int mode = i % 3;
+    for (int j = 0; j < n_coeffs; ++j) {
+      if (mode == 0)
+        input[j] = rnd.Rand8() - rnd.Rand8();
+      else if (mode == 1)
+        input[j] = (rnd.Rand8() % 9) - 4;
+      else
+        input[j] = (rnd.Rand8() & 1) ? 255 : -255;
+    }
+
+    memset(coeff, 0, sizeof(coeff));
+    memset(ref_coeff, 0, sizeof(ref_coeff));
+    ref_fdct_quant_(input, size_, ref_coeff, n_coeffs, skip_block, zbin,
+                    round, quant, quant_shift, ref_qcoeff, ref_dqcoeff,
+                    dequant, &ref_eob, so->scan, so->iscan);
+    ASM_REGISTER_STATE_CHECK(fdct_quant_(
+        input, size_, coeff, n_coeffs, skip_block, zbin, round, quant,
+        quant_shift, qcoeff, dqcoeff, dequant, &eob, so->scan, so->iscan));
+
+    ASSERT_EQ(ref_eob, eob) << "block " << i;
+    for (int j = 0; j < n_coeffs; ++j) {
+      if (!skip_block) {
+        ASSERT_EQ(ref_coeff[j], coeff[j]) << "block " << i << " coeff " << j;
+      }
+      ASSERT_EQ(ref_qcoeff[j], qcoeff[j]) << "block " << i << " coeff " << j;
+      ASSERT_EQ(ref_dqcoeff[j], dqcoeff[j]) << "block " << i << " coeff "
+                                            << j;
+    }
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(SSE2, Vp10FdctQuantTest,
+                        ::testing::Values(make_tuple(
+                            &vp10_fdct32x32_rd_quant_sse2,
+                            &fdct32x32_rd_quant_ref, TX_32X32)));
+#endif  // HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+#endif  // !CONFIG_AOM_QM && !CONFIG_VPX_HIGHBITDEPTH
+}  // namespace
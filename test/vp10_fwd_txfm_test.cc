@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp10_rtcd.h"
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+typedef void (*FwdTxfm2dFunc)(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type);
+
+// <optimized, reference, size, tx_type>
+typedef std::tr1::tuple<FwdTxfm2dFunc, FwdTxfm2dFunc, int, int>
+    FwdTxfm2dParam;
+
+#if HAVE_SSE2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+void fdct32x32_c(const int16_t *in, tran_low_t *out, int stride,
+                 int /*tx_type*/) {
+  vp10_fdct32x32_c(in, out, stride);
+}
+
+void fdct32x32_rd_c(const int16_t *in, tran_low_t *out, int stride,
+                    int /*tx_type*/) {
+  vp10_fdct32x32_rd_c(in, out, stride);
+}
+
+void fdct32x32_sse2(const int16_t *in, tran_low_t *out, int stride,
+                    int /*tx_type*/) {
+  vp10_fdct32x32_sse2(in, out, stride);
+}
+
+void fdct32x32_rd_sse2(const int16_t *in, tran_low_t *out, int stride,
+                       int /*tx_type*/) {
+  vp10_fdct32x32_rd_sse2(in, out, stride);
+}
+#endif  // HAVE_SSE2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
+class Vp10FwdTxfm2dTest : public ::testing::TestWithParam<FwdTxfm2dParam> {
+ public:
+  virtual ~Vp10FwdTxfm2dTest() {}
+  virtual void SetUp() {
+    fwd_txfm_ = GET_PARAM(0);
+    ref_fwd_txfm_ = GET_PARAM(1);
+    size_ = GET_PARAM(2);
+    tx_type_ = GET_PARAM(3);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Fills the block with 8-bit residuals: random ones, small ones or the
+  // extremes.
+  void FillResidual(ACMRandom *rnd, int16_t *input, int mode) {
+    for (int j = 0; j < size_ * size_; ++j) {
+      if (mode == 0)
+        input[j] = rnd->Rand8() - rnd->Rand8();
+      else if (mode == 1)
+        input[j] = (rnd->Rand8() % 9) - 4;
+      else
+        input[j] = (rnd->Rand8() & 1) ? 255 : -255;
+    }
+  }
+
+  FwdTxfm2dFunc fwd_txfm_;
+  FwdTxfm2dFunc ref_fwd_txfm_;
+  int size_;
+  int tx_type_;
+};
+
+TEST_P(Vp10FwdTxfm2dTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(32, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, output[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, ref_output[32 * 32]);
+  const int count_test_block = 3000;
+  for (int i = 0; i < count_test_block; ++i) {
+    FillResidual(&rnd, input, i % 3);
+    ref_fwd_txfm_(input, ref_output, size_, tx_type_);
+    ASM_REGISTER_STATE_CHECK(fwd_txfm_(input, output, size_, tx_type_));
+    for (int j = 0; j < size_ * size_; ++j) {
+      ASSERT_EQ(ref_output[j], output[j]) << "block " << i << " coeff " << j;
+    }
+  }
+}
+
+TEST_P(Vp10FwdTxfm2dTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(32, int16_t, input[32 * 32]);
+  DECLARE_ALIGNED(32, tran_low_t, output[32 * 32]);
+  const int count_test_block = 20000000 / (size_ * size_);
+  vpx_usec_timer ref_timer, timer;
+  FillResidual(&rnd, input, 0);
+
+  vpx_usec_timer_start(&ref_timer);
+  for (int i = 0; i < count_test_block; ++i)
+    ref_fwd_txfm_(input, output, size_, tx_type_);
+  vpx_usec_timer_mark(&ref_timer);
+
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count_test_block; ++i)
+    fwd_txfm_(input, output, size_, tx_type_);
+  vpx_usec_timer_mark(&timer);
+
+  printf("fwd txfm %dx%d tx_type %d: reference %d us, optimized %d us\n",
+         size_, size_, tx_type_,
+         static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+         static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+}
+
+using std::tr1::make_tuple;
+
+// The AVX2 transform is also run against SSE2 so that DISABLED_Speed shows the
+// gain over the existing x86 code.
+#if HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+#if CONFIG_VPX_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE2, Vp10FwdTxfm2dTest,
+    ::testing::Values(make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16, 1),
+                      make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16, 2),
+                      make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16,
+                                 3)));
+#else
+INSTANTIATE_TEST_CASE_P(
+    SSE2, Vp10FwdTxfm2dTest,
+    ::testing::Values(make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16, 1),
+                      make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16, 2),
+                      make_tuple(&vp10_fht16x16_sse2, &vp10_fht16x16_c, 16, 3),
+                      make_tuple(&fdct32x32_sse2, &fdct32x32_c, 32, 0),
+                      make_tuple(&fdct32x32_rd_sse2, &fdct32x32_rd_c, 32, 0)));
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+#endif  // HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp10FwdTxfm2dTest,
+    ::testing::Values(make_tuple(&vp10_fht16x16_avx2, &vp10_fht16x16_c, 16, 1),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_fht16x16_c, 16, 2),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_fht16x16_c, 16, 3),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_fht16x16_sse2, 16,
+                                 1),
+                      make_tuple(&vp10_fht16x16_avx2, &vp10_fht16x16_sse2, 16,
+                                 3)));
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+}  // namespace
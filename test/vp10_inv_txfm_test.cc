@@ -9,12 +9,14 @@
  */
 
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vp10_rtcd.h"
+#include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
 #include "test/acm_random.h"
 #include "test/clear_system_state.h"
@@ -24,6 +26,8 @@
 #include "vp10/common/scan.h"
 #include "vpx/vpx_integer.h"
 #include "vp10/common/vp10_inv_txfm.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
 
 using libvpx_test::ACMRandom;
 
@@ -272,4 +276,213 @@ INSTANTIATE_TEST_CASE_P(
                                  &vp10_idct8x8_1_add_c, TX_8X8, 1),
                       make_tuple(&vpx_fdct4x4_c, &vp10_idct4x4_16_add_c,
                                  &vp10_idct4x4_1_add_c, TX_4X4, 1)));
+
+#if HAVE_AVX2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+typedef void (*IhtFunc)(const tran_low_t *input, uint8_t *dest, int stride,
+                        int tx_type);
+// <optimized, reference, size>
+typedef std::tr1::tuple<IhtFunc, IhtFunc, int> IhtParam;
+
+// The 8-bit SIMD transforms saturate where the C code wraps, so they are
+// compared against each other rather than against C.
+class Vp10IhtTest : public ::testing::TestWithParam<IhtParam> {
+ public:
+  virtual ~Vp10IhtTest() {}
+  virtual void SetUp() {
+    iht_ = GET_PARAM(0);
+    ref_iht_ = GET_PARAM(1);
+    size_ = GET_PARAM(2);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Fills the block with random, sparse or extreme coefficients.
+  void FillCoeffs(ACMRandom *rnd, tran_low_t *coeffs, int mode) {
+    const int max = (1 << 15) - 1;
+    for (int j = 0; j < size_ * size_; ++j) {
+      const int r = static_cast<int>(rnd->Rand31() % (2 * max + 1)) - max;
+      if (mode == 0)
+        coeffs[j] = r;
+      else if (mode == 1)
+        coeffs[j] = (rnd->Rand8() < 16) ? r : 0;
+      else
+        coeffs[j] = (rnd->Rand8() & 1) ? max : -max;
+    }
+  }
+
+  IhtFunc iht_;
+  IhtFunc ref_iht_;
+  int size_;
+};
+
+TEST_P(Vp10IhtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[16 * 16]);
+  DECLARE_ALIGNED(16, uint8_t, dst[16 * 16]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[16 * 16]);
+  const int count_test_block = 2000;
+  for (int tx_type = 0; tx_type < 4; ++tx_type) {
+    for (int i = 0; i < count_test_block; ++i) {
+      FillCoeffs(&rnd, coeffs, i % 3);
+      for (int j = 0; j < size_ * size_; ++j)
+        ref_dst[j] = dst[j] = rnd.Rand8();
+      ref_iht_(coeffs, ref_dst, size_, tx_type);
+      ASM_REGISTER_STATE_CHECK(iht_(coeffs, dst, size_, tx_type));
+      for (int j = 0; j < size_ * size_; ++j) {
+        ASSERT_EQ(ref_dst[j], dst[j]) << "tx_type " << tx_type << " block "
+                                      << i << " pixel " << j;
+      }
+    }
+  }
+}
+
+TEST_P(Vp10IhtTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(32, tran_low_t, coeffs[16 * 16]);
+  DECLARE_ALIGNED(16, uint8_t, dst[16 * 16]);
+  const int count_test_block = 20000000 / (size_ * size_);
+  FillCoeffs(&rnd, coeffs, 0);
+  for (int j = 0; j < size_ * size_; ++j) dst[j] = rnd.Rand8();
+
+  for (int tx_type = 0; tx_type < 4; ++tx_type) {
+    vpx_usec_timer ref_timer, timer;
+    vpx_usec_timer_start(&ref_timer);
+    for (int i = 0; i < count_test_block; ++i)
+      ref_iht_(coeffs, dst, size_, tx_type);
+    vpx_usec_timer_mark(&ref_timer);
+
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < count_test_block; ++i) iht_(coeffs, dst, size_, tx_type);
+    vpx_usec_timer_mark(&timer);
+
+    printf("iht %dx%d tx_type %d: reference %d us, optimized %d us\n", size_,
+           size_, tx_type, static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+           static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(AVX2, Vp10IhtTest,
+                        ::testing::Values(make_tuple(
+                            &vp10_iht16x16_256_add_avx2,
+                            &vp10_iht16x16_256_add_sse2, 16)));
+#endif  // HAVE_AVX2 && !CONFIG_VPX_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+
+#if CONFIG_VPX_HIGHBITDEPTH
+typedef void (*HighbdIhtFunc)(const tran_low_t *input, uint8_t *dest,
+                              int stride, int tx_type, int bd);
+// <optimized, reference, size, bit depth>
+typedef std::tr1::tuple<HighbdIhtFunc, HighbdIhtFunc, int, int> HighbdIhtParam;
+
+class Vp10HighbdIhtTest : public ::testing::TestWithParam<HighbdIhtParam> {
+ public:
+  virtual ~Vp10HighbdIhtTest() {}
+  virtual void SetUp() {
+    iht_ = GET_PARAM(0);
+    ref_iht_ = GET_PARAM(1);
+    size_ = GET_PARAM(2);
+    bd_ = GET_PARAM(3);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Fills the block with coefficients within the range of a valid stream of
+  // depth 'bd_': random ones, sparse ones or the extremes.
+  void FillCoeffs(ACMRandom *rnd, tran_low_t *coeffs, int mode) {
+    const int max = (1 << (7 + bd_)) - 1;
+    for (int j = 0; j < size_ * size_; ++j) {
+      const int r = static_cast<int>(rnd->Rand31() % (2 * max + 1)) - max;
+      if (mode == 0)
+        coeffs[j] = r;
+      else if (mode == 1)
+        coeffs[j] = (rnd->Rand8() < 16) ? r : 0;
+      else
+        coeffs[j] = (rnd->Rand8() & 1) ? max : -max;
+    }
+  }
+
+  HighbdIhtFunc iht_;
+  HighbdIhtFunc ref_iht_;
+  int size_;
+  int bd_;
+};
+
+TEST_P(Vp10HighbdIhtTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeffs[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, dst[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, ref_dst[16 * 16]);
+  const int count_test_block = 2000;
+  for (int tx_type = 0; tx_type < 4; ++tx_type) {
+    for (int i = 0; i < count_test_block; ++i) {
+      FillCoeffs(&rnd, coeffs, i % 3);
+      for (int j = 0; j < size_ * size_; ++j)
+        ref_dst[j] = dst[j] = rnd.Rand16() & ((1 << bd_) - 1);
+      ref_iht_(coeffs, CONVERT_TO_BYTEPTR(ref_dst), size_, tx_type, bd_);
+      ASM_REGISTER_STATE_CHECK(
+          iht_(coeffs, CONVERT_TO_BYTEPTR(dst), size_, tx_type, bd_));
+      for (int j = 0; j < size_ * size_; ++j) {
+        ASSERT_EQ(ref_dst[j], dst[j]) << "tx_type " << tx_type << " block "
+                                      << i << " pixel " << j;
+      }
+    }
+  }
+}
+
+TEST_P(Vp10HighbdIhtTest, DISABLED_Speed) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeffs[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, dst[16 * 16]);
+  const int count_test_block = 20000000 / (size_ * size_);
+  FillCoeffs(&rnd, coeffs, 0);
+  for (int j = 0; j < size_ * size_; ++j)
+    dst[j] = rnd.Rand16() & ((1 << bd_) - 1);
+
+  for (int tx_type = 0; tx_type < 4; ++tx_type) {
+    vpx_usec_timer ref_timer, timer;
+    vpx_usec_timer_start(&ref_timer);
+    for (int i = 0; i < count_test_block; ++i)
+      ref_iht_(coeffs, CONVERT_TO_BYTEPTR(dst), size_, tx_type, bd_);
+    vpx_usec_timer_mark(&ref_timer);
+
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < count_test_block; ++i)
+      iht_(coeffs, CONVERT_TO_BYTEPTR(dst), size_, tx_type, bd_);
+    vpx_usec_timer_mark(&timer);
+
+    printf("iht %dx%d tx_type %d: reference %d us, optimized %d us\n", size_,
+           size_, tx_type, static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+           static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+  }
+}
+
+#if HAVE_SSE4_1 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, Vp10HighbdIhtTest,
+    ::testing::Values(make_tuple(&vp10_highbd_iht4x4_16_add_sse4_1,
+                                 &vp10_highbd_iht4x4_16_add_c, 4, 10),
+                      make_tuple(&vp10_highbd_iht4x4_16_add_sse4_1,
+                                 &vp10_highbd_iht4x4_16_add_c, 4, 12),
+                      make_tuple(&vp10_highbd_iht8x8_64_add_sse4_1,
+                                 &vp10_highbd_iht8x8_64_add_c, 8, 10),
+                      make_tuple(&vp10_highbd_iht8x8_64_add_sse4_1,
+                                 &vp10_highbd_iht8x8_64_add_c, 8, 12),
+                      make_tuple(&vp10_highbd_iht16x16_256_add_sse4_1,
+                                 &vp10_highbd_iht16x16_256_add_c, 16, 10),
+                      make_tuple(&vp10_highbd_iht16x16_256_add_sse4_1,
+                                 &vp10_highbd_iht16x16_256_add_c, 16, 12)));
+#endif  // HAVE_SSE4_1 && !CONFIG_EMULATE_HARDWARE
+
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp10HighbdIhtTest,
+    ::testing::Values(make_tuple(&vp10_highbd_iht8x8_64_add_avx2,
+                                 &vp10_highbd_iht8x8_64_add_c, 8, 10),
+                      make_tuple(&vp10_highbd_iht8x8_64_add_avx2,
+                                 &vp10_highbd_iht8x8_64_add_c, 8, 12),
+                      make_tuple(&vp10_highbd_iht16x16_256_add_avx2,
+                                 &vp10_highbd_iht16x16_256_add_c, 16, 10),
+                      make_tuple(&vp10_highbd_iht16x16_256_add_avx2,
+                                 &vp10_highbd_iht16x16_256_add_c, 16, 12)));
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+#endif  // CONFIG_VPX_HIGHBITDEPTH
 }  // namespace
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp10_rtcd.h"
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+typedef void (*TemporalFilterFunc)(
+    const uint8_t *y_frame1, const uint8_t *u_frame1, const uint8_t *v_frame1,
+    unsigned int y_stride, unsigned int uv_stride, const uint8_t *pred,
+    unsigned int uv_block_width, unsigned int uv_block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count);
+
+// <optimized, reference, uv_block_width, uv_block_height>
+typedef std::tr1::tuple<TemporalFilterFunc, TemporalFilterFunc, int, int>
+    TemporalFilterParam;
+
+// The planes are given strides wider than the blocks so that the functions
+// have to step over the padding.
+const int kYStride = 24;
+const int kUVStride = 20;
+const int kMaxStrength = 6;
+const int kMaxWeight = 2;
+
+template <typename Pixel>
+class TemporalFilterTestBase
+    : public ::testing::TestWithParam<TemporalFilterParam> {
+ public:
+  virtual ~TemporalFilterTestBase() {}
+  virtual void SetUp() {
+    filter_ = GET_PARAM(0);
+    ref_filter_ = GET_PARAM(1);
+    uv_w_ = GET_PARAM(2);
+    uv_h_ = GET_PARAM(3);
+  }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Fills the planes and the predictor with random pixels, pixels that are
+  // close to the predictor, or the extremes.
+  void FillBlocks(ACMRandom *rnd, int mode, int bd) {
+    const int mask = (1 << bd) - 1;
+    for (int j = 0; j < 3 * 256; ++j) {
+      if (mode == 2)
+        pred_[j] = (rnd->Rand8() & 1) ? mask : 0;
+      else
+        pred_[j] = rnd->Rand16() & mask;
+    }
+    for (int r = 0; r < 16; ++r) {
+      for (int c = 0; c < kYStride; ++c)
+        y_[r * kYStride + c] = FillPixel(rnd, mode, mask, pred_[r * 16 + c]);
+      for (int c = 0; c < kUVStride; ++c) {
+        const int k = r * 16 + VPXMIN(c, 15);
+        u_[r * kUVStride + c] = FillPixel(rnd, mode, mask, pred_[256 + k]);
+        v_[r * kUVStride + c] = FillPixel(rnd, mode, mask, pred_[512 + k]);
+      }
+    }
+  }
+
+  Pixel FillPixel(ACMRandom *rnd, int mode, int mask, int pred) {
+    if (mode == 0) return rnd->Rand16() & mask;
+    if (mode == 1) return clamp(pred + (rnd->Rand8() % 17) - 8, 0, mask);
+    return (rnd->Rand8() & 1) ? mask : 0;
+  }
+
+  // Calls func on the blocks, passing the pixels the way the encoder does
+  // for the frame buffer format.
+  void Apply(TemporalFilterFunc func, int strength, int weight,
+             unsigned int *accumulator, uint16_t *count);
+
+  // Runs the filter against the reference for every strength and weight,
+  // accumulating over several frames the way the encoder does around the
+  // alt-ref. The strength is raised for high bit depths as the encoder does.
+  void RunMatchesReference(int bd) {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    unsigned int accumulator[3 * 256], ref_accumulator[3 * 256];
+    uint16_t count[3 * 256], ref_count[3 * 256];
+    const int count_test_block = 1000;
+    const int frames = 7;
+
+    for (int i = 0; i < count_test_block; ++i) {
+      const int strength = (i % (kMaxStrength + 1)) + 2 * (bd - 8);
+      const int weight = (i / (kMaxStrength + 1)) % (kMaxWeight + 1);
+
+      for (int j = 0; j < 3 * 256; ++j) {
+        ref_accumulator[j] = accumulator[j] = 0;
+        ref_count[j] = count[j] = 0;
+      }
+      for (int f = 0; f < frames; ++f) {
+        FillBlocks(&rnd, (i + f) % 3, bd);
+        Apply(ref_filter_, strength, weight, ref_accumulator, ref_count);
+        ASM_REGISTER_STATE_CHECK(
+            Apply(filter_, strength, weight, accumulator, count));
+      }
+      for (int j = 0; j < 3 * 256; ++j) {
+        ASSERT_EQ(ref_count[j], count[j]) << "block " << i << " strength "
+                                          << strength << " index " << j;
+        ASSERT_EQ(ref_accumulator[j], accumulator[j])
+            << "block " << i << " strength " << strength << " index " << j;
+      }
+    }
+  }
+
+  void RunSpeed(int bd) {
+    ACMRandom rnd(ACMRandom::DeterministicSeed());
+    unsigned int accumulator[3 * 256];
+    uint16_t count[3 * 256];
+    const int count_test_block = 2000000;
+    const int strength = kMaxStrength + 2 * (bd - 8);
+    vpx_usec_timer ref_timer, timer;
+    FillBlocks(&rnd, 1, bd);
+
+    vpx_usec_timer_start(&ref_timer);
+    for (int i = 0; i < count_test_block; ++i)
+      Apply(ref_filter_, strength, kMaxWeight, accumulator, count);
+    vpx_usec_timer_mark(&ref_timer);
+
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < count_test_block; ++i)
+      Apply(filter_, strength, kMaxWeight, accumulator, count);
+    vpx_usec_timer_mark(&timer);
+
+    printf("temporal filter %d-bit uv %dx%d: reference %d us, "
+           "optimized %d us\n",
+           bd, uv_w_, uv_h_,
+           static_cast<int>(vpx_usec_timer_elapsed(&ref_timer)),
+           static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+  }
+
+  TemporalFilterFunc filter_;
+  TemporalFilterFunc ref_filter_;
+  int uv_w_;
+  int uv_h_;
+  Pixel y_[16 * kYStride];
+  Pixel u_[16 * kUVStride];
+  Pixel v_[16 * kUVStride];
+  Pixel pred_[3 * 256];
+};
+
+template <>
+void TemporalFilterTestBase<uint8_t>::Apply(TemporalFilterFunc func,
+                                            int strength, int weight,
+                                            unsigned int *accumulator,
+                                            uint16_t *count) {
+  func(y_, u_, v_, kYStride, kUVStride, pred_, uv_w_, uv_h_, strength, weight,
+       accumulator, count);
+}
+
+class Vp10TemporalFilterTest : public TemporalFilterTestBase<uint8_t> {};
+
+TEST_P(Vp10TemporalFilterTest, MatchesReference) { RunMatchesReference(8); }
+
+TEST_P(Vp10TemporalFilterTest, DISABLED_Speed) { RunSpeed(8); }
+
+#if CONFIG_VPX_HIGHBITDEPTH
+template <>
+void TemporalFilterTestBase<uint16_t>::Apply(TemporalFilterFunc func,
+                                             int strength, int weight,
+                                             unsigned int *accumulator,
+                                             uint16_t *count) {
+  func(CONVERT_TO_BYTEPTR(y_), CONVERT_TO_BYTEPTR(u_), CONVERT_TO_BYTEPTR(v_),
+       kYStride, kUVStride, CONVERT_TO_BYTEPTR(pred_), uv_w_, uv_h_, strength,
+       weight, accumulator, count);
+}
+
+class Vp10HighbdTemporalFilterTest : public TemporalFilterTestBase<uint16_t> {
+};
+
+TEST_P(Vp10HighbdTemporalFilterTest, MatchesReference) {
+  RunMatchesReference(8);
+  RunMatchesReference(10);
+  RunMatchesReference(12);
+}
+
+TEST_P(Vp10HighbdTemporalFilterTest, DISABLED_Speed) { RunSpeed(10); }
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    SSE2, Vp10TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp10_temporal_filter_apply_sse2,
+                                 &vp10_temporal_filter_apply_c, 8, 8),
+                      make_tuple(&vp10_temporal_filter_apply_sse2,
+                                 &vp10_temporal_filter_apply_c, 16, 16),
+                      make_tuple(&vp10_temporal_filter_apply_sse2,
+                                 &vp10_temporal_filter_apply_c, 8, 16),
+                      make_tuple(&vp10_temporal_filter_apply_sse2,
+                                 &vp10_temporal_filter_apply_c, 16, 8)));
+#endif  // HAVE_SSE2 && !CONFIG_EMULATE_HARDWARE
+
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp10TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp10_temporal_filter_apply_avx2,
+                                 &vp10_temporal_filter_apply_c, 8, 8),
+                      make_tuple(&vp10_temporal_filter_apply_avx2,
+                                 &vp10_temporal_filter_apply_c, 16, 16),
+                      make_tuple(&vp10_temporal_filter_apply_avx2,
+                                 &vp10_temporal_filter_apply_c, 8, 16),
+                      make_tuple(&vp10_temporal_filter_apply_avx2,
+                                 &vp10_temporal_filter_apply_c, 16, 8)));
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+
+#if CONFIG_VPX_HIGHBITDEPTH
+#if HAVE_SSE4_1 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, Vp10HighbdTemporalFilterTest,
+    ::testing::Values(make_tuple(&vp10_highbd_temporal_filter_apply_sse4_1,
+                                 &vp10_highbd_temporal_filter_apply_c, 8, 8),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_sse4_1,
+                                 &vp10_highbd_temporal_filter_apply_c, 16, 16),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_sse4_1,
+                                 &vp10_highbd_temporal_filter_apply_c, 8, 16),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_sse4_1,
+                                 &vp10_highbd_temporal_filter_apply_c, 16,
+                                 8)));
+#endif  // HAVE_SSE4_1 && !CONFIG_EMULATE_HARDWARE
+
+#if HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp10HighbdTemporalFilterTest,
+    ::testing::Values(make_tuple(&vp10_highbd_temporal_filter_apply_avx2,
+                                 &vp10_highbd_temporal_filter_apply_c, 8, 8),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_avx2,
+                                 &vp10_highbd_temporal_filter_apply_c, 16, 16),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_avx2,
+                                 &vp10_highbd_temporal_filter_apply_c, 8, 16),
+                      make_tuple(&vp10_highbd_temporal_filter_apply_avx2,
+                                 &vp10_highbd_temporal_filter_apply_c, 16,
+                                 8)));
+#endif  // HAVE_AVX2 && !CONFIG_EMULATE_HARDWARE
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+}  // namespace
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_util/vpx_thread_pool.h"
+
+namespace {
+
+const int kNumItems = 200;
+
+struct ItemData {
+  VPxJobGroup *group;
+  int done[kNumItems];
+};
+
+// Marks the item given by data2, failing for negative items.
+int MarkItem(void *data1, void *data2) {
+  ItemData *const data = static_cast<ItemData *>(data1);
+  const int item = static_cast<int>(reinterpret_cast<intptr_t>(data2));
+  if (item < 0) return 0;
+  ++data->done[item];
+  return 1;
+}
+
+// Marks the items handed out by the group until there are none left.
+int MarkNextItems(void *data1, void *data2) {
+  ItemData *const data = static_cast<ItemData *>(data1);
+  int item;
+  (void)data2;
+  while ((item = vpx_job_group_next_index(data->group)) < kNumItems)
+    ++data->done[item];
+  return 1;
+}
+
+class VPxThreadPoolTest : public ::testing::TestWithParam<int> {
+ protected:
+  virtual void SetUp() {
+    pool_ = vpx_thread_pool_create(GetParam());
+    ASSERT_TRUE(pool_ != NULL);
+    memset(&data_, 0, sizeof(data_));
+    data_.group = &group_;
+  }
+  virtual void TearDown() { vpx_thread_pool_release(pool_); }
+
+  VPxThreadPool *pool_;
+  VPxJobGroup group_;
+  ItemData data_;
+};
+
+TEST_P(VPxThreadPoolTest, RunsEveryJob) {
+  // More jobs than a group holds before it grows its queue.
+  ASSERT_GT(kNumItems, VPX_JOB_GROUP_SIZE);
+  vpx_job_group_init(&group_, pool_);
+  for (int i = 0; i < kNumItems; ++i) {
+    EXPECT_TRUE(vpx_job_group_submit(
+        &group_, MarkItem, &data_,
+        reinterpret_cast<void *>(static_cast<intptr_t>(i))));
+  }
+  EXPECT_TRUE(vpx_job_group_wait(&group_));
+  for (int i = 0; i < kNumItems; ++i) EXPECT_EQ(1, data_.done[i]) << i;
+  // Waiting again does nothing.
+  EXPECT_TRUE(vpx_job_group_wait(&group_));
+}
+
+TEST_P(VPxThreadPoolTest, ReportsErrors) {
+  vpx_job_group_init(&group_, pool_);
+  vpx_job_group_submit(&group_, MarkItem, &data_, reinterpret_cast<void *>(1));
+  vpx_job_group_submit(&group_, MarkItem, &data_,
+                       reinterpret_cast<void *>(static_cast<intptr_t>(-1)));
+  EXPECT_FALSE(vpx_job_group_wait(&group_));
+  EXPECT_EQ(1, data_.done[1]);
+
+  // The error does not carry over once the group is initialized again.
+  vpx_job_group_init(&group_, pool_);
+  vpx_job_group_submit(&group_, MarkItem, &data_, reinterpret_cast<void *>(1));
+  EXPECT_TRUE(vpx_job_group_wait(&group_));
+  EXPECT_EQ(2, data_.done[1]);
+}
+
+TEST_P(VPxThreadPoolTest, HandsOutEveryIndexOnce) {
+  vpx_job_group_init(&group_, pool_);
+  for (int i = 0; i < 8; ++i)
+    vpx_job_group_submit(&group_, MarkNextItems, &data_, NULL);
+  EXPECT_TRUE(vpx_job_group_wait(&group_));
+  for (int i = 0; i < kNumItems; ++i) EXPECT_EQ(1, data_.done[i]) << i;
+}
+
+TEST_P(VPxThreadPoolTest, SharesThreadsBetweenGroups) {
+  VPxJobGroup other;
+  ItemData other_data;
+  memset(&other_data, 0, sizeof(other_data));
+  other_data.group = &other;
+  vpx_job_group_init(&group_, pool_);
+  vpx_job_group_init(&other, pool_);
+  for (int i = 0; i < 4; ++i) {
+    vpx_job_group_submit(&group_, MarkNextItems, &data_, NULL);
+    vpx_job_group_submit(&other, MarkNextItems, &other_data, NULL);
+  }
+  EXPECT_TRUE(vpx_job_group_wait(&other));
+  EXPECT_TRUE(vpx_job_group_wait(&group_));
+  for (int i = 0; i < kNumItems; ++i) {
+    EXPECT_EQ(1, data_.done[i]) << i;
+    EXPECT_EQ(1, other_data.done[i]) << i;
+  }
+}
+
+TEST_P(VPxThreadPoolTest, RunsPinnedThreads) {
+  const vpx_codec_thread_affinity_t kAffinities[] = {
+    VPX_THREAD_AFFINITY_CPU, VPX_THREAD_AFFINITY_NODE, VPX_THREAD_AFFINITY_NONE
+  };
+  for (int i = 0; i < 3; ++i) {
+    const vpx_codec_err_t res =
+        vpx_thread_pool_set_affinity(pool_, kAffinities[i]);
+#if CONFIG_MULTITHREAD && defined(__linux__)
+    ASSERT_EQ(VPX_CODEC_OK, res);
+#else
+    if (kAffinities[i] != VPX_THREAD_AFFINITY_NONE)
+      ASSERT_EQ(VPX_CODEC_INCAPABLE, res);
+#endif
+    // Threads started after the pool was pinned are pinned too.
+    vpx_thread_pool_reserve(pool_, GetParam() + 1);
+    memset(data_.done, 0, sizeof(data_.done));
+    vpx_job_group_init(&group_, pool_);
+    for (int j = 0; j < 8; ++j)
+      vpx_job_group_submit(&group_, MarkNextItems, &data_, NULL);
+    EXPECT_TRUE(vpx_job_group_wait(&group_));
+    for (int j = 0; j < kNumItems; ++j) EXPECT_EQ(1, data_.done[j]) << j;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Threads, VPxThreadPoolTest,
+                        ::testing::Values(0, 1, 2, 4));
+
+TEST(VPxThreadPoolSharedTest, GrowsAndKeepsThePool) {
+  VPxThreadPool *const pool = vpx_thread_pool_get_shared(1);
+  ASSERT_TRUE(pool != NULL);
+  VPxThreadPool *const again = vpx_thread_pool_get_shared(3);
+  EXPECT_EQ(pool, again);
+#if CONFIG_MULTITHREAD
+  EXPECT_GE(vpx_thread_pool_num_threads(pool), 3);
+#else
+  EXPECT_EQ(0, vpx_thread_pool_num_threads(pool));
+#endif
+  vpx_thread_pool_release(again);
+  vpx_thread_pool_release(pool);
+}
+
+}  // namespace
@@ -3,10 +3,12 @@ Copyright (c) 2016 Cisco Systems
 (Replace with proper AOM header)
 */
 
+#include "./vp10_rtcd.h"
 #include "vp10/common/clpf.h"
+#include "vpx_ports/mem.h"
 
 // Apply the filter on a single block
-static void clpf_block(const uint8_t *src, uint8_t *dst, int sstride,
+void vp10_clpf_block_c(const uint8_t *src, uint8_t *dst, int sstride,
                        int dstride, int has_top, int has_left, int has_bottom,
                        int has_right, int width, int height) {
   int x, y;
@@ -28,15 +30,21 @@ static void clpf_block(const uint8_t *src, uint8_t *dst, int sstride,
 #define BS MI_SIZE *MI_BLOCK_SIZE
 
 // Iterate over blocks within a superblock
-static void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
-                         const VP10_COMMON *cm, MACROBLOCKD *xd,
-                         MODE_INFO *const *mi_8x8, int xpos, int ypos) {
+void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
+                  const VP10_COMMON *cm,
+                  struct macroblockd_plane planes[MAX_MB_PLANE],
+                  MODE_INFO *const *mi_8x8, int xpos, int ypos) {
   // Temporary buffer (to allow SIMD parallelism)
-  uint8_t buf_unaligned[BS * BS + 15];
-  uint8_t *buf = (uint8_t *)(((intptr_t)buf_unaligned + 15) & ~15);
+  DECLARE_ALIGNED(16, uint8_t, buf[BS * BS]);
   int x, y, p;
 
+  // The blocks are addressed from the top-left of the superblock.
+  vp10_setup_dst_planes(planes, frame_buffer, ypos, xpos);
+
   for (p = 0; p < (CLPF_FILTER_ALL_PLANES ? MAX_MB_PLANE : 1); p++) {
+    const int stride = planes[p].dst.stride;
+    const int bw = MI_SIZE >> planes[p].subsampling_x;
+    const int bh = MI_SIZE >> planes[p].subsampling_y;
     for (y = 0; y < MI_BLOCK_SIZE && ypos + y < cm->mi_rows; y++) {
       for (x = 0; x < MI_BLOCK_SIZE && xpos + x < cm->mi_cols; x++) {
         const MB_MODE_INFO *mbmi =
@@ -44,6 +52,7 @@ static void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
 
         // Do not filter if there is no residual
         if (!mbmi->skip) {
+          uint8_t *const src = planes[p].dst.buf + y * bh * stride + x * bw;
           // Do not filter frame edges
           int has_top = ypos + y > 0;
           int has_left = xpos + x > 0;
@@ -56,16 +65,12 @@ static void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
           has_bottom &= y != MI_BLOCK_SIZE - 1;
           has_right &= x != MI_BLOCK_SIZE - 1;
 #endif
-          vp10_setup_dst_planes(xd->plane, frame_buffer, ypos + y, xpos + x);
-          clpf_block(
-              xd->plane[p].dst.buf, CLPF_ALLOW_PIXEL_PARALLELISM
-                                        ? buf + y * MI_SIZE * BS + x * MI_SIZE
-                                        : xd->plane[p].dst.buf,
-              xd->plane[p].dst.stride,
-              CLPF_ALLOW_PIXEL_PARALLELISM ? BS : xd->plane[p].dst.stride,
-              has_top, has_left, has_bottom, has_right,
-              MI_SIZE >> xd->plane[p].subsampling_x,
-              MI_SIZE >> xd->plane[p].subsampling_y);
+          vp10_clpf_block(
+              src, CLPF_ALLOW_PIXEL_PARALLELISM
+                       ? buf + y * MI_SIZE * BS + x * MI_SIZE
+                       : src,
+              stride, CLPF_ALLOW_PIXEL_PARALLELISM ? BS : stride, has_top,
+              has_left, has_bottom, has_right, bw, bh);
         }
       }
     }
@@ -74,13 +79,12 @@ static void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
       for (x = 0; x < MI_BLOCK_SIZE && xpos + x < cm->mi_cols; x++) {
         const MB_MODE_INFO *mbmi =
             &mi_8x8[(ypos + y) * cm->mi_stride + xpos + x]->mbmi;
-        vp10_setup_dst_planes(xd->plane, frame_buffer, ypos + y, xpos + x);
         if (!mbmi->skip) {
+          uint8_t *const dst = planes[p].dst.buf + y * bh * stride + x * bw;
           int i = 0;
-          for (i = 0; i<MI_SIZE>> xd->plane[p].subsampling_y; i++)
-            memcpy(xd->plane[p].dst.buf + i * xd->plane[p].dst.stride,
-                   buf + (y * MI_SIZE + i) * BS + x * MI_SIZE,
-                   MI_SIZE >> xd->plane[p].subsampling_x);
+          for (i = 0; i < bh; i++)
+            memcpy(dst + i * stride,
+                   buf + (y * MI_SIZE + i) * BS + x * MI_SIZE, bw);
         }
       }
     }
@@ -88,12 +92,21 @@ static void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
   }
 }
 
+// Iterate over the superblocks of a superblock row
+void vp10_clpf_sb_row(const YV12_BUFFER_CONFIG *frame, const VP10_COMMON *cm,
+                      struct macroblockd_plane planes[MAX_MB_PLANE],
+                      int mi_row) {
+  int x;
+
+  for (x = 0; x < cm->mi_cols; x += MI_BLOCK_SIZE)
+    vp10_clpf_sb(frame, cm, planes, cm->mi_grid_visible, x, mi_row);
+}
+
 // Iterate over the superblocks of an entire frame
 void vp10_clpf_frame(const YV12_BUFFER_CONFIG *frame, const VP10_COMMON *cm,
                      MACROBLOCKD *xd) {
-  int x, y;
+  int y;
 
   for (y = 0; y < cm->mi_rows; y += MI_BLOCK_SIZE)
-    for (x = 0; x < cm->mi_cols; x += MI_BLOCK_SIZE)
-      vp10_clpf_sb(frame, cm, xd, cm->mi_grid_visible, x, y);
+    vp10_clpf_sb_row(frame, cm, xd->plane, y);
 }
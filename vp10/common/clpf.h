@@ -16,6 +16,19 @@ Copyright (c) 2016, Cisco Systems
 #define CLPF_FILTER_ALL_PLANES \
   0  // 1 = filter both luma and chroma, 0 = filter only luma
 
+// Filter the superblock at mi position ('ypos', 'xpos'). planes[] is
+// repointed at the superblock.
+void vp10_clpf_sb(const YV12_BUFFER_CONFIG *frame_buffer,
+                  const VP10_COMMON *cm,
+                  struct macroblockd_plane planes[MAX_MB_PLANE],
+                  MODE_INFO *const *mi_8x8, int xpos, int ypos);
+
+// Filter the superblock row starting at 'mi_row'. The rows above must
+// already be filtered and the row below must not.
+void vp10_clpf_sb_row(const YV12_BUFFER_CONFIG *frame, const VP10_COMMON *cm,
+                      struct macroblockd_plane planes[MAX_MB_PLANE],
+                      int mi_row);
+
 void vp10_clpf_frame(const YV12_BUFFER_CONFIG *frame, const VP10_COMMON *cm,
                      MACROBLOCKD *xd);
 
@@ -11,14 +11,15 @@
 #include <string.h>
 #include <math.h>
 
+#include "./vp10_rtcd.h"
 #include "./vpx_scale_rtcd.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
 #include "vp10/common/dering.h"
 #include "vp10/common/onyxc_int.h"
 #include "vp10/common/reconinter.h"
 #include "vp10/common/od_dering.h"
 
-
 int compute_level_from_index(int global_level, int gi) {
   static const int dering_gains[DERING_REFINEMENT_LEVELS] = {0, 11, 16, 22};
   int level;
@@ -45,109 +46,442 @@ int sb_all_skip(const VP10_COMMON *const cm, int mi_row, int mi_col) {
   return skip;
 }
 
-void vp10_dering_frame(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
-                       MACROBLOCKD *xd, int global_level) {
+void vp10_dering_init_vtbl(od_dering_opt_vtbl *vtbl) {
+  vtbl->filter_dering_direction[0] = od_filter_dering_direction_4x4;
+  vtbl->filter_dering_direction[1] = od_filter_dering_direction_8x8;
+  vtbl->filter_dering_orthogonal[0] = od_filter_dering_orthogonal_4x4;
+  vtbl->filter_dering_orthogonal[1] = od_filter_dering_orthogonal_8x8;
+}
+
+// Copy OD_FILT_BORDER unfiltered lines of a plane, starting at row 'y0', into
+// a line buffer.
+static void save_lines(od_dering_in *lines, int line_stride,
+                       const VP10_COMMON *cm,
+                       const struct macroblockd_plane *plane, int y0) {
+  const int width = (8 >> plane->subsampling_x)*cm->mi_cols;
+  int r, c;
+  for (r = 0; r < OD_FILT_BORDER; ++r) {
+#if CONFIG_VPX_HIGHBITDEPTH
+    if (cm->use_highbitdepth) {
+      const uint16_t *src = CONVERT_TO_SHORTPTR(plane->dst.buf) +
+          (y0 + r)*plane->dst.stride;
+      memcpy(&lines[r*line_stride], src, width*sizeof(*lines));
+      continue;
+    }
+#endif
+    {
+      const uint8_t *src = plane->dst.buf + (y0 + r)*plane->dst.stride;
+      for (c = 0; c < width; ++c) lines[r*line_stride + c] = src[c];
+    }
+  }
+}
+
+// Filter superblock row 'sbr' in place. The unfiltered pixels of each
+// superblock are gathered in a window with an OD_FILT_BORDER border: the
+// lines above and below come from 'above' and 'below', which hold the
+// unfiltered bottom lines of row sbr - 1 and top lines of row sbr + 1, and
+// the left columns are carried over from the window of the previous
+// superblock. Only the current row is read from the frame.
+static void dering_sb_row(const VP10_COMMON *cm,
+                          const struct macroblockd_plane planes[MAX_MB_PLANE],
+                          od_dering_in *const above[MAX_MB_PLANE],
+                          od_dering_in *const below[MAX_MB_PLANE],
+                          int line_stride, int global_level, int sbr) {
   int r, c;
-  int sbr, sbc;
+  int sbc;
   int nhsb, nvsb;
-  od_dering_in *src[3];
-  unsigned char *bskip;
   int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS] = {{0}};
-  int stride;
   int bsize[3];
+  od_dering_opt_vtbl vtbl;
   int dec[3];
   int pli;
   int coeff_shift = VPXMAX(cm->bit_depth - 8, 0);
+  od_dering_in window[3][OD_FILT_BSTRIDE*OD_FILT_BSTRIDE];
   nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
   nhsb = (cm->mi_cols + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
-  bskip = vpx_malloc(sizeof(*bskip)*cm->mi_rows*cm->mi_cols);
-  vp10_setup_dst_planes(xd->plane, frame, 0, 0);
   for (pli = 0; pli < 3; pli++) {
-    dec[pli] = xd->plane[pli].subsampling_x;
+    dec[pli] = planes[pli].subsampling_x;
     bsize[pli] = 8 >> dec[pli];
   }
-  stride = bsize[0]*cm->mi_cols;
-  for (pli = 0; pli < 3; pli++) {
-    src[pli] = vpx_malloc(sizeof(*src)*cm->mi_rows*cm->mi_cols*64);
-    for (r = 0; r < bsize[pli]*cm->mi_rows; ++r) {
-      for (c = 0; c < bsize[pli]*cm->mi_cols; ++c) {
+  vp10_dering_init_vtbl(&vtbl);
+  for (sbc = 0; sbc < nhsb; sbc++) {
+    int level;
+    int nhb, nvb;
+    int all_skip = 1;
+    unsigned char bskip[MI_BLOCK_SIZE*MI_BLOCK_SIZE];
+    const int left = sbc != 0 ? OD_FILT_BORDER : 0;
+    const int right = sbc != nhsb - 1 ? OD_FILT_BORDER : 0;
+    nhb = VPXMIN(MI_BLOCK_SIZE, cm->mi_cols - MI_BLOCK_SIZE*sbc);
+    nvb = VPXMIN(MI_BLOCK_SIZE, cm->mi_rows - MI_BLOCK_SIZE*sbr);
+    for (r = 0; r < nvb; ++r) {
+      for (c = 0; c < nhb; ++c) {
+        bskip[r*MI_BLOCK_SIZE + c] =
+            cm->mi_grid_visible[(MI_BLOCK_SIZE*sbr + r)*cm->mi_stride +
+            MI_BLOCK_SIZE*sbc + c]->mbmi.skip;
+        all_skip = all_skip && bskip[r*MI_BLOCK_SIZE + c];
+      }
+    }
+    for (pli = 0; pli < 3; pli++) {
+      int16_t dst[MI_BLOCK_SIZE*MI_BLOCK_SIZE*8*8];
+      od_dering_in *const x =
+          window[pli] + OD_FILT_BORDER*OD_FILT_BSTRIDE + OD_FILT_BORDER;
+      const int w = bsize[pli]*nhb;
+      const int h = bsize[pli]*nvb;
+      const int x0 = sbc*bsize[pli]*MI_BLOCK_SIZE;
+      const int y0 = sbr*bsize[pli]*MI_BLOCK_SIZE;
+      int threshold;
+#if DERING_REFINEMENT
+      level = compute_level_from_index(
+          global_level,
+          cm->mi_grid_visible[MI_BLOCK_SIZE*sbr*cm->mi_stride +
+          MI_BLOCK_SIZE*sbc]->mbmi.dering_gain);
+#else
+      level = global_level;
+#endif
+      /* FIXME: This is a temporary hack that uses more conservative
+         deringing for chroma. */
+      if (pli) level = (level*5 + 4) >> 3;
+      if (all_skip) level = 0;
+      threshold = level << coeff_shift;
+
+      // The previous superblock is always full width, so its last columns
+      // become the left border of this one.
+      for (r = 0; r < h && left; ++r) {
+        memcpy(&x[r*OD_FILT_BSTRIDE - OD_FILT_BORDER],
+               &x[r*OD_FILT_BSTRIDE + bsize[pli]*MI_BLOCK_SIZE -
+               OD_FILT_BORDER], OD_FILT_BORDER*sizeof(*x));
+      }
+      for (r = 0; r < OD_FILT_BORDER; ++r) {
+        if (sbr != 0) {
+          memcpy(&x[(r - OD_FILT_BORDER)*OD_FILT_BSTRIDE - left],
+                 &above[pli][r*line_stride + x0 - left],
+                 (left + w + right)*sizeof(*x));
+        }
+        if (sbr != nvsb - 1) {
+          memcpy(&x[(h + r)*OD_FILT_BSTRIDE - left],
+                 &below[pli][r*line_stride + x0 - left],
+                 (left + w + right)*sizeof(*x));
+        }
+      }
+      for (r = 0; r < h; ++r) {
 #if CONFIG_VPX_HIGHBITDEPTH
         if (cm->use_highbitdepth) {
-          src[pli][r * stride + c] =
-              CONVERT_TO_SHORTPTR(xd->plane[pli].dst.buf)
-              [r * xd->plane[pli].dst.stride + c];
-        } else {
+          memcpy(&x[r*OD_FILT_BSTRIDE],
+                 CONVERT_TO_SHORTPTR(planes[pli].dst.buf) +
+                 (y0 + r)*planes[pli].dst.stride + x0,
+                 (w + right)*sizeof(*x));
+          continue;
+        }
 #endif
-          src[pli][r * stride + c] =
-              xd->plane[pli].dst.buf[r * xd->plane[pli].dst.stride + c];
+        {
+          const uint8_t *src =
+              planes[pli].dst.buf + (y0 + r)*planes[pli].dst.stride + x0;
+          for (c = 0; c < w + right; ++c) x[r*OD_FILT_BSTRIDE + c] = src[c];
+        }
+      }
+
+      od_dering(
+          &vtbl,
+          dst,
+          MI_BLOCK_SIZE*bsize[pli],
+          x, OD_FILT_BSTRIDE, nhb, nvb, sbc, sbr, nhsb, nvsb, dec[pli], dir,
+          pli, bskip, MI_BLOCK_SIZE, threshold, OD_DERING_NO_CHECK_OVERLAP,
+          coeff_shift);
+      for (r = 0; r < h; ++r) {
 #if CONFIG_VPX_HIGHBITDEPTH
+        if (cm->use_highbitdepth) {
+          memcpy(CONVERT_TO_SHORTPTR(planes[pli].dst.buf) +
+                 (y0 + r)*planes[pli].dst.stride + x0,
+                 &dst[r*MI_BLOCK_SIZE*bsize[pli]], w*sizeof(*dst));
+          continue;
         }
 #endif
+        {
+          uint8_t *dstp =
+              planes[pli].dst.buf + (y0 + r)*planes[pli].dst.stride + x0;
+          for (c = 0; c < w; ++c) {
+            dstp[c] = dst[r*MI_BLOCK_SIZE*bsize[pli] + c];
+          }
+        }
       }
     }
   }
-  for (r = 0; r < cm->mi_rows; ++r) {
-    for (c = 0; c < cm->mi_cols; ++c) {
-      const MB_MODE_INFO *mbmi =
-          &cm->mi_grid_visible[r * cm->mi_stride + c]->mbmi;
-      bskip[r * cm->mi_cols + c] = mbmi->skip;
-    }
+}
+
+void vp10_dering_frame(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                       MACROBLOCKD *xd, int global_level) {
+  const int line_stride = 8*cm->mi_cols;
+  int sbr;
+  int nvsb;
+  od_dering_in *lines;
+  od_dering_in *above[MAX_MB_PLANE];
+  od_dering_in *below[MAX_MB_PLANE];
+  od_dering_in *next[MAX_MB_PLANE];
+  int pli;
+  nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
+  vp10_setup_dst_planes(xd->plane, frame, 0, 0);
+  // Three sets of line buffers per plane: the unfiltered bottom lines of the
+  // previous row, the top lines of the next row, and the bottom lines of the
+  // current row, saved before it is filtered.
+  CHECK_MEM_ERROR(cm, lines,
+                  vpx_malloc(sizeof(*lines)*MAX_MB_PLANE*3*OD_FILT_BORDER*
+                             line_stride));
+  for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+    above[pli] = lines + (3*pli + 0)*OD_FILT_BORDER*line_stride;
+    below[pli] = lines + (3*pli + 1)*OD_FILT_BORDER*line_stride;
+    next[pli] = lines + (3*pli + 2)*OD_FILT_BORDER*line_stride;
   }
   for (sbr = 0; sbr < nvsb; sbr++) {
-    for (sbc = 0; sbc < nhsb; sbc++) {
-      int level;
-      int nhb, nvb;
-      nhb = VPXMIN(MI_BLOCK_SIZE, cm->mi_cols - MI_BLOCK_SIZE*sbc);
-      nvb = VPXMIN(MI_BLOCK_SIZE, cm->mi_rows - MI_BLOCK_SIZE*sbr);
-      for (pli = 0; pli < 3; pli++) {
-        int16_t dst[MI_BLOCK_SIZE*MI_BLOCK_SIZE*8*8];
-        int threshold;
-#if DERING_REFINEMENT
-        level = compute_level_from_index(
-            global_level,
-            cm->mi_grid_visible[MI_BLOCK_SIZE*sbr*cm->mi_stride +
-            MI_BLOCK_SIZE*sbc]->mbmi.dering_gain);
+    if (sbr != nvsb - 1) {
+      for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+        const int sb_lines = (8 >> xd->plane[pli].subsampling_x)*
+            MI_BLOCK_SIZE;
+        save_lines(below[pli], line_stride, cm, &xd->plane[pli],
+                   (sbr + 1)*sb_lines);
+        save_lines(next[pli], line_stride, cm, &xd->plane[pli],
+                   (sbr + 1)*sb_lines - OD_FILT_BORDER);
+      }
+    }
+    dering_sb_row(cm, xd->plane, above, below, line_stride, global_level,
+                  sbr);
+    for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+      od_dering_in *const tmp = above[pli];
+      above[pli] = next[pli];
+      next[pli] = tmp;
+    }
+  }
+  vpx_free(lines);
+}
+
+// Save the unfiltered lines on both sides of the boundary between superblock
+// rows sbr - 1 and sbr. planes[] must point at the top-left of the frame.
+void vp10_dering_save_boundary(VP10DeringSync *dering_sync,
+                               const VP10_COMMON *cm,
+                               const struct macroblockd_plane
+                               planes[MAX_MB_PLANE], int sbr) {
+  const int line_stride = dering_sync->line_stride;
+  int pli;
+  for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+    const int y0 = sbr*(8 >> planes[pli].subsampling_x)*MI_BLOCK_SIZE;
+    od_dering_in *const lines = dering_sync->lines[pli];
+    save_lines(lines + (2*sbr - 1)*OD_FILT_BORDER*line_stride, line_stride,
+               cm, &planes[pli], y0 - OD_FILT_BORDER);
+    save_lines(lines + 2*sbr*OD_FILT_BORDER*line_stride, line_stride,
+               cm, &planes[pli], y0);
+  }
+}
+
+void vp10_dering_sb_row(VP10DeringSync *dering_sync, const VP10_COMMON *cm,
+                        const struct macroblockd_plane planes[MAX_MB_PLANE],
+                        int global_level, int sbr) {
+  const int line_stride = dering_sync->line_stride;
+  od_dering_in *above[MAX_MB_PLANE];
+  od_dering_in *below[MAX_MB_PLANE];
+  int pli;
+  for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+    // Bottom lines of the row above and top lines of the row below.
+    above[pli] = sbr > 0 ? dering_sync->lines[pli] +
+        (2*sbr - 1)*OD_FILT_BORDER*line_stride : NULL;
+    below[pli] = sbr < dering_sync->rows - 1 ? dering_sync->lines[pli] +
+        (2*sbr + 2)*OD_FILT_BORDER*line_stride : NULL;
+  }
+  dering_sb_row(cm, planes, above, below, line_stride, global_level, sbr);
+}
+
+// Mark the boundary above superblock row 'r' as saved. The jobs filtering
+// the rows on both sides of it may be waiting, so two are woken.
+static INLINE void sync_write(VP10DeringSync *const dering_sync, int r) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&dering_sync->mutex_[r]);
+  dering_sync->row_ready[r] = 1;
+  pthread_cond_signal(&dering_sync->cond_[r]);
+  pthread_cond_signal(&dering_sync->cond_[r]);
+  pthread_mutex_unlock(&dering_sync->mutex_[r]);
 #else
-        level = global_level;
-#endif
-        /* FIXME: This is a temporary hack that uses more conservative
-           deringing for chroma. */
-        if (pli) level = (level*5 + 4) >> 3;
-        if (sb_all_skip(cm, sbr*MI_BLOCK_SIZE, sbc*MI_BLOCK_SIZE)) level = 0;
-        threshold = level << coeff_shift;
-        od_dering(
-            &OD_DERING_VTBL_C,
-            dst,
-            MI_BLOCK_SIZE*bsize[pli],
-            &src[pli][sbr*stride*bsize[pli]*MI_BLOCK_SIZE +
-            sbc*bsize[pli]*MI_BLOCK_SIZE],
-            stride, nhb, nvb, sbc, sbr, nhsb, nvsb, dec[pli], dir, pli,
-            &bskip[MI_BLOCK_SIZE*sbr*cm->mi_cols + MI_BLOCK_SIZE*sbc],
-            cm->mi_cols, threshold, OD_DERING_NO_CHECK_OVERLAP, coeff_shift);
-        for (r = 0; r < bsize[pli]*nvb; ++r) {
-          for (c = 0; c < bsize[pli]*nhb; ++c) {
-#if CONFIG_VPX_HIGHBITDEPTH
-            if (cm->use_highbitdepth) {
-              CONVERT_TO_SHORTPTR(xd->plane[pli].dst.buf)
-                  [xd->plane[pli].dst.stride*(bsize[pli]*MI_BLOCK_SIZE*sbr + r)
-                  + sbc*bsize[pli]*MI_BLOCK_SIZE + c] =
-                  dst[r * MI_BLOCK_SIZE * bsize[pli] + c];
-            } else {
-#endif
-              xd->plane[pli].dst.buf[xd->plane[pli].dst.stride*
-                  (bsize[pli]*MI_BLOCK_SIZE*sbr + r) +
-                  sbc*bsize[pli]*MI_BLOCK_SIZE + c] =
-                  dst[r * MI_BLOCK_SIZE * bsize[pli] + c];
-#if CONFIG_VPX_HIGHBITDEPTH
-            }
-#endif
-          }
-        }
+  dering_sync->row_ready[r] = 1;
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Wait until the boundary above superblock row 'r' has been saved.
+static INLINE void sync_read(VP10DeringSync *const dering_sync, int r) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&dering_sync->mutex_[r]);
+  while (!dering_sync->row_ready[r]) {
+    pthread_cond_wait(&dering_sync->cond_[r], &dering_sync->mutex_[r]);
+  }
+  pthread_mutex_unlock(&dering_sync->mutex_[r]);
+#else
+  (void)dering_sync;
+  (void)r;
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Hands out the superblock rows to the jobs in order, counting in '*next'.
+static int get_next_row(VP10DeringSync *const dering_sync, int *next) {
+  int sbr = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&dering_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  if (*next < dering_sync->rows) sbr = (*next)++;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&dering_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  return sbr;
+}
+
+// Row-based multi-threaded deringing hook. The jobs first save the unfiltered
+// lines around the top boundary of every row, then filter the rows in place
+// once the boundaries above and below them have been saved. A job only moves
+// on to filtering once all the boundaries have been handed out, so it never
+// waits for a boundary that no running job has taken.
+static int dering_row_worker(VP10DeringSync *const dering_sync,
+                             DeringWorkerData *const dering_data) {
+  const VP10_COMMON *const cm = dering_data->cm;
+  int sbr;
+
+  while ((sbr = get_next_row(dering_sync, &dering_sync->next_save)) >= 0) {
+    if (sbr > 0) {
+      vp10_dering_save_boundary(dering_sync, cm, dering_data->planes, sbr);
+    }
+    sync_write(dering_sync, sbr);
+  }
+
+  while ((sbr = get_next_row(dering_sync, &dering_sync->next_filter)) >= 0) {
+    sync_read(dering_sync, sbr);
+    if (sbr < dering_sync->rows - 1) sync_read(dering_sync, sbr + 1);
+    vp10_dering_sb_row(dering_sync, cm, dering_data->planes,
+                       dering_data->global_level, sbr);
+  }
+  return 1;
+}
+
+// Allocate memory for deringing row synchronization.
+static void dering_alloc(VP10DeringSync *dering_sync, VP10_COMMON *cm,
+                         int rows, int num_workers) {
+  int pli;
+  dering_sync->rows = rows;
+#if CONFIG_MULTITHREAD
+  {
+    int i;
+
+    CHECK_MEM_ERROR(cm, dering_sync->mutex_,
+                    vpx_malloc(sizeof(*dering_sync->mutex_) * rows));
+    if (dering_sync->mutex_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_mutex_init(&dering_sync->mutex_[i], NULL);
+      }
+      pthread_mutex_init(&dering_sync->job_mutex, NULL);
+    }
+
+    CHECK_MEM_ERROR(cm, dering_sync->cond_,
+                    vpx_malloc(sizeof(*dering_sync->cond_) * rows));
+    if (dering_sync->cond_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_cond_init(&dering_sync->cond_[i], NULL);
       }
     }
   }
-  for (pli = 0; pli < 3; pli++) {
-    vpx_free(src[pli]);
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, dering_sync->row_ready,
+                  vpx_malloc(sizeof(*dering_sync->row_ready) * rows));
+
+  dering_sync->mi_rows = cm->mi_rows;
+  dering_sync->mi_cols = cm->mi_cols;
+  dering_sync->line_stride = 8 * cm->mi_cols;
+  for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+    CHECK_MEM_ERROR(cm, dering_sync->lines[pli],
+                    vpx_malloc(sizeof(*dering_sync->lines[pli]) * rows * 2 *
+                               OD_FILT_BORDER * dering_sync->line_stride));
+  }
+
+  CHECK_MEM_ERROR(cm, dering_sync->dering_data,
+                  vpx_malloc(num_workers * sizeof(*dering_sync->dering_data)));
+  dering_sync->num_workers = num_workers;
+}
+
+// Deallocate deringing synchronization related mutex and data.
+void vp10_dering_dealloc(VP10DeringSync *dering_sync) {
+  if (dering_sync != NULL) {
+    int pli;
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (dering_sync->mutex_ != NULL) {
+      for (i = 0; i < dering_sync->rows; ++i) {
+        pthread_mutex_destroy(&dering_sync->mutex_[i]);
+      }
+      pthread_mutex_destroy(&dering_sync->job_mutex);
+      vpx_free(dering_sync->mutex_);
+    }
+    if (dering_sync->cond_ != NULL) {
+      for (i = 0; i < dering_sync->rows; ++i) {
+        pthread_cond_destroy(&dering_sync->cond_[i]);
+      }
+      vpx_free(dering_sync->cond_);
+    }
+#endif  // CONFIG_MULTITHREAD
+    for (pli = 0; pli < MAX_MB_PLANE; pli++) {
+      vpx_free(dering_sync->lines[pli]);
+    }
+    vpx_free(dering_sync->row_ready);
+    vpx_free(dering_sync->dering_data);
+    // clear the structure as the source of this call may be a resize in which
+    // case this call will be followed by an _alloc() which may fail.
+    vp10_zero(*dering_sync);
   }
-  vpx_free(bskip);
+}
+
+void vp10_dering_sync_init(VP10DeringSync *dering_sync, VP10_COMMON *cm,
+                           int num_workers) {
+  const int nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
+  if (nvsb != dering_sync->rows || cm->mi_rows != dering_sync->mi_rows ||
+      cm->mi_cols != dering_sync->mi_cols ||
+      num_workers > dering_sync->num_workers) {
+    vp10_dering_dealloc(dering_sync);
+    dering_alloc(dering_sync, cm, nvsb, num_workers);
+  }
+  dering_sync->next_save = 0;
+  dering_sync->next_filter = 0;
+
+  memset(dering_sync->row_ready, 0, sizeof(*dering_sync->row_ready) * nvsb);
+}
+
+void vp10_dering_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                          MACROBLOCKD *xd, int global_level,
+                          VPxThreadPool *pool, int num_jobs,
+                          VP10DeringSync *dering_sync) {
+  const int nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
+  const int num_workers = VPXMIN(num_jobs, nvsb);
+  VPxJobGroup group;
+  int queued = 1;
+  int i;
+
+  if (num_workers <= 1) {
+    vp10_dering_frame(frame, cm, xd, global_level);
+    return;
+  }
+
+  vp10_dering_sync_init(dering_sync, cm, num_workers);
+
+  vpx_job_group_init(&group, pool);
+  for (i = 0; i < num_workers; ++i) {
+    DeringWorkerData *const dering_data = &dering_sync->dering_data[i];
+
+    dering_data->frame = frame;
+    dering_data->cm = cm;
+    dering_data->global_level = global_level;
+    memcpy(dering_data->planes, xd->plane, sizeof(dering_data->planes));
+    vp10_setup_dst_planes(dering_data->planes, frame, 0, 0);
+
+    // Start deringing
+    queued &= vpx_job_group_submit(&group, (VPxWorkerHook)dering_row_worker,
+                                   dering_sync, dering_data);
+  }
+
+  // Wait till all rows are finished
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue dering jobs");
 }
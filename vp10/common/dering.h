@@ -6,6 +6,8 @@
 #include "vpx/vpx_integer.h"
 #include "./vpx_config.h"
 #include "vpx_ports/mem.h"
+#include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,14 +20,77 @@ extern "C" {
 #define DERING_REFINEMENT_BITS 2
 #define DERING_REFINEMENT_LEVELS 4
 
+typedef struct DeringWorkerData {
+  YV12_BUFFER_CONFIG *frame;
+  VP10_COMMON *cm;
+  struct macroblockd_plane planes[MAX_MB_PLANE];
+  int global_level;
+} DeringWorkerData;
+
+// Deringing row synchronization
+typedef struct VP10DeringSyncData {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+  pthread_mutex_t job_mutex;
+#endif
+  // Set once the unfiltered top and bottom lines of a superblock row have
+  // been saved.
+  int *row_ready;
+  int rows;
+
+  // Unfiltered OD_FILT_BORDER lines at the top and bottom of each superblock
+  // row, which the neighbouring rows read across the boundary.
+  od_dering_in *lines[MAX_MB_PLANE];
+  int line_stride;
+  int mi_rows;
+  int mi_cols;
+
+  // Row-based parallel deringing data
+  DeringWorkerData *dering_data;
+  int num_workers;
+  // The next rows to hand out to the jobs, to save the boundary of and to
+  // filter.
+  int next_save;
+  int next_filter;
+} VP10DeringSync;
+
+// Fills 'vtbl' with the best deringing kernels for the running CPU.
+void vp10_dering_init_vtbl(od_dering_opt_vtbl *vtbl);
+
 int compute_level_from_index(int global_level, int gi);
 int sb_all_skip(const VP10_COMMON *const cm, int mi_row, int mi_col);
 void vp10_dering_frame(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
                        MACROBLOCKD *xd, int global_level);
 
-int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
-                      VP10_COMMON *cm,
-                      MACROBLOCKD *xd);
+// Multi-threaded deringing that runs up to 'num_jobs' jobs on 'pool', one
+// superblock row at a time.
+void vp10_dering_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                          MACROBLOCKD *xd, int global_level,
+                          VPxThreadPool *pool, int num_jobs,
+                          VP10DeringSync *dering_sync);
+
+// Allocate or resize 'dering_sync' for the current frame size and reset the
+// row state.
+void vp10_dering_sync_init(VP10DeringSync *dering_sync, VP10_COMMON *cm,
+                           int num_workers);
+
+// Save the unfiltered lines around the top of superblock row 'sbr', which
+// must be done before rows sbr - 1 and sbr are filtered. planes[] must point
+// at the top-left of the frame.
+void vp10_dering_save_boundary(VP10DeringSync *dering_sync,
+                               const VP10_COMMON *cm,
+                               const struct macroblockd_plane
+                               planes[MAX_MB_PLANE], int sbr);
+
+// Dering superblock row 'sbr' in place once the boundaries above and below it
+// have been saved.
+void vp10_dering_sb_row(VP10DeringSync *dering_sync, const VP10_COMMON *cm,
+                        const struct macroblockd_plane planes[MAX_MB_PLANE],
+                        int global_level, int sbr);
+
+// Deallocate deringing synchronization related mutex and data.
+void vp10_dering_dealloc(VP10DeringSync *dering_sync);
 
 #ifdef __cplusplus
 }  // extern "C"
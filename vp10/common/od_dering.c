@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #include <stdlib.h>
 #include <math.h>
 #include "dering.h"
+#include "./vp10_rtcd.h"
 
 const od_dering_opt_vtbl OD_DERING_VTBL_C = {
   {od_filter_dering_direction_4x4_c, od_filter_dering_direction_8x8_c},
@@ -58,7 +59,7 @@ const double OD_DERING_GAIN_TABLE[OD_DERING_LEVELS] = {
    in a particular direction. Since each direction have the same sum(x^2) term,
    that term is never computed. See Section 2, step 2, of:
    http://jmvalin.ca/notes/intra_paint.pdf */
-static int od_dir_find8(const od_dering_in *img, int stride, int32_t *var,
+int od_dir_find8_c(const od_dering_in *img, int stride, int32_t *var,
     int coeff_shift) {
   int i;
   int32_t cost[8] = {0};
@@ -251,11 +252,36 @@ static void od_compute_thresh(int thresh[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
   }
 }
 
+void od_dering_find_dir(const od_dering_in *x, int xstride, int nhb, int nvb,
+ int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
+ int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS], int coeff_shift) {
+  int bx;
+  int by;
+  for (by = 0; by < nvb; by++) {
+    for (bx = 0; bx < nhb; bx++) {
+      dir[by][bx] = od_dir_find8(&x[8*by*xstride + 8*bx], xstride,
+       &var[by][bx], coeff_shift);
+    }
+  }
+}
+
 void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
  const od_dering_in *x, int xstride, int nhb, int nvb, int sbx, int sby,
  int nhsb, int nvsb, int xdec, int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
  int pli, unsigned char *bskip, int skip_stride, int threshold, int overlap,
  int coeff_shift) {
+  int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+  if (pli == 0) od_dering_find_dir(x, xstride, nhb, nvb, dir, var, coeff_shift);
+  od_dering_filter(vtbl, y, ystride, x, xstride, nhb, nvb, sbx, sby, nhsb,
+   nvsb, xdec, dir, var, pli, bskip, skip_stride, threshold, overlap);
+}
+
+void od_dering_filter(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
+ const od_dering_in *x, int xstride, int nhb, int nvb, int sbx, int sby,
+ int nhsb, int nvsb, int xdec,
+ int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
+ int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS], int pli,
+ unsigned char *bskip, int skip_stride, int threshold, int overlap) {
   int i;
   int j;
   int bx;
@@ -263,7 +289,6 @@ void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
   int16_t inbuf[OD_DERING_INBUF_SIZE];
   int16_t *in;
   int bsize;
-  int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
   int thresh[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
   bsize = 3 - xdec;
   in = inbuf + OD_FILT_BORDER*OD_FILT_BSTRIDE + OD_FILT_BORDER;
@@ -279,12 +304,6 @@ void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
     }
   }
   if (pli == 0) {
-    for (by = 0; by < nvb; by++) {
-      for (bx = 0; bx < nhb; bx++) {
-        dir[by][bx] = od_dir_find8(&x[8*by*xstride + 8*bx], xstride,
-         &var[by][bx], coeff_shift);
-      }
-    }
     od_compute_thresh(thresh, threshold, var, nhb, nvb);
   }
   else {
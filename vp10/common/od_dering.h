@@ -65,6 +65,22 @@ void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
  int nhsb, int nvsb, int xdec, int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
  int pli, unsigned char *bskip, int skip_stride, int threshold, int overlap,
  int coeff_shift);
+/* Find the direction and directional variance of each 8x8 luma block. These
+   do not depend on the threshold, so they can be computed once and reused
+   with od_dering_filter() to try several thresholds on the same input. */
+void od_dering_find_dir(const od_dering_in *x, int xstride, int nhb, int nvb,
+ int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
+ int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS], int coeff_shift);
+/* Same as od_dering(), with the luma directions and variances taken from
+   od_dering_find_dir(). var is only read for pli == 0. */
+void od_dering_filter(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
+ const od_dering_in *x, int xstride, int nhb, int nvb, int sbx, int sby,
+ int nhsb, int nvsb, int xdec,
+ int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
+ int32_t var[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS], int pli,
+ unsigned char *bskip, int skip_stride, int threshold, int overlap);
+int od_dir_find8_c(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift);
 void od_filter_dering_direction_c(int16_t *y, int ystride, const int16_t *in,
  int ln, int threshold, int dir);
 void od_filter_dering_orthogonal_c(int16_t *y, int ystride, const int16_t *in,
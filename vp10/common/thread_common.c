@@ -11,6 +11,12 @@
 #include "./vpx_config.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx_mem/vpx_mem.h"
+#if CONFIG_CLPF
+#include "vp10/common/clpf.h"
+#endif  // CONFIG_CLPF
+#if CONFIG_DERING
+#include "vp10/common/dering.h"
+#endif  // CONFIG_DERING
 #include "vp10/common/entropymode.h"
 #include "vp10/common/thread_common.h"
 #include "vp10/common/reconinter.h"
@@ -84,11 +90,135 @@ static INLINE void sync_write(VP10LfSync *const lf_sync, int r, int c,
 #endif  // CONFIG_MULTITHREAD
 }
 
-// Implement row loopfiltering for each thread.
+// Stages of a superblock row after it has been loop filtered. A row is
+// LF_ROW_SAVED once the unfiltered lines around its top boundary have been
+// saved for deringing, and LF_ROW_DONE once the rows above it have been
+// deringed and CLPF filtered as far as its loop filter allows.
+enum { LF_ROW_SAVED = 1, LF_ROW_DONE = 2 };
+
+static INLINE void sync_stage_write(VP10LfSync *const lf_sync, int r,
+                                    int stage) {
+#if CONFIG_MULTITHREAD
+  mutex_lock(&lf_sync->mutex_[r]);
+  lf_sync->stage[r] = stage;
+  pthread_cond_signal(&lf_sync->cond_[r]);
+  pthread_mutex_unlock(&lf_sync->mutex_[r]);
+#else
+  lf_sync->stage[r] = stage;
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Wait until superblock row 'r' has reached 'stage'. Only the worker of row
+// r + 1 waits on row r, so a single signal per update is enough.
+static INLINE void sync_stage_read(VP10LfSync *const lf_sync, int r,
+                                   int stage) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *const mutex = &lf_sync->mutex_[r];
+  mutex_lock(mutex);
+
+  while (lf_sync->stage[r] < stage) {
+    pthread_cond_wait(&lf_sync->cond_[r], mutex);
+  }
+  pthread_mutex_unlock(mutex);
+#else
+  (void)lf_sync;
+  (void)r;
+  (void)stage;
+#endif  // CONFIG_MULTITHREAD
+}
+
+static void dering_row(const YV12_BUFFER_CONFIG *const frame_buffer,
+                       VP10_COMMON *const cm,
+                       struct macroblockd_plane planes[MAX_MB_PLANE], int r,
+                       VP10LfSync *const lf_sync) {
+#if CONFIG_DERING
+  if (lf_sync->dering_level) {
+    vp10_setup_dst_planes(planes, frame_buffer, 0, 0);
+    vp10_dering_sb_row(lf_sync->dering_sync, cm, planes,
+                       lf_sync->dering_level, r);
+  }
+#else
+  (void)frame_buffer;
+  (void)cm;
+  (void)planes;
+  (void)r;
+  (void)lf_sync;
+#endif  // CONFIG_DERING
+}
+
+static void clpf_row(const YV12_BUFFER_CONFIG *const frame_buffer,
+                     VP10_COMMON *const cm,
+                     struct macroblockd_plane planes[MAX_MB_PLANE], int r,
+                     VP10LfSync *const lf_sync) {
+#if CONFIG_CLPF
+  if (lf_sync->clpf)
+    vp10_clpf_sb_row(frame_buffer, cm, planes, r << MI_BLOCK_SIZE_LOG2);
+#else
+  (void)frame_buffer;
+  (void)cm;
+  (void)planes;
+  (void)r;
+  (void)lf_sync;
+#endif  // CONFIG_CLPF
+}
+
+// Run the filters that follow the loop filter once superblock row 'r' has
+// been loop filtered. The pixels of row r - 1 are then final, so it can be
+// deringed, and row r - 2 can be CLPF filtered since the rows around it have
+// been deringed. The last row also finishes the rows that remain.
+static void post_filter_rows(const YV12_BUFFER_CONFIG *const frame_buffer,
+                             VP10_COMMON *const cm,
+                             struct macroblockd_plane planes[MAX_MB_PLANE],
+                             int r, VP10LfSync *const lf_sync) {
+  if (!lf_sync->dering_level && !lf_sync->clpf) return;
+
+#if CONFIG_DERING
+  if (lf_sync->dering_level && r > 0) {
+    vp10_setup_dst_planes(planes, frame_buffer, 0, 0);
+    vp10_dering_save_boundary(lf_sync->dering_sync, cm, planes, r);
+  }
+#endif  // CONFIG_DERING
+  sync_stage_write(lf_sync, r, LF_ROW_SAVED);
+
+  if (r > 0) {
+    sync_stage_read(lf_sync, r - 1, LF_ROW_SAVED);
+    dering_row(frame_buffer, cm, planes, r - 1, lf_sync);
+  }
+  if (r > 1) {
+    sync_stage_read(lf_sync, r - 1, LF_ROW_DONE);
+    clpf_row(frame_buffer, cm, planes, r - 2, lf_sync);
+  }
+  sync_stage_write(lf_sync, r, LF_ROW_DONE);
+
+  if (r == lf_sync->rows - 1) {
+    dering_row(frame_buffer, cm, planes, r, lf_sync);
+    if (r > 0) clpf_row(frame_buffer, cm, planes, r - 1, lf_sync);
+    clpf_row(frame_buffer, cm, planes, r, lf_sync);
+  }
+}
+
+// Hands out the superblock rows above 'stop' to the jobs in order, so a job
+// only ever waits for rows that running jobs have taken.
+static int get_next_mi_row(VP10LfSync *const lf_sync, int stop) {
+  int mi_row = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&lf_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  if (lf_sync->next_mi_row < stop) {
+    mi_row = lf_sync->next_mi_row;
+    lf_sync->next_mi_row += MI_BLOCK_SIZE;
+  }
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&lf_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  return mi_row;
+}
+
+// Implement row loopfiltering for each job.
 static INLINE void thread_loop_filter_rows(
     const YV12_BUFFER_CONFIG *const frame_buffer, VP10_COMMON *const cm,
-    struct macroblockd_plane planes[MAX_MB_PLANE], int start, int stop,
-    int y_only, VP10LfSync *const lf_sync) {
+    struct macroblockd_plane planes[MAX_MB_PLANE], int stop, int y_only,
+    VP10LfSync *const lf_sync) {
   const int num_planes = y_only ? 1 : MAX_MB_PLANE;
   const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
   int mi_row, mi_col;
@@ -102,11 +232,11 @@ static INLINE void thread_loop_filter_rows(
   else
     path = LF_PATH_SLOW;
 
-  for (mi_row = start; mi_row < stop;
-       mi_row += lf_sync->num_workers * MI_BLOCK_SIZE) {
+  while ((mi_row = get_next_mi_row(lf_sync, stop)) >= 0) {
     MODE_INFO **const mi = cm->mi_grid_visible + mi_row * cm->mi_stride;
 
-    for (mi_col = 0; mi_col < cm->mi_cols; mi_col += MI_BLOCK_SIZE) {
+    for (mi_col = 0; mi_col < cm->mi_cols && lf_sync->filter_level;
+         mi_col += MI_BLOCK_SIZE) {
       const int r = mi_row >> MI_BLOCK_SIZE_LOG2;
       const int c = mi_col >> MI_BLOCK_SIZE_LOG2;
       LOOP_FILTER_MASK lfm;
@@ -137,40 +267,76 @@ static INLINE void thread_loop_filter_rows(
 
       sync_write(lf_sync, r, c, sb_cols);
     }
+
+    post_filter_rows(frame_buffer, cm, planes, mi_row >> MI_BLOCK_SIZE_LOG2,
+                     lf_sync);
   }
 }
 
-// Row-based multi-threaded loopfilter hook
-static int loop_filter_row_worker(VP10LfSync *const lf_sync,
-                                  LFWorkerData *const lf_data) {
+int vp10_loop_filter_row_worker(VP10LfSync *const lf_sync,
+                                LFWorkerData *const lf_data) {
   thread_loop_filter_rows(lf_data->frame_buffer, lf_data->cm, lf_data->planes,
-                          lf_data->start, lf_data->stop, lf_data->y_only,
-                          lf_sync);
+                          lf_data->stop, lf_data->y_only, lf_sync);
   return 1;
 }
 
-static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
-                                struct macroblockd_plane planes[MAX_MB_PLANE],
-                                int start, int stop, int y_only,
-                                VPxWorker *workers, int nworkers,
-                                VP10LfSync *lf_sync) {
-  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
-  // Number of superblock rows and cols
+int vp10_loop_filter_rows_final(const VP10LfSync *lf_sync, int mi_row) {
+  // The loop filter of the next row still changes the bottom of the last
+  // row, and post_filter_rows() deringes a row behind the loop filter and
+  // CLPF filters a row behind the deringing.
+  const int sb_rows =
+      (mi_row >> MI_BLOCK_SIZE_LOG2) - 1 - (lf_sync->clpf ? 1 : 0);
+  return VPXMAX(sb_rows, 0) << (MI_BLOCK_SIZE_LOG2 + MI_SIZE_LOG2);
+}
+
+void vp10_loop_filter_rows_init(VP10LfSync *lf_sync, VP10_COMMON *cm,
+                                int num_workers, int filter_level,
+                                int dering_level, int clpf,
+                                struct VP10DeringSyncData *dering_sync) {
+  // Number of superblock rows
   const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
-  // Decoder may allocate more threads than number of tiles based on user's
-  // input.
-  const int tile_cols = 1 << cm->log2_tile_cols;
-  const int num_workers = VPXMIN(nworkers, tile_cols);
-  int i;
 
   if (!lf_sync->sync_range || sb_rows != lf_sync->rows ||
       num_workers > lf_sync->num_workers) {
     vp10_loop_filter_dealloc(lf_sync);
     vp10_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width, num_workers);
   }
+  // The rows are handed out from the top. Callers that filter the frame in
+  // several calls do so from the top down, each call carrying on from the
+  // row the previous one stopped at.
+  lf_sync->next_mi_row = 0;
 
   // Initialize cur_sb_col to -1 for all SB rows.
   memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
+  memset(lf_sync->stage, 0, sizeof(*lf_sync->stage) * sb_rows);
+
+  lf_sync->filter_level = filter_level;
+  lf_sync->dering_level = dering_level;
+  lf_sync->clpf = clpf;
+  lf_sync->dering_sync = dering_sync;
+#if CONFIG_DERING
+  if (dering_level) vp10_dering_sync_init(dering_sync, cm, 1);
+#endif  // CONFIG_DERING
+}
+
+static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                                struct macroblockd_plane planes[MAX_MB_PLANE],
+                                int start, int stop, int y_only,
+                                int filter_level, int dering_level, int clpf,
+                                struct VP10DeringSyncData *dering_sync,
+                                VPxThreadPool *pool, int num_jobs,
+                                VP10LfSync *lf_sync) {
+  // Decoder may allocate more threads than number of tiles based on user's
+  // input.
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int num_workers = VPXMIN(num_jobs, tile_cols);
+  VPxJobGroup group;
+  int queued = 1;
+  int i;
+
+  vp10_loop_filter_rows_init(lf_sync, cm, num_workers, filter_level,
+                             dering_level, clpf, dering_sync);
+  lf_sync->next_mi_row = start;
 
   // Set up loopfilter thread data.
   // The decoder is capping num_workers because it has been observed that using
@@ -180,39 +346,33 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
   // tries to use more threads for the loopfilter, it will hurt performance
   // because of contention. If the multithreading code changes in the future
   // then the number of workers used by the loopfilter should be revisited.
+  vpx_job_group_init(&group, pool);
   for (i = 0; i < num_workers; ++i) {
-    VPxWorker *const worker = &workers[i];
     LFWorkerData *const lf_data = &lf_sync->lfdata[i];
 
-    worker->hook = (VPxWorkerHook)loop_filter_row_worker;
-    worker->data1 = lf_sync;
-    worker->data2 = lf_data;
-
     // Loopfilter data
     vp10_loop_filter_data_reset(lf_data, frame, cm, planes);
-    lf_data->start = start + i * MI_BLOCK_SIZE;
+    lf_data->start = start;
     lf_data->stop = stop;
     lf_data->y_only = y_only;
 
     // Start loopfiltering
-    if (i == num_workers - 1) {
-      winterface->execute(worker);
-    } else {
-      winterface->launch(worker);
-    }
+    queued &= vpx_job_group_submit(
+        &group, (VPxWorkerHook)vp10_loop_filter_row_worker, lf_sync, lf_data);
   }
 
   // Wait till all rows are finished
-  for (i = 0; i < num_workers; ++i) {
-    winterface->sync(&workers[i]);
-  }
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue loop filter jobs");
 }
 
 void vp10_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
                                struct macroblockd_plane planes[MAX_MB_PLANE],
                                int frame_filter_level, int y_only,
-                               int partial_frame, VPxWorker *workers,
-                               int num_workers, VP10LfSync *lf_sync) {
+                               int partial_frame, VPxThreadPool *pool,
+                               int num_jobs, VP10LfSync *lf_sync) {
   int start_mi_row, end_mi_row, mi_rows_to_filter;
 
   if (!frame_filter_level) return;
@@ -228,9 +388,79 @@ void vp10_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
   vp10_loop_filter_frame_init(cm, frame_filter_level);
 
   loop_filter_rows_mt(frame, cm, planes, start_mi_row, end_mi_row, y_only,
-                      workers, num_workers, lf_sync);
+                      frame_filter_level, 0, 0, NULL, pool, num_jobs, lf_sync);
+}
+
+void vp10_post_filter_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                               struct macroblockd_plane planes[MAX_MB_PLANE],
+                               int frame_filter_level, int dering_level,
+                               int clpf, VPxThreadPool *pool, int num_jobs,
+                               VP10LfSync *lf_sync,
+                               struct VP10DeringSyncData *dering_sync) {
+  if (!frame_filter_level && !dering_level && !clpf) return;
+
+  if (frame_filter_level) vp10_loop_filter_frame_init(cm, frame_filter_level);
+
+  loop_filter_rows_mt(frame, cm, planes, 0, cm->mi_rows, 0,
+                      frame_filter_level, dering_level, clpf, dering_sync,
+                      pool, num_jobs, lf_sync);
+}
+
+#if CONFIG_CLPF
+// Row-based multi-threaded CLPF hook. A superblock reads the unfiltered
+// pixels of the superblock below it, so each row stays behind the row above
+// it as in the loop filter.
+static int clpf_row_worker(VP10LfSync *const lf_sync,
+                           LFWorkerData *const lf_data) {
+  const VP10_COMMON *const cm = lf_data->cm;
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
+  int mi_row, mi_col;
+
+  while ((mi_row = get_next_mi_row(lf_sync, lf_data->stop)) >= 0) {
+    for (mi_col = 0; mi_col < cm->mi_cols; mi_col += MI_BLOCK_SIZE) {
+      const int r = mi_row >> MI_BLOCK_SIZE_LOG2;
+      const int c = mi_col >> MI_BLOCK_SIZE_LOG2;
+
+      sync_read(lf_sync, r, c);
+      vp10_clpf_sb(lf_data->frame_buffer, cm, lf_data->planes,
+                   cm->mi_grid_visible, mi_col, mi_row);
+      sync_write(lf_sync, r, c, sb_cols);
+    }
+  }
+  return 1;
 }
 
+void vp10_clpf_frame_mt(YV12_BUFFER_CONFIG *frame, VP10_COMMON *cm,
+                        struct macroblockd_plane planes[MAX_MB_PLANE],
+                        VPxThreadPool *pool, int num_jobs,
+                        VP10LfSync *lf_sync) {
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int num_workers = VPXMIN(num_jobs, sb_rows);
+  VPxJobGroup group;
+  int queued = 1;
+  int i;
+
+  vp10_loop_filter_rows_init(lf_sync, cm, num_workers, 0, 0, 0, NULL);
+
+  vpx_job_group_init(&group, pool);
+  for (i = 0; i < num_workers; ++i) {
+    LFWorkerData *const lf_data = &lf_sync->lfdata[i];
+
+    vp10_loop_filter_data_reset(lf_data, frame, cm, planes);
+    lf_data->start = 0;
+    lf_data->stop = cm->mi_rows;
+
+    queued &= vpx_job_group_submit(&group, (VPxWorkerHook)clpf_row_worker,
+                                   lf_sync, lf_data);
+  }
+
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue CLPF jobs");
+}
+#endif  // CONFIG_CLPF
+
 // Set up nsync by width.
 static INLINE int get_sync_range(int width) {
   // nsync numbers are picked by testing. For example, for 4k
@@ -259,6 +489,7 @@ void vp10_loop_filter_alloc(VP10LfSync *lf_sync, VP10_COMMON *cm, int rows,
       for (i = 0; i < rows; ++i) {
         pthread_mutex_init(&lf_sync->mutex_[i], NULL);
       }
+      pthread_mutex_init(&lf_sync->job_mutex, NULL);
     }
 
     CHECK_MEM_ERROR(cm, lf_sync->cond_,
@@ -278,6 +509,9 @@ void vp10_loop_filter_alloc(VP10LfSync *lf_sync, VP10_COMMON *cm, int rows,
   CHECK_MEM_ERROR(cm, lf_sync->cur_sb_col,
                   vpx_malloc(sizeof(*lf_sync->cur_sb_col) * rows));
 
+  CHECK_MEM_ERROR(cm, lf_sync->stage,
+                  vpx_malloc(sizeof(*lf_sync->stage) * rows));
+
   // Set up nsync.
   lf_sync->sync_range = get_sync_range(width);
 }
@@ -292,6 +526,7 @@ void vp10_loop_filter_dealloc(VP10LfSync *lf_sync) {
       for (i = 0; i < lf_sync->rows; ++i) {
         pthread_mutex_destroy(&lf_sync->mutex_[i]);
       }
+      pthread_mutex_destroy(&lf_sync->job_mutex);
       vpx_free(lf_sync->mutex_);
     }
     if (lf_sync->cond_ != NULL) {
@@ -303,6 +538,7 @@ void vp10_loop_filter_dealloc(VP10LfSync *lf_sync) {
 #endif  // CONFIG_MULTITHREAD
     vpx_free(lf_sync->lfdata);
     vpx_free(lf_sync->cur_sb_col);
+    vpx_free(lf_sync->stage);
     // clear the structure as the source of this call may be a resize in which
     // case this call will be followed by an _alloc() which may fail.
     vp10_zero(*lf_sync);
@@ -310,8 +546,8 @@ void vp10_loop_filter_dealloc(VP10LfSync *lf_sync) {
 }
 
 // Accumulate frame counts.
-void vp10_accumulate_frame_counts(VP10_COMMON *cm, FRAME_COUNTS *counts,
-                                  int is_dec) {
+void vp10_accumulate_frame_counts(VP10_COMMON *cm,
+                                  const FRAME_COUNTS *counts, int is_dec) {
   int i, j, k, l, m;
 
   for (i = 0; i < BLOCK_SIZE_GROUPS; i++)
@@ -400,7 +636,7 @@ void vp10_accumulate_frame_counts(VP10_COMMON *cm, FRAME_COUNTS *counts,
 
   for (k = 0; k < 2; k++) {
     nmv_component_counts *comps = &cm->counts.mv.comps[k];
-    nmv_component_counts *comps_t = &counts->mv.comps[k];
+    const nmv_component_counts *comps_t = &counts->mv.comps[k];
 
     for (i = 0; i < 2; i++) {
       comps->sign[i] += comps_t->sign[i];
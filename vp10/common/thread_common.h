@@ -13,12 +13,14 @@
 #include "./vpx_config.h"
 #include "vp10/common/loopfilter.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 struct VP10Common;
+struct VP10DeringSyncData;
 struct FRAME_COUNTS;
 
 // Loopfilter row synchronization
@@ -26,6 +28,7 @@ typedef struct VP10LfSyncData {
 #if CONFIG_MULTITHREAD
   pthread_mutex_t *mutex_;
   pthread_cond_t *cond_;
+  pthread_mutex_t job_mutex;
 #endif
   // Allocate memory to store the loop-filtered superblock index in each row.
   int *cur_sb_col;
@@ -34,9 +37,19 @@ typedef struct VP10LfSyncData {
   int sync_range;
   int rows;
 
+  // Progress of each superblock row through the filters that follow the
+  // loop filter, see vp10_loop_filter_rows_init().
+  int *stage;
+  int filter_level;
+  int dering_level;
+  int clpf;
+  struct VP10DeringSyncData *dering_sync;
+
   // Row-based parallel loopfilter data
   LFWorkerData *lfdata;
   int num_workers;
+  // The next row to hand out to the jobs.
+  int next_mi_row;
 } VP10LfSync;
 
 // Allocate memory for loopfilter row synchronization.
@@ -46,15 +59,55 @@ void vp10_loop_filter_alloc(VP10LfSync *lf_sync, struct VP10Common *cm,
 // Deallocate loopfilter synchronization related mutex and data.
 void vp10_loop_filter_dealloc(VP10LfSync *lf_sync);
 
-// Multi-threaded loopfilter that uses the tile threads.
+// Prepare 'lf_sync' to filter the superblock rows of the current frame with
+// 'num_workers' jobs. Each row is loop filtered at 'filter_level' (if not
+// zero), then deringed at 'dering_level' and CLPF filtered (if 'clpf' is set)
+// once the neighbouring rows it reads are finished. 'dering_sync' holds the
+// unfiltered lines needed by deringing.
+void vp10_loop_filter_rows_init(VP10LfSync *lf_sync, struct VP10Common *cm,
+                                int num_workers, int filter_level,
+                                int dering_level, int clpf,
+                                struct VP10DeringSyncData *dering_sync);
+
+// Row-based filter hook. Filters superblock rows up to the end of 'lf_data',
+// taking them in order with the other jobs of 'lf_sync', as set up by
+// vp10_loop_filter_rows_init().
+int vp10_loop_filter_row_worker(VP10LfSync *const lf_sync,
+                                LFWorkerData *const lf_data);
+
+// Returns the number of luma pixel rows at the top of the frame that no
+// filter changes any more, once vp10_loop_filter_row_worker() has filtered
+// the superblock rows above 'mi_row' and the rows below it have yet to be.
+int vp10_loop_filter_rows_final(const VP10LfSync *lf_sync, int mi_row);
+
+// Multi-threaded loopfilter that runs up to 'num_jobs' jobs on 'pool'.
 void vp10_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct VP10Common *cm,
                                struct macroblockd_plane planes[MAX_MB_PLANE],
                                int frame_filter_level, int y_only,
-                               int partial_frame, VPxWorker *workers,
-                               int num_workers, VP10LfSync *lf_sync);
+                               int partial_frame, VPxThreadPool *pool,
+                               int num_jobs, VP10LfSync *lf_sync);
+
+// Multi-threaded loop filter, deringing and CLPF of the whole frame that runs
+// up to 'num_jobs' jobs on 'pool'.
+void vp10_post_filter_frame_mt(YV12_BUFFER_CONFIG *frame, struct VP10Common *cm,
+                               struct macroblockd_plane planes[MAX_MB_PLANE],
+                               int frame_filter_level, int dering_level,
+                               int clpf, VPxThreadPool *pool, int num_jobs,
+                               VP10LfSync *lf_sync,
+                               struct VP10DeringSyncData *dering_sync);
+
+#if CONFIG_CLPF
+// Multi-threaded CLPF of the whole frame that runs up to 'num_jobs' jobs on
+// 'pool', one superblock row at a time.
+void vp10_clpf_frame_mt(YV12_BUFFER_CONFIG *frame, struct VP10Common *cm,
+                        struct macroblockd_plane planes[MAX_MB_PLANE],
+                        VPxThreadPool *pool, int num_jobs,
+                        VP10LfSync *lf_sync);
+#endif  // CONFIG_CLPF
 
 void vp10_accumulate_frame_counts(struct VP10Common *cm,
-                                  struct FRAME_COUNTS *counts, int is_dec);
+                                  const struct FRAME_COUNTS *counts,
+                                  int is_dec);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vp10/common/clpf.h"
+#include "vpx_ports/mem.h"
+
+// Loads four 8-pixel rows, two in each 128-bit lane.
+static INLINE __m256i load_8x4(const uint8_t *p0, const uint8_t *p1,
+                               const uint8_t *p2, const uint8_t *p3) {
+  const __m128i lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p0),
+                                        _mm_loadl_epi64((const __m128i *)p1));
+  const __m128i hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p2),
+                                        _mm_loadl_epi64((const __m128i *)p3));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// See clpf_adjust() in clpf_sse2.c.
+static INLINE __m256i clpf_adjust(__m256i x, __m256i a, __m256i b, __m256i c,
+                                  __m256i d) {
+  const __m256i sign = _mm256_set1_epi8(-128);
+  const __m256i minus_two = _mm256_set1_epi8(-2);
+  const __m256i xs = _mm256_xor_si256(x, sign);
+  const __m256i as = _mm256_xor_si256(a, sign);
+  const __m256i bs = _mm256_xor_si256(b, sign);
+  const __m256i cs = _mm256_xor_si256(c, sign);
+  const __m256i ds = _mm256_xor_si256(d, sign);
+  const __m256i larger = _mm256_add_epi8(
+      _mm256_add_epi8(_mm256_cmpgt_epi8(as, xs), _mm256_cmpgt_epi8(bs, xs)),
+      _mm256_add_epi8(_mm256_cmpgt_epi8(cs, xs), _mm256_cmpgt_epi8(ds, xs)));
+  const __m256i smaller = _mm256_add_epi8(
+      _mm256_add_epi8(_mm256_cmpgt_epi8(xs, as), _mm256_cmpgt_epi8(xs, bs)),
+      _mm256_add_epi8(_mm256_cmpgt_epi8(xs, cs), _mm256_cmpgt_epi8(xs, ds)));
+  return _mm256_add_epi8(x,
+                         _mm256_sub_epi8(_mm256_cmpgt_epi8(minus_two, smaller),
+                                         _mm256_cmpgt_epi8(minus_two, larger)));
+}
+
+void vp10_clpf_block_avx2(const uint8_t *src, uint8_t *dst, int sstride,
+                          int dstride, int has_top, int has_left,
+                          int has_bottom, int has_right, int width,
+                          int height) {
+  int y;
+
+  if (width != 8 || (height & 3)) {
+    vp10_clpf_block_c(src, dst, sstride, dstride, has_top, has_left,
+                      has_bottom, has_right, width, height);
+    return;
+  }
+
+  for (y = 0; y < height; y += 4) {
+    const uint8_t *const s0 = src + y * sstride;
+    const uint8_t *const s1 = s0 + sstride;
+    const uint8_t *const s2 = s1 + sstride;
+    const uint8_t *const s3 = s2 + sstride;
+    const __m256i x = load_8x4(s0, s1, s2, s3);
+    // A missing neighbour is replaced by the pixel itself.
+    const __m256i a = has_top ? load_8x4(s0 - sstride, s0, s1, s2) : x;
+    const __m256i b = has_left ? load_8x4(s0 - 1, s1 - 1, s2 - 1, s3 - 1) : x;
+    const __m256i c = has_right ? load_8x4(s0 + 1, s1 + 1, s2 + 1, s3 + 1) : x;
+    const __m256i d = has_bottom ? load_8x4(s1, s2, s3, s3 + sstride) : x;
+    const __m256i out = clpf_adjust(x, a, b, c, d);
+    const __m128i lo = _mm256_castsi256_si128(out);
+    const __m128i hi = _mm256_extracti128_si256(out, 1);
+    _mm_storel_epi64((__m128i *)(dst + y * dstride), lo);
+    _mm_storel_epi64((__m128i *)(dst + (y + 1) * dstride),
+                     _mm_srli_si128(lo, 8));
+    _mm_storel_epi64((__m128i *)(dst + (y + 2) * dstride), hi);
+    _mm_storel_epi64((__m128i *)(dst + (y + 3) * dstride),
+                     _mm_srli_si128(hi, 8));
+  }
+}
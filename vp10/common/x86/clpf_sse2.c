@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp10_rtcd.h"
+#include "vp10/common/clpf.h"
+#include "vpx_ports/mem.h"
+
+// Loads two 8-pixel rows.
+static INLINE __m128i load_8x2(const uint8_t *p0, const uint8_t *p1) {
+  return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p0),
+                            _mm_loadl_epi64((const __m128i *)p1));
+}
+
+// Returns 'x' adjusted by +1 if more than two of its neighbours are larger
+// and by -1 if more than two are smaller.
+static INLINE __m128i clpf_adjust(__m128i x, __m128i a, __m128i b, __m128i c,
+                                  __m128i d) {
+  // Unsigned bytes are compared as signed ones with the sign bit flipped.
+  const __m128i sign = _mm_set1_epi8(-128);
+  const __m128i minus_two = _mm_set1_epi8(-2);
+  const __m128i xs = _mm_xor_si128(x, sign);
+  const __m128i as = _mm_xor_si128(a, sign);
+  const __m128i bs = _mm_xor_si128(b, sign);
+  const __m128i cs = _mm_xor_si128(c, sign);
+  const __m128i ds = _mm_xor_si128(d, sign);
+  // The comparisons give -1 when true, so these are the negated counts.
+  const __m128i larger = _mm_add_epi8(
+      _mm_add_epi8(_mm_cmpgt_epi8(as, xs), _mm_cmpgt_epi8(bs, xs)),
+      _mm_add_epi8(_mm_cmpgt_epi8(cs, xs), _mm_cmpgt_epi8(ds, xs)));
+  const __m128i smaller = _mm_add_epi8(
+      _mm_add_epi8(_mm_cmplt_epi8(as, xs), _mm_cmplt_epi8(bs, xs)),
+      _mm_add_epi8(_mm_cmplt_epi8(cs, xs), _mm_cmplt_epi8(ds, xs)));
+  // A larger neighbour means x < 255 and a smaller one x > 0, so the result
+  // cannot wrap.
+  return _mm_add_epi8(x, _mm_sub_epi8(_mm_cmplt_epi8(smaller, minus_two),
+                                      _mm_cmplt_epi8(larger, minus_two)));
+}
+
+// The kernel only compares and adds bytes, so SSSE3 and later have nothing
+// to add and use this version as well.
+void vp10_clpf_block_sse2(const uint8_t *src, uint8_t *dst, int sstride,
+                          int dstride, int has_top, int has_left,
+                          int has_bottom, int has_right, int width,
+                          int height) {
+  int y;
+
+  if (width != 8 || (height & 1)) {
+    vp10_clpf_block_c(src, dst, sstride, dstride, has_top, has_left,
+                      has_bottom, has_right, width, height);
+    return;
+  }
+
+  for (y = 0; y < height; y += 2) {
+    const uint8_t *const s = src + y * sstride;
+    const __m128i x = load_8x2(s, s + sstride);
+    // A missing neighbour is replaced by the pixel itself.
+    const __m128i a = has_top ? load_8x2(s - sstride, s) : x;
+    const __m128i b = has_left ? load_8x2(s - 1, s + sstride - 1) : x;
+    const __m128i c = has_right ? load_8x2(s + 1, s + sstride + 1) : x;
+    const __m128i d = has_bottom ? load_8x2(s + sstride, s + 2 * sstride) : x;
+    const __m128i out = clpf_adjust(x, a, b, c, d);
+    _mm_storel_epi64((__m128i *)(dst + y * dstride), out);
+    _mm_storel_epi64((__m128i *)(dst + (y + 1) * dstride),
+                     _mm_srli_si128(out, 8));
+  }
+}
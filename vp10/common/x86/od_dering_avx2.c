@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vp10/common/od_dering.h"
+#include "vpx_ports/mem.h"
+
+// Loads row 'p' into the low lane and row 'p + stride' into the high lane.
+static INLINE __m256i load_8x2(const int16_t *p, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+      _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+}
+
+static INLINE void store_8x2(int16_t *p, int stride, __m256i v) {
+  _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i *)(p + stride), _mm256_extracti128_si256(v, 1));
+}
+
+// Returns 'p - yy' if it is within 'thresh' of 'yy' and 0 otherwise.
+static INLINE __m256i constrain(__m256i p, __m256i yy, __m256i thresh) {
+  const __m256i d = _mm256_sub_epi16(p, yy);
+  return _mm256_and_si256(
+      d, _mm256_cmpgt_epi16(thresh, _mm256_abs_epi16(d)));
+}
+
+// See od_filter_dering_direction_c(). The (x + 8) >> 4 rounding is done
+// with _mm256_mulhrs_epi16(), which keeps the full 32-bit product.
+void od_filter_dering_direction_8x8_avx2(int16_t *y, int ystride,
+                                         const int16_t *in, int threshold,
+                                         int dir) {
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  const __m256i round = _mm256_set1_epi16(1 << 11);
+  const int off0 = OD_DIRECTION_OFFSETS_TABLE[dir][0];
+  const int off1 = OD_DIRECTION_OFFSETS_TABLE[dir][1];
+  const int off2 = OD_DIRECTION_OFFSETS_TABLE[dir][2];
+  int i;
+  for (i = 0; i < 8; i += 2) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m256i xx = load_8x2(row, OD_FILT_BSTRIDE);
+    const __m256i sum0 = _mm256_add_epi16(
+        constrain(load_8x2(row + off0, OD_FILT_BSTRIDE), xx, thresh),
+        constrain(load_8x2(row - off0, OD_FILT_BSTRIDE), xx, thresh));
+    const __m256i sum1 = _mm256_add_epi16(
+        constrain(load_8x2(row + off1, OD_FILT_BSTRIDE), xx, thresh),
+        constrain(load_8x2(row - off1, OD_FILT_BSTRIDE), xx, thresh));
+    const __m256i sum2 = _mm256_add_epi16(
+        constrain(load_8x2(row + off2, OD_FILT_BSTRIDE), xx, thresh),
+        constrain(load_8x2(row - off2, OD_FILT_BSTRIDE), xx, thresh));
+    // 3 * sum0 + 2 * (sum1 + sum2)
+    const __m256i sum = _mm256_add_epi16(
+        _mm256_add_epi16(sum0, _mm256_slli_epi16(sum0, 1)),
+        _mm256_slli_epi16(_mm256_add_epi16(sum1, sum2), 1));
+    store_8x2(y + i * ystride, ystride,
+              _mm256_add_epi16(xx, _mm256_mulhrs_epi16(sum, round)));
+  }
+}
+
+// See od_filter_dering_orthogonal_c().
+void od_filter_dering_orthogonal_8x8_avx2(int16_t *y, int ystride,
+                                          const int16_t *in, const int16_t *x,
+                                          int xstride, int threshold,
+                                          int dir) {
+  const int offset = (dir > 0 && dir < 4) ? OD_FILT_BSTRIDE : 1;
+  const __m256i thresh = _mm256_set1_epi16(threshold);
+  const __m256i thresh3 = _mm256_set1_epi16(threshold / 3);
+  const __m256i round3 = _mm256_set1_epi16(3 << 11);
+  int i;
+  for (i = 0; i < 8; i += 2) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m256i yy = load_8x2(row, OD_FILT_BSTRIDE);
+    const __m256i xx = load_8x2(x + i * xstride, xstride);
+    const __m256i athresh = _mm256_min_epi16(
+        thresh,
+        _mm256_add_epi16(thresh3, _mm256_abs_epi16(_mm256_sub_epi16(yy, xx))));
+    const __m256i sum = _mm256_add_epi16(
+        _mm256_add_epi16(
+            constrain(load_8x2(row + offset, OD_FILT_BSTRIDE), yy, athresh),
+            constrain(load_8x2(row - offset, OD_FILT_BSTRIDE), yy, athresh)),
+        _mm256_add_epi16(
+            constrain(load_8x2(row + 2 * offset, OD_FILT_BSTRIDE), yy,
+                      athresh),
+            constrain(load_8x2(row - 2 * offset, OD_FILT_BSTRIDE), yy,
+                      athresh)));
+    store_8x2(y + i * ystride, ystride,
+              _mm256_add_epi16(yy, _mm256_mulhrs_epi16(sum, round3)));
+  }
+}
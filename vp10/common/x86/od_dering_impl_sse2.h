@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Deringing filter kernels shared by the SSE2 and SSSE3 builds. The including
+// file defines:
+//   ABS_EPI16(x)             absolute value of 8 signed 16-bit lanes.
+//   ROUND_SHIFT4(x)          (x + 8) >> 4, computed without 16-bit overflow.
+//   ROUND_SHIFT4_MUL3(x)     (3 * x + 8) >> 4, computed without overflow.
+//   FILTER_DERING_DIRECTION_4X4, FILTER_DERING_DIRECTION_8X8,
+//   FILTER_DERING_ORTHOGONAL_4X4, FILTER_DERING_ORTHOGONAL_8X8
+//                            the names of the functions to generate.
+// All arithmetic wraps on 16 bits exactly like the int16_t C code.
+
+#include "vp10/common/od_dering.h"
+
+// Sum of the neighbours along 'dir' that are within 'threshold' of 'xx',
+// weighted by the 3/2/2 taps.
+static INLINE __m128i direction_taps(const int16_t *in, __m128i xx,
+                                     __m128i thresh, int dir) {
+  __m128i sum[3];
+  int k;
+  for (k = 0; k < 3; k++) {
+    const int off = OD_DIRECTION_OFFSETS_TABLE[dir][k];
+    __m128i p0 = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(in + off)),
+                               xx);
+    __m128i p1 = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(in - off)),
+                               xx);
+    p0 = _mm_and_si128(p0, _mm_cmplt_epi16(ABS_EPI16(p0), thresh));
+    p1 = _mm_and_si128(p1, _mm_cmplt_epi16(ABS_EPI16(p1), thresh));
+    sum[k] = _mm_add_epi16(p0, p1);
+  }
+  // 3 * sum[0] + 2 * (sum[1] + sum[2])
+  return _mm_add_epi16(
+      _mm_add_epi16(sum[0], _mm_slli_epi16(sum[0], 1)),
+      _mm_slli_epi16(_mm_add_epi16(sum[1], sum[2]), 1));
+}
+
+// Same as direction_taps() for two rows of 4 pixels packed in one register.
+static INLINE __m128i direction_taps_4x2(const int16_t *in, __m128i xx,
+                                         __m128i thresh, int dir) {
+  __m128i sum[3];
+  int k;
+  for (k = 0; k < 3; k++) {
+    const int off = OD_DIRECTION_OFFSETS_TABLE[dir][k];
+    __m128i p0 = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(in + off)),
+        _mm_loadl_epi64((const __m128i *)(in + OD_FILT_BSTRIDE + off)));
+    __m128i p1 = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(in - off)),
+        _mm_loadl_epi64((const __m128i *)(in + OD_FILT_BSTRIDE - off)));
+    p0 = _mm_sub_epi16(p0, xx);
+    p1 = _mm_sub_epi16(p1, xx);
+    p0 = _mm_and_si128(p0, _mm_cmplt_epi16(ABS_EPI16(p0), thresh));
+    p1 = _mm_and_si128(p1, _mm_cmplt_epi16(ABS_EPI16(p1), thresh));
+    sum[k] = _mm_add_epi16(p0, p1);
+  }
+  return _mm_add_epi16(
+      _mm_add_epi16(sum[0], _mm_slli_epi16(sum[0], 1)),
+      _mm_slli_epi16(_mm_add_epi16(sum[1], sum[2]), 1));
+}
+
+// Sum of the neighbours at +/-1 and +/-2 'offset' that are within 'athresh'
+// of 'yy'.
+static INLINE __m128i orthogonal_taps(__m128i yy, __m128i athresh,
+                                      __m128i a, __m128i b, __m128i c,
+                                      __m128i d) {
+  __m128i sum;
+  a = _mm_sub_epi16(a, yy);
+  b = _mm_sub_epi16(b, yy);
+  c = _mm_sub_epi16(c, yy);
+  d = _mm_sub_epi16(d, yy);
+  sum = _mm_and_si128(a, _mm_cmplt_epi16(ABS_EPI16(a), athresh));
+  sum = _mm_add_epi16(
+      sum, _mm_and_si128(b, _mm_cmplt_epi16(ABS_EPI16(b), athresh)));
+  sum = _mm_add_epi16(
+      sum, _mm_and_si128(c, _mm_cmplt_epi16(ABS_EPI16(c), athresh)));
+  sum = _mm_add_epi16(
+      sum, _mm_and_si128(d, _mm_cmplt_epi16(ABS_EPI16(d), athresh)));
+  return sum;
+}
+
+static INLINE __m128i load_4x2(const int16_t *p, int stride) {
+  return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                            _mm_loadl_epi64((const __m128i *)(p + stride)));
+}
+
+static INLINE void store_4x2(int16_t *p, int stride, __m128i v) {
+  _mm_storel_epi64((__m128i *)p, v);
+  _mm_storel_epi64((__m128i *)(p + stride), _mm_srli_si128(v, 8));
+}
+
+void FILTER_DERING_DIRECTION_4X4(int16_t *y, int ystride, const int16_t *in,
+                                 int threshold, int dir) {
+  const __m128i thresh = _mm_set1_epi16(threshold);
+  int i;
+  for (i = 0; i < 4; i += 2) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m128i xx = load_4x2(row, OD_FILT_BSTRIDE);
+    const __m128i sum = direction_taps_4x2(row, xx, thresh, dir);
+    store_4x2(y + i * ystride, ystride, _mm_add_epi16(xx, ROUND_SHIFT4(sum)));
+  }
+}
+
+void FILTER_DERING_DIRECTION_8X8(int16_t *y, int ystride, const int16_t *in,
+                                 int threshold, int dir) {
+  const __m128i thresh = _mm_set1_epi16(threshold);
+  int i;
+  for (i = 0; i < 8; i++) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m128i xx = _mm_loadu_si128((const __m128i *)row);
+    const __m128i sum = direction_taps(row, xx, thresh, dir);
+    _mm_storeu_si128((__m128i *)(y + i * ystride),
+                     _mm_add_epi16(xx, ROUND_SHIFT4(sum)));
+  }
+}
+
+void FILTER_DERING_ORTHOGONAL_4X4(int16_t *y, int ystride, const int16_t *in,
+                                  const int16_t *x, int xstride,
+                                  int threshold, int dir) {
+  const int offset = (dir > 0 && dir < 4) ? OD_FILT_BSTRIDE : 1;
+  const __m128i thresh = _mm_set1_epi16(threshold);
+  const __m128i thresh3 = _mm_set1_epi16(threshold / 3);
+  int i;
+  for (i = 0; i < 4; i += 2) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m128i yy = load_4x2(row, OD_FILT_BSTRIDE);
+    const __m128i xx = load_4x2(x + i * xstride, xstride);
+    const __m128i athresh = _mm_min_epi16(
+        thresh, _mm_add_epi16(thresh3, ABS_EPI16(_mm_sub_epi16(yy, xx))));
+    const __m128i sum = orthogonal_taps(
+        yy, athresh, load_4x2(row + offset, OD_FILT_BSTRIDE),
+        load_4x2(row - offset, OD_FILT_BSTRIDE),
+        load_4x2(row + 2 * offset, OD_FILT_BSTRIDE),
+        load_4x2(row - 2 * offset, OD_FILT_BSTRIDE));
+    store_4x2(y + i * ystride, ystride,
+              _mm_add_epi16(yy, ROUND_SHIFT4_MUL3(sum)));
+  }
+}
+
+void FILTER_DERING_ORTHOGONAL_8X8(int16_t *y, int ystride, const int16_t *in,
+                                  const int16_t *x, int xstride,
+                                  int threshold, int dir) {
+  const int offset = (dir > 0 && dir < 4) ? OD_FILT_BSTRIDE : 1;
+  const __m128i thresh = _mm_set1_epi16(threshold);
+  const __m128i thresh3 = _mm_set1_epi16(threshold / 3);
+  int i;
+  for (i = 0; i < 8; i++) {
+    const int16_t *const row = in + i * OD_FILT_BSTRIDE;
+    const __m128i yy = _mm_loadu_si128((const __m128i *)row);
+    const __m128i xx = _mm_loadu_si128((const __m128i *)(x + i * xstride));
+    const __m128i athresh = _mm_min_epi16(
+        thresh, _mm_add_epi16(thresh3, ABS_EPI16(_mm_sub_epi16(yy, xx))));
+    const __m128i sum = orthogonal_taps(
+        yy, athresh, _mm_loadu_si128((const __m128i *)(row + offset)),
+        _mm_loadu_si128((const __m128i *)(row - offset)),
+        _mm_loadu_si128((const __m128i *)(row + 2 * offset)),
+        _mm_loadu_si128((const __m128i *)(row - 2 * offset)));
+    _mm_storeu_si128((__m128i *)(y + i * ystride),
+                     _mm_add_epi16(yy, ROUND_SHIFT4_MUL3(sum)));
+  }
+}
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp10_rtcd.h"
+#include "vpx_ports/mem.h"
+
+static INLINE __m128i abs_epi16_sse2(__m128i x) {
+  return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+// Writing x = 16 * q + r with 0 <= r < 16, (x + 8) >> 4 == q + ((r + 8) >> 4)
+// and (3 * x + 8) >> 4 == 3 * q + ((3 * r + 8) >> 4), none of which can
+// overflow 16 bits.
+static INLINE __m128i round_shift4_sse2(__m128i x) {
+  const __m128i q = _mm_srai_epi16(x, 4);
+  const __m128i r = _mm_and_si128(x, _mm_set1_epi16(15));
+  return _mm_add_epi16(
+      q, _mm_srli_epi16(_mm_add_epi16(r, _mm_set1_epi16(8)), 4));
+}
+
+static INLINE __m128i round_shift4_mul3_sse2(__m128i x) {
+  const __m128i q = _mm_srai_epi16(x, 4);
+  const __m128i r = _mm_and_si128(x, _mm_set1_epi16(15));
+  const __m128i q3 = _mm_add_epi16(q, _mm_slli_epi16(q, 1));
+  const __m128i r3 = _mm_add_epi16(r, _mm_slli_epi16(r, 1));
+  return _mm_add_epi16(
+      q3, _mm_srli_epi16(_mm_add_epi16(r3, _mm_set1_epi16(8)), 4));
+}
+
+#define ABS_EPI16 abs_epi16_sse2
+#define ROUND_SHIFT4 round_shift4_sse2
+#define ROUND_SHIFT4_MUL3 round_shift4_mul3_sse2
+#define FILTER_DERING_DIRECTION_4X4 od_filter_dering_direction_4x4_sse2
+#define FILTER_DERING_DIRECTION_8X8 od_filter_dering_direction_8x8_sse2
+#define FILTER_DERING_ORTHOGONAL_4X4 od_filter_dering_orthogonal_4x4_sse2
+#define FILTER_DERING_ORTHOGONAL_8X8 od_filter_dering_orthogonal_8x8_sse2
+#include "vp10/common/x86/od_dering_impl_sse2.h"
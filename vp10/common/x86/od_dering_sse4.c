@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./vp10_rtcd.h"
+#include "vpx_ports/mem.h"
+
+// Adds the 8 lanes of 'v' to the 16-lane line sum (lo, hi) starting at lane
+// 'n'.
+#define ACCUMULATE_SHIFTED(lo, hi, v, n)                            \
+  do {                                                              \
+    lo = _mm_add_epi16(lo, _mm_slli_si128(v, 2 * (n)));             \
+    hi = _mm_add_epi16(hi, _mm_srli_si128(v, 16 - 2 * (n)));        \
+  } while (0)
+
+static INLINE __m128i reverse_epi16(__m128i v) {
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+// Sum of the squares of the 8 lanes of 'v' times the 32-bit weights 'w0'
+// (lanes 0-3) and 'w1' (lanes 4-7).
+static INLINE __m128i weighted_square_sum(__m128i v, __m128i w0, __m128i w1) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i v0 = _mm_unpacklo_epi16(v, zero);
+  const __m128i v1 = _mm_unpackhi_epi16(v, zero);
+  return _mm_add_epi32(_mm_mullo_epi32(_mm_madd_epi16(v0, v0), w0),
+                       _mm_mullo_epi32(_mm_madd_epi16(v1, v1), w1));
+}
+
+static INLINE int32_t hsum_epi32(__m128i v) {
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Sum the pixel pairs of a row: returns (r[0] + r[1], ..., r[6] + r[7]) in
+// lanes 0-3 and zero in lanes 4-7, or the same in reverse order.
+static INLINE __m128i pair_sums(__m128i row, int reverse) {
+  __m128i sums = _mm_madd_epi16(row, _mm_set1_epi16(1));
+  if (reverse) sums = _mm_shuffle_epi32(sums, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_packs_epi32(sums, _mm_setzero_si128());
+}
+
+/* See od_dir_find8_c() for the description of the algorithm. The partial
+   sums along each direction are built by shifting whole rows, and the costs
+   use the same 840/n weights. */
+int od_dir_find8_sse4_1(const int16_t *img, int stride, int32_t *var,
+                        int coeff_shift) {
+  int i;
+  int32_t cost[8];
+  int32_t best_cost = 0;
+  int best_dir = 0;
+  __m128i lines[8];
+  __m128i pairs[8];
+  __m128i pairs_rev[8];
+  __m128i p0_lo, p0_hi, p4_lo, p4_hi;
+  __m128i p1_lo, p1_hi, p3_lo, p3_hi, p5_lo, p5_hi, p7_lo, p7_hi;
+  __m128i p6;
+  __m128i row_sums[2];
+  const __m128i shift = _mm_cvtsi32_si128(coeff_shift);
+  const __m128i offset = _mm_set1_epi16(128);
+  const __m128i zero = _mm_setzero_si128();
+  /* 840/n weights of the diagonal (0, 4) and the odd (1, 3, 5, 7) line
+     sums, in lane order. */
+  const __m128i w_diag0 = _mm_setr_epi32(840, 420, 280, 210);
+  const __m128i w_diag1 = _mm_setr_epi32(168, 140, 120, 105);
+  const __m128i w_diag2 = _mm_setr_epi32(120, 140, 168, 210);
+  const __m128i w_diag3 = _mm_setr_epi32(280, 420, 840, 0);
+  const __m128i w_odd0 = _mm_setr_epi32(420, 210, 140, 105);
+  const __m128i w_odd1 = _mm_set1_epi32(105);
+  const __m128i w_odd2 = _mm_setr_epi32(140, 210, 420, 0);
+  const __m128i w_105 = _mm_set1_epi32(105);
+
+  for (i = 0; i < 8; i++) {
+    lines[i] = _mm_loadu_si128((const __m128i *)&img[i * stride]);
+    /* We subtract 128 here to reduce the maximum range of the squared
+       partial sums. */
+    lines[i] = _mm_sub_epi16(_mm_sra_epi16(lines[i], shift), offset);
+    pairs[i] = pair_sums(lines[i], 0);
+    pairs_rev[i] = pair_sums(lines[i], 1);
+  }
+
+  /* Directions 0 and 4: each row is offset by one more pixel. */
+  p0_lo = p0_hi = p4_lo = p4_hi = zero;
+  /* Directions 1 and 3: pairs of pixels, each row offset by one more. */
+  p1_lo = p1_hi = p3_lo = p3_hi = zero;
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[0], 0);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[1], 1);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[2], 2);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[3], 3);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[4], 4);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[5], 5);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[6], 6);
+  ACCUMULATE_SHIFTED(p0_lo, p0_hi, lines[7], 7);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[0]), 0);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[1]), 1);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[2]), 2);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[3]), 3);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[4]), 4);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[5]), 5);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[6]), 6);
+  ACCUMULATE_SHIFTED(p4_lo, p4_hi, reverse_epi16(lines[7]), 7);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[0], 0);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[1], 1);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[2], 2);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[3], 3);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[4], 4);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[5], 5);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[6], 6);
+  ACCUMULATE_SHIFTED(p1_lo, p1_hi, pairs[7], 7);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[0], 0);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[1], 1);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[2], 2);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[3], 3);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[4], 4);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[5], 5);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[6], 6);
+  ACCUMULATE_SHIFTED(p3_lo, p3_hi, pairs_rev[7], 7);
+
+  /* Directions 5 and 7: pairs of rows share the same offset. */
+  p5_lo = p5_hi = p7_lo = p7_hi = zero;
+  {
+    const __m128i rows01 = _mm_add_epi16(lines[0], lines[1]);
+    const __m128i rows23 = _mm_add_epi16(lines[2], lines[3]);
+    const __m128i rows45 = _mm_add_epi16(lines[4], lines[5]);
+    const __m128i rows67 = _mm_add_epi16(lines[6], lines[7]);
+    ACCUMULATE_SHIFTED(p5_lo, p5_hi, rows01, 3);
+    ACCUMULATE_SHIFTED(p5_lo, p5_hi, rows23, 2);
+    ACCUMULATE_SHIFTED(p5_lo, p5_hi, rows45, 1);
+    ACCUMULATE_SHIFTED(p5_lo, p5_hi, rows67, 0);
+    ACCUMULATE_SHIFTED(p7_lo, p7_hi, rows01, 0);
+    ACCUMULATE_SHIFTED(p7_lo, p7_hi, rows23, 1);
+    ACCUMULATE_SHIFTED(p7_lo, p7_hi, rows45, 2);
+    ACCUMULATE_SHIFTED(p7_lo, p7_hi, rows67, 3);
+    /* Direction 6: column sums. */
+    p6 = _mm_add_epi16(_mm_add_epi16(rows01, rows23),
+                       _mm_add_epi16(rows45, rows67));
+  }
+
+  /* Direction 2: row sums, as 32-bit lanes. */
+  for (i = 0; i < 2; i++) {
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i s01 = _mm_hadd_epi32(_mm_madd_epi16(lines[4 * i + 0], one),
+                                       _mm_madd_epi16(lines[4 * i + 1], one));
+    const __m128i s23 = _mm_hadd_epi32(_mm_madd_epi16(lines[4 * i + 2], one),
+                                       _mm_madd_epi16(lines[4 * i + 3], one));
+    row_sums[i] = _mm_hadd_epi32(s01, s23);
+  }
+
+  cost[0] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p0_lo, w_diag0, w_diag1),
+      weighted_square_sum(p0_hi, w_diag2, w_diag3)));
+  cost[4] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p4_lo, w_diag0, w_diag1),
+      weighted_square_sum(p4_hi, w_diag2, w_diag3)));
+  cost[1] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p1_lo, w_odd0, w_odd1),
+      weighted_square_sum(p1_hi, w_odd2, zero)));
+  cost[3] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p3_lo, w_odd0, w_odd1),
+      weighted_square_sum(p3_hi, w_odd2, zero)));
+  cost[5] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p5_lo, w_odd0, w_odd1),
+      weighted_square_sum(p5_hi, w_odd2, zero)));
+  cost[7] = hsum_epi32(_mm_add_epi32(
+      weighted_square_sum(p7_lo, w_odd0, w_odd1),
+      weighted_square_sum(p7_hi, w_odd2, zero)));
+  cost[6] = hsum_epi32(weighted_square_sum(p6, w_105, w_105));
+  cost[2] = hsum_epi32(_mm_mullo_epi32(
+      _mm_add_epi32(_mm_mullo_epi32(row_sums[0], row_sums[0]),
+                    _mm_mullo_epi32(row_sums[1], row_sums[1])),
+      w_105));
+
+  for (i = 0; i < 8; i++) {
+    if (cost[i] > best_cost) {
+      best_cost = cost[i];
+      best_dir = i;
+    }
+  }
+  /* Difference between the optimal variance and the variance along the
+     orthogonal direction. Again, the sum(x^2) terms cancel out. */
+  *var = best_cost - cost[(best_dir + 4) & 7];
+  /* We'd normally divide by 840, but dividing by 1024 is close enough
+     for what we're going to do with this. */
+  *var >>= 10;
+  return best_dir;
+}
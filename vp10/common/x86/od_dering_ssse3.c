@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <tmmintrin.h>  // SSSE3
+
+#include "./vp10_rtcd.h"
+#include "vpx_ports/mem.h"
+
+// _mm_mulhrs_epi16(x, k << 11) == (k * x * 2048 + 16384) >> 15
+//                              == (k * x + 8) >> 4, using a 32-bit product.
+static INLINE __m128i round_shift4_ssse3(__m128i x) {
+  return _mm_mulhrs_epi16(x, _mm_set1_epi16(1 << 11));
+}
+
+static INLINE __m128i round_shift4_mul3_ssse3(__m128i x) {
+  return _mm_mulhrs_epi16(x, _mm_set1_epi16(3 << 11));
+}
+
+#define ABS_EPI16 _mm_abs_epi16
+#define ROUND_SHIFT4 round_shift4_ssse3
+#define ROUND_SHIFT4_MUL3 round_shift4_mul3_ssse3
+#define FILTER_DERING_DIRECTION_4X4 od_filter_dering_direction_4x4_ssse3
+#define FILTER_DERING_DIRECTION_8X8 od_filter_dering_direction_8x8_ssse3
+#define FILTER_DERING_ORTHOGONAL_4X4 od_filter_dering_orthogonal_4x4_ssse3
+#define FILTER_DERING_ORTHOGONAL_8X8 od_filter_dering_orthogonal_8x8_ssse3
+#include "vp10/common/x86/od_dering_impl_sse2.h"
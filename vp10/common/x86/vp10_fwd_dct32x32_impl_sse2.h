@@ -53,7 +53,23 @@ void vp10_fdct32x32_rd_rows_c(const int16_t *intermediate, tran_low_t *out) {
 #define SUB_EPI16 _mm_sub_epi16
 #endif  // DCT_HIGH_BIT_DEPTH
 
-void FDCT32x32_2D(const int16_t *input, tran_low_t *output_org, int stride) {
+// When FDCT_QUANTIZER names a quantizer state type, the transform takes one
+// as an extra argument and quantizes each register of final coefficients with
+// quantize_and_store_output() as it is stored, see
+// vp10/encoder/x86/dct_sse2.c.
+#ifdef FDCT_QUANTIZER
+#define STORE_OUTPUT(poutput, dst_ptr) \
+  quantize_and_store_output(quantizer, poutput, dst_ptr)
+#else
+#define STORE_OUTPUT(poutput, dst_ptr) storeu_output(poutput, dst_ptr)
+#endif
+
+void FDCT32x32_2D(const int16_t *input, tran_low_t *output_org, int stride
+#ifdef FDCT_QUANTIZER
+                  ,
+                  FDCT_QUANTIZER *quantizer
+#endif
+                  ) {
   // Calculate pre-multiplied strides
   const int str1 = stride;
   const int str2 = 2 * stride;
@@ -3178,14 +3194,14 @@ void FDCT32x32_2D(const int16_t *input, tran_low_t *output_org, int stride) {
             // Process next 8x8
             output0 += 8;
           } else {
-            storeu_output(&tr2_0, (output1 + 0 * 32));
-            storeu_output(&tr2_1, (output1 + 1 * 32));
-            storeu_output(&tr2_2, (output1 + 2 * 32));
-            storeu_output(&tr2_3, (output1 + 3 * 32));
-            storeu_output(&tr2_4, (output1 + 4 * 32));
-            storeu_output(&tr2_5, (output1 + 5 * 32));
-            storeu_output(&tr2_6, (output1 + 6 * 32));
-            storeu_output(&tr2_7, (output1 + 7 * 32));
+            STORE_OUTPUT(&tr2_0, (output1 + 0 * 32));
+            STORE_OUTPUT(&tr2_1, (output1 + 1 * 32));
+            STORE_OUTPUT(&tr2_2, (output1 + 2 * 32));
+            STORE_OUTPUT(&tr2_3, (output1 + 3 * 32));
+            STORE_OUTPUT(&tr2_4, (output1 + 4 * 32));
+            STORE_OUTPUT(&tr2_5, (output1 + 5 * 32));
+            STORE_OUTPUT(&tr2_6, (output1 + 6 * 32));
+            STORE_OUTPUT(&tr2_7, (output1 + 7 * 32));
             // Process next 8x8
             output1 += 8;
           }
@@ -3199,3 +3215,4 @@ void FDCT32x32_2D(const int16_t *input, tran_low_t *output_org, int stride) {
 #undef SUB_EPI16
 #undef HIGH_FDCT32x32_2D_C
 #undef HIGH_FDCT32x32_2D_ROWS_C
+#undef STORE_OUTPUT
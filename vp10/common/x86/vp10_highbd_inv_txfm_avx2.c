@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_ports/mem.h"
+
+// A 4x4 block does not fill a vector, so only the 8x8 and 16x16 transforms
+// have AVX2 versions.
+#define VEC_LANES 8
+
+typedef __m256i vec_t;
+
+// The products of the even and of the odd lanes.
+typedef struct {
+  __m256i even, odd;
+} prod_t;
+
+static INLINE vec_t vec_zero(void) { return _mm256_setzero_si256(); }
+
+static INLINE vec_t vec_add(vec_t a, vec_t b) {
+  return _mm256_add_epi32(a, b);
+}
+
+static INLINE vec_t vec_sub(vec_t a, vec_t b) {
+  return _mm256_sub_epi32(a, b);
+}
+
+static INLINE prod_t prod_mul(vec_t a, int c) {
+  const __m256i k = _mm256_set1_epi32(c);
+  prod_t p;
+  p.even = _mm256_mul_epi32(a, k);
+  p.odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), k);
+  return p;
+}
+
+static INLINE prod_t prod_add(prod_t a, prod_t b) {
+  prod_t p;
+  p.even = _mm256_add_epi64(a.even, b.even);
+  p.odd = _mm256_add_epi64(a.odd, b.odd);
+  return p;
+}
+
+static INLINE prod_t prod_sub(prod_t a, prod_t b) {
+  prod_t p;
+  p.even = _mm256_sub_epi64(a.even, b.even);
+  p.odd = _mm256_sub_epi64(a.odd, b.odd);
+  return p;
+}
+
+static INLINE prod_t prod_neg(prod_t a) {
+  prod_t p;
+  p.even = _mm256_sub_epi64(_mm256_setzero_si256(), a.even);
+  p.odd = _mm256_sub_epi64(_mm256_setzero_si256(), a.odd);
+  return p;
+}
+
+static INLINE vec_t prod_round(prod_t a) {
+  const __m256i rounding = _mm256_set1_epi64x(1 << (DCT_CONST_BITS - 1));
+  // Only the low 32 bits of each result are kept, so logical shifts will do.
+  const __m256i even =
+      _mm256_srli_epi64(_mm256_add_epi64(a.even, rounding), DCT_CONST_BITS);
+  const __m256i odd = _mm256_slli_epi64(_mm256_add_epi64(a.odd, rounding),
+                                        32 - DCT_CONST_BITS);
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+static INLINE vec_t vec_load(const tran_low_t *p) {
+  return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static INLINE void transpose(vec_t *v) {
+  const __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+static INLINE void recon_store(uint16_t *dest, vec_t v, int shift, int bd) {
+  const __m256i d =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)dest));
+  __m256i x = _mm256_srai_epi32(
+      _mm256_add_epi32(v, _mm256_set1_epi32(1 << (shift - 1))), shift);
+  x = _mm256_add_epi32(x, d);
+  x = _mm256_min_epi32(_mm256_max_epi32(x, _mm256_setzero_si256()),
+                       _mm256_set1_epi32((1 << bd) - 1));
+  _mm_storeu_si128((__m128i *)dest,
+                   _mm_packus_epi32(_mm256_castsi256_si128(x),
+                                    _mm256_extracti128_si256(x, 1)));
+}
+
+#define HIGHBD_IHT8X8 vp10_highbd_iht8x8_64_add_avx2
+#define HIGHBD_IHT16X16 vp10_highbd_iht16x16_256_add_avx2
+#include "vp10/common/x86/vp10_highbd_inv_txfm_impl.h"
@@ -0,0 +1,456 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// High bitdepth inverse hybrid transforms shared by the SSE4.1 and AVX2
+// builds. Each vector holds VEC_LANES 32-bit coefficients, one per row (row
+// pass) or column (column pass). The including file defines VEC_LANES, the
+// types vec_t and prod_t (VEC_LANES 64-bit products) and:
+//   vec_t vec_zero(void)
+//   vec_t vec_add(vec_t a, vec_t b), vec_sub(vec_t a, vec_t b)
+//                            wrapping 32-bit lane arithmetic.
+//   prod_t prod_mul(vec_t a, int c)
+//                            a * c with 64-bit results, for 0 < c < 2^15.
+//   prod_t prod_add(prod_t a, prod_t b), prod_sub(prod_t a, prod_t b),
+//   prod_t prod_neg(prod_t a)
+//                            64-bit lane arithmetic.
+//   vec_t prod_round(prod_t a)
+//                            (a + 2^13) >> 14, truncated to 32 bits.
+//   vec_t vec_load(const tran_low_t *p)
+//   void transpose(vec_t *v) transposes the VEC_LANES x VEC_LANES block 'v'.
+//   void recon_store(uint16_t *dest, vec_t v, int shift, int bd)
+//                            adds the rounded residue 'v' >> 'shift' to
+//                            VEC_LANES pixels and clamps them to 'bd' bits.
+//   HIGHBD_IHT4X4, HIGHBD_IHT8X8, HIGHBD_IHT16X16
+//                            the names of the functions to generate; a name
+//                            left undefined skips that size.
+// Every step matches the order of operations of vpx_highbd_idct*_c() and
+// vpx_highbd_iadst*_c(), so the results are bit-exact with the C code for
+// all inputs, including the ones that wrap.
+
+
+// Returns round(a * c0 - b * c1) in *x and round(a * c1 + b * c0) in *y.
+static INLINE void rotate(vec_t a, vec_t b, int c0, int c1, vec_t *x,
+                          vec_t *y) {
+  *x = prod_round(prod_sub(prod_mul(a, c0), prod_mul(b, c1)));
+  *y = prod_round(prod_add(prod_mul(a, c1), prod_mul(b, c0)));
+}
+
+// Returns round(a * c).
+static INLINE vec_t mul_round(vec_t a, int c) {
+  return prod_round(prod_mul(a, c));
+}
+
+static INLINE vec_t vec_neg(vec_t a) { return vec_sub(vec_zero(), a); }
+
+static void idct4(vec_t *io) {
+  vec_t step[4];
+  step[0] = mul_round(vec_add(io[0], io[2]), (int)cospi_16_64);
+  step[1] = mul_round(vec_sub(io[0], io[2]), (int)cospi_16_64);
+  rotate(io[1], io[3], (int)cospi_24_64, (int)cospi_8_64, &step[2], &step[3]);
+
+  io[0] = vec_add(step[0], step[3]);
+  io[1] = vec_add(step[1], step[2]);
+  io[2] = vec_sub(step[1], step[2]);
+  io[3] = vec_sub(step[0], step[3]);
+}
+
+static void iadst4(vec_t *io) {
+  const vec_t x0 = io[0], x1 = io[1], x2 = io[2], x3 = io[3];
+  const prod_t s0 = prod_add(prod_add(prod_mul(x0, (int)sinpi_1_9),
+                                      prod_mul(x2, (int)sinpi_4_9)),
+                             prod_mul(x3, (int)sinpi_2_9));
+  const prod_t s1 = prod_sub(prod_sub(prod_mul(x0, (int)sinpi_2_9),
+                                      prod_mul(x2, (int)sinpi_1_9)),
+                             prod_mul(x3, (int)sinpi_4_9));
+  const prod_t s2 = prod_mul(vec_add(vec_sub(x0, x2), x3), (int)sinpi_3_9);
+  const prod_t s3 = prod_mul(x1, (int)sinpi_3_9);
+
+  io[0] = prod_round(prod_add(s0, s3));
+  io[1] = prod_round(prod_add(s1, s3));
+  io[2] = prod_round(s2);
+  io[3] = prod_round(prod_sub(prod_add(s0, s1), s3));
+}
+
+static void idct8(vec_t *io) {
+  vec_t step1[8], step2[8];
+  step1[0] = io[0];
+  step1[1] = io[2];
+  step1[2] = io[4];
+  step1[3] = io[6];
+  rotate(io[1], io[7], (int)cospi_28_64, (int)cospi_4_64, &step1[4],
+         &step1[7]);
+  rotate(io[5], io[3], (int)cospi_12_64, (int)cospi_20_64, &step1[5],
+         &step1[6]);
+
+  // stage 2 & stage 3 - even half
+  idct4(step1);
+
+  // stage 2 - odd half
+  step2[4] = vec_add(step1[4], step1[5]);
+  step2[5] = vec_sub(step1[4], step1[5]);
+  step2[6] = vec_sub(step1[7], step1[6]);
+  step2[7] = vec_add(step1[6], step1[7]);
+
+  // stage 3 - odd half
+  step1[4] = step2[4];
+  step1[5] = mul_round(vec_sub(step2[6], step2[5]), (int)cospi_16_64);
+  step1[6] = mul_round(vec_add(step2[5], step2[6]), (int)cospi_16_64);
+  step1[7] = step2[7];
+
+  // stage 4
+  io[0] = vec_add(step1[0], step1[7]);
+  io[1] = vec_add(step1[1], step1[6]);
+  io[2] = vec_add(step1[2], step1[5]);
+  io[3] = vec_add(step1[3], step1[4]);
+  io[4] = vec_sub(step1[3], step1[4]);
+  io[5] = vec_sub(step1[2], step1[5]);
+  io[6] = vec_sub(step1[1], step1[6]);
+  io[7] = vec_sub(step1[0], step1[7]);
+}
+
+static void iadst8(vec_t *io) {
+  vec_t x0 = io[7], x1 = io[0], x2 = io[5], x3 = io[2];
+  vec_t x4 = io[3], x5 = io[4], x6 = io[1], x7 = io[6];
+  prod_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+  // stage 1
+  s0 = prod_add(prod_mul(x0, (int)cospi_2_64), prod_mul(x1, (int)cospi_30_64));
+  s1 = prod_sub(prod_mul(x0, (int)cospi_30_64), prod_mul(x1, (int)cospi_2_64));
+  s2 = prod_add(prod_mul(x2, (int)cospi_10_64),
+                prod_mul(x3, (int)cospi_22_64));
+  s3 = prod_sub(prod_mul(x2, (int)cospi_22_64),
+                prod_mul(x3, (int)cospi_10_64));
+  s4 = prod_add(prod_mul(x4, (int)cospi_18_64),
+                prod_mul(x5, (int)cospi_14_64));
+  s5 = prod_sub(prod_mul(x4, (int)cospi_14_64),
+                prod_mul(x5, (int)cospi_18_64));
+  s6 = prod_add(prod_mul(x6, (int)cospi_26_64), prod_mul(x7, (int)cospi_6_64));
+  s7 = prod_sub(prod_mul(x6, (int)cospi_6_64), prod_mul(x7, (int)cospi_26_64));
+
+  x0 = prod_round(prod_add(s0, s4));
+  x1 = prod_round(prod_add(s1, s5));
+  x2 = prod_round(prod_add(s2, s6));
+  x3 = prod_round(prod_add(s3, s7));
+  x4 = prod_round(prod_sub(s0, s4));
+  x5 = prod_round(prod_sub(s1, s5));
+  x6 = prod_round(prod_sub(s2, s6));
+  x7 = prod_round(prod_sub(s3, s7));
+
+  // stage 2
+  s4 = prod_add(prod_mul(x4, (int)cospi_8_64), prod_mul(x5, (int)cospi_24_64));
+  s5 = prod_sub(prod_mul(x4, (int)cospi_24_64), prod_mul(x5, (int)cospi_8_64));
+  s6 = prod_sub(prod_mul(x7, (int)cospi_8_64), prod_mul(x6, (int)cospi_24_64));
+  s7 = prod_add(prod_mul(x6, (int)cospi_8_64), prod_mul(x7, (int)cospi_24_64));
+
+  {
+    const vec_t t0 = x0, t1 = x1;
+    x0 = vec_add(t0, x2);
+    x1 = vec_add(t1, x3);
+    x2 = vec_sub(t0, x2);
+    x3 = vec_sub(t1, x3);
+  }
+  x4 = prod_round(prod_add(s4, s6));
+  x5 = prod_round(prod_add(s5, s7));
+  x6 = prod_round(prod_sub(s4, s6));
+  x7 = prod_round(prod_sub(s5, s7));
+
+  // stage 3
+  io[0] = x0;
+  io[1] = vec_neg(x4);
+  io[2] = mul_round(vec_add(x6, x7), (int)cospi_16_64);
+  io[3] = vec_neg(mul_round(vec_add(x2, x3), (int)cospi_16_64));
+  io[4] = mul_round(vec_sub(x2, x3), (int)cospi_16_64);
+  io[5] = vec_neg(mul_round(vec_sub(x6, x7), (int)cospi_16_64));
+  io[6] = x5;
+  io[7] = vec_neg(x1);
+}
+
+static void idct16(vec_t *io) {
+  vec_t step1[16], step2[16];
+
+  // stage 1
+  step1[0] = io[0];
+  step1[1] = io[8];
+  step1[2] = io[4];
+  step1[3] = io[12];
+  step1[4] = io[2];
+  step1[5] = io[10];
+  step1[6] = io[6];
+  step1[7] = io[14];
+
+  // stage 2
+  rotate(io[1], io[15], (int)cospi_30_64, (int)cospi_2_64, &step2[8],
+         &step2[15]);
+  rotate(io[9], io[7], (int)cospi_14_64, (int)cospi_18_64, &step2[9],
+         &step2[14]);
+  rotate(io[5], io[11], (int)cospi_22_64, (int)cospi_10_64, &step2[10],
+         &step2[13]);
+  rotate(io[13], io[3], (int)cospi_6_64, (int)cospi_26_64, &step2[11],
+         &step2[12]);
+
+  // stage 3
+  rotate(step1[4], step1[7], (int)cospi_28_64, (int)cospi_4_64, &step1[4],
+         &step1[7]);
+  rotate(step1[5], step1[6], (int)cospi_12_64, (int)cospi_20_64, &step1[5],
+         &step1[6]);
+  step1[8] = vec_add(step2[8], step2[9]);
+  step1[9] = vec_sub(step2[8], step2[9]);
+  step1[10] = vec_sub(step2[11], step2[10]);
+  step1[11] = vec_add(step2[10], step2[11]);
+  step1[12] = vec_add(step2[12], step2[13]);
+  step1[13] = vec_sub(step2[12], step2[13]);
+  step1[14] = vec_sub(step2[15], step2[14]);
+  step1[15] = vec_add(step2[14], step2[15]);
+
+  // stage 4
+  step2[0] = mul_round(vec_add(step1[0], step1[1]), (int)cospi_16_64);
+  step2[1] = mul_round(vec_sub(step1[0], step1[1]), (int)cospi_16_64);
+  rotate(step1[2], step1[3], (int)cospi_24_64, (int)cospi_8_64, &step2[2],
+         &step2[3]);
+  step2[4] = vec_add(step1[4], step1[5]);
+  step2[5] = vec_sub(step1[4], step1[5]);
+  step2[6] = vec_sub(step1[7], step1[6]);
+  step2[7] = vec_add(step1[6], step1[7]);
+
+  step2[8] = step1[8];
+  step2[15] = step1[15];
+  // The C code negates the 32-bit coefficient before multiplying it.
+  step2[9] = prod_round(prod_add(prod_mul(vec_neg(step1[9]), (int)cospi_8_64),
+                                 prod_mul(step1[14], (int)cospi_24_64)));
+  step2[14] = prod_round(prod_add(prod_mul(step1[9], (int)cospi_24_64),
+                                  prod_mul(step1[14], (int)cospi_8_64)));
+  rotate(vec_neg(step1[10]), step1[13], (int)cospi_24_64, (int)cospi_8_64,
+         &step2[10], &step2[13]);
+  step2[11] = step1[11];
+  step2[12] = step1[12];
+
+  // stage 5
+  step1[0] = vec_add(step2[0], step2[3]);
+  step1[1] = vec_add(step2[1], step2[2]);
+  step1[2] = vec_sub(step2[1], step2[2]);
+  step1[3] = vec_sub(step2[0], step2[3]);
+  step1[4] = step2[4];
+  step1[5] = mul_round(vec_sub(step2[6], step2[5]), (int)cospi_16_64);
+  step1[6] = mul_round(vec_add(step2[5], step2[6]), (int)cospi_16_64);
+  step1[7] = step2[7];
+
+  step1[8] = vec_add(step2[8], step2[11]);
+  step1[9] = vec_add(step2[9], step2[10]);
+  step1[10] = vec_sub(step2[9], step2[10]);
+  step1[11] = vec_sub(step2[8], step2[11]);
+  step1[12] = vec_sub(step2[15], step2[12]);
+  step1[13] = vec_sub(step2[14], step2[13]);
+  step1[14] = vec_add(step2[13], step2[14]);
+  step1[15] = vec_add(step2[12], step2[15]);
+
+  // stage 6
+  step2[0] = vec_add(step1[0], step1[7]);
+  step2[1] = vec_add(step1[1], step1[6]);
+  step2[2] = vec_add(step1[2], step1[5]);
+  step2[3] = vec_add(step1[3], step1[4]);
+  step2[4] = vec_sub(step1[3], step1[4]);
+  step2[5] = vec_sub(step1[2], step1[5]);
+  step2[6] = vec_sub(step1[1], step1[6]);
+  step2[7] = vec_sub(step1[0], step1[7]);
+  step2[8] = step1[8];
+  step2[9] = step1[9];
+  step2[10] = mul_round(vec_sub(step1[13], step1[10]), (int)cospi_16_64);
+  step2[13] = mul_round(vec_add(step1[10], step1[13]), (int)cospi_16_64);
+  step2[11] = mul_round(vec_sub(step1[12], step1[11]), (int)cospi_16_64);
+  step2[12] = mul_round(vec_add(step1[11], step1[12]), (int)cospi_16_64);
+  step2[14] = step1[14];
+  step2[15] = step1[15];
+
+  // stage 7
+  io[0] = vec_add(step2[0], step2[15]);
+  io[1] = vec_add(step2[1], step2[14]);
+  io[2] = vec_add(step2[2], step2[13]);
+  io[3] = vec_add(step2[3], step2[12]);
+  io[4] = vec_add(step2[4], step2[11]);
+  io[5] = vec_add(step2[5], step2[10]);
+  io[6] = vec_add(step2[6], step2[9]);
+  io[7] = vec_add(step2[7], step2[8]);
+  io[8] = vec_sub(step2[7], step2[8]);
+  io[9] = vec_sub(step2[6], step2[9]);
+  io[10] = vec_sub(step2[5], step2[10]);
+  io[11] = vec_sub(step2[4], step2[11]);
+  io[12] = vec_sub(step2[3], step2[12]);
+  io[13] = vec_sub(step2[2], step2[13]);
+  io[14] = vec_sub(step2[1], step2[14]);
+  io[15] = vec_sub(step2[0], step2[15]);
+}
+
+// Returns a * c0 + b * c1 and a * c1 - b * c0.
+static INLINE void prod_pair(vec_t a, vec_t b, int c0, int c1, prod_t *x,
+                             prod_t *y) {
+  *x = prod_add(prod_mul(a, c0), prod_mul(b, c1));
+  *y = prod_sub(prod_mul(a, c1), prod_mul(b, c0));
+}
+
+static void iadst16(vec_t *io) {
+  vec_t x[16];
+  prod_t s[16];
+  int i;
+
+  // stage 1
+  prod_pair(io[15], io[0], (int)cospi_1_64, (int)cospi_31_64, &s[0], &s[1]);
+  prod_pair(io[13], io[2], (int)cospi_5_64, (int)cospi_27_64, &s[2], &s[3]);
+  prod_pair(io[11], io[4], (int)cospi_9_64, (int)cospi_23_64, &s[4], &s[5]);
+  prod_pair(io[9], io[6], (int)cospi_13_64, (int)cospi_19_64, &s[6], &s[7]);
+  prod_pair(io[7], io[8], (int)cospi_17_64, (int)cospi_15_64, &s[8], &s[9]);
+  prod_pair(io[5], io[10], (int)cospi_21_64, (int)cospi_11_64, &s[10],
+            &s[11]);
+  prod_pair(io[3], io[12], (int)cospi_25_64, (int)cospi_7_64, &s[12], &s[13]);
+  prod_pair(io[1], io[14], (int)cospi_29_64, (int)cospi_3_64, &s[14], &s[15]);
+  for (i = 0; i < 8; ++i) {
+    x[i] = prod_round(prod_add(s[i], s[i + 8]));
+    x[i + 8] = prod_round(prod_sub(s[i], s[i + 8]));
+  }
+
+  // stage 2
+  prod_pair(x[8], x[9], (int)cospi_4_64, (int)cospi_28_64, &s[8], &s[9]);
+  prod_pair(x[10], x[11], (int)cospi_20_64, (int)cospi_12_64, &s[10], &s[11]);
+  // The C code negates the 32-bit coefficient before multiplying it.
+  s[12] = prod_add(prod_mul(vec_neg(x[12]), (int)cospi_28_64),
+                   prod_mul(x[13], (int)cospi_4_64));
+  s[13] = prod_add(prod_mul(x[12], (int)cospi_4_64),
+                   prod_mul(x[13], (int)cospi_28_64));
+  s[14] = prod_add(prod_mul(vec_neg(x[14]), (int)cospi_12_64),
+                   prod_mul(x[15], (int)cospi_20_64));
+  s[15] = prod_add(prod_mul(x[14], (int)cospi_20_64),
+                   prod_mul(x[15], (int)cospi_12_64));
+  for (i = 0; i < 4; ++i) {
+    const vec_t t = x[i];
+    x[i] = vec_add(t, x[i + 4]);
+    x[i + 4] = vec_sub(t, x[i + 4]);
+    x[i + 8] = prod_round(prod_add(s[i + 8], s[i + 12]));
+    x[i + 12] = prod_round(prod_sub(s[i + 8], s[i + 12]));
+  }
+
+  // stage 3
+  prod_pair(x[4], x[5], (int)cospi_8_64, (int)cospi_24_64, &s[4], &s[5]);
+  s[6] = prod_add(prod_mul(vec_neg(x[6]), (int)cospi_24_64),
+                  prod_mul(x[7], (int)cospi_8_64));
+  s[7] = prod_add(prod_mul(x[6], (int)cospi_8_64),
+                  prod_mul(x[7], (int)cospi_24_64));
+  prod_pair(x[12], x[13], (int)cospi_8_64, (int)cospi_24_64, &s[12], &s[13]);
+  s[14] = prod_add(prod_mul(vec_neg(x[14]), (int)cospi_24_64),
+                   prod_mul(x[15], (int)cospi_8_64));
+  s[15] = prod_add(prod_mul(x[14], (int)cospi_8_64),
+                   prod_mul(x[15], (int)cospi_24_64));
+  for (i = 0; i < 16; i += 8) {
+    const vec_t t0 = x[i], t1 = x[i + 1];
+    x[i] = vec_add(t0, x[i + 2]);
+    x[i + 1] = vec_add(t1, x[i + 3]);
+    x[i + 2] = vec_sub(t0, x[i + 2]);
+    x[i + 3] = vec_sub(t1, x[i + 3]);
+    x[i + 4] = prod_round(prod_add(s[i + 4], s[i + 6]));
+    x[i + 5] = prod_round(prod_add(s[i + 5], s[i + 7]));
+    x[i + 6] = prod_round(prod_sub(s[i + 4], s[i + 6]));
+    x[i + 7] = prod_round(prod_sub(s[i + 5], s[i + 7]));
+  }
+
+  // stage 4
+  io[0] = x[0];
+  io[1] = vec_neg(x[8]);
+  io[2] = x[12];
+  io[3] = vec_neg(x[4]);
+  io[4] = mul_round(vec_add(x[6], x[7]), (int)cospi_16_64);
+  io[5] = prod_round(prod_neg(prod_mul(vec_add(x[14], x[15]),
+                                       (int)cospi_16_64)));
+  io[6] = mul_round(vec_add(x[10], x[11]), (int)cospi_16_64);
+  io[7] = prod_round(prod_neg(prod_mul(vec_add(x[2], x[3]),
+                                       (int)cospi_16_64)));
+  io[8] = mul_round(vec_sub(x[2], x[3]), (int)cospi_16_64);
+  io[9] = mul_round(vec_sub(x[11], x[10]), (int)cospi_16_64);
+  io[10] = mul_round(vec_sub(x[14], x[15]), (int)cospi_16_64);
+  io[11] = mul_round(vec_sub(x[7], x[6]), (int)cospi_16_64);
+  io[12] = x[5];
+  io[13] = vec_neg(x[13]);
+  io[14] = x[9];
+  io[15] = vec_neg(x[1]);
+}
+
+typedef void (*txfm_1d)(vec_t *io);
+
+// The row and column 1-D transforms of each tx_type.
+static const struct {
+  txfm_1d cols, rows;
+} IHT_4[] = {
+  { idct4, idct4 },    // DCT_DCT  = 0
+  { iadst4, idct4 },   // ADST_DCT = 1
+  { idct4, iadst4 },   // DCT_ADST = 2
+  { iadst4, iadst4 }   // ADST_ADST = 3
+}, IHT_8[] = {
+  { idct8, idct8 },
+  { iadst8, idct8 },
+  { idct8, iadst8 },
+  { iadst8, iadst8 }
+}, IHT_16[] = {
+  { idct16, idct16 },
+  { iadst16, idct16 },
+  { idct16, iadst16 },
+  { iadst16, iadst16 }
+};
+
+// Inverse transforms the n x n block 'input' and adds it to 'dest'. Both
+// passes work on VEC_LANES rows or columns at a time: the row pass transposes
+// each VEC_LANES x VEC_LANES block of coefficients in and out, which leaves
+// 'cols_in' holding the columns of the intermediate block.
+static INLINE void highbd_iht(const tran_low_t *input, uint16_t *dest,
+                              int stride, int n, txfm_1d rows, txfm_1d cols,
+                              int shift, int bd) {
+  vec_t cols_in[16 * 16 / VEC_LANES];
+  vec_t v[16];
+  const int groups = n / VEC_LANES;
+  int i, j, g;
+
+  for (i = 0; i < n; i += VEC_LANES) {
+    for (g = 0; g < groups; ++g) {
+      vec_t *const blk = v + g * VEC_LANES;
+      for (j = 0; j < VEC_LANES; ++j)
+        blk[j] = vec_load(input + (i + j) * n + g * VEC_LANES);
+      transpose(blk);
+    }
+    rows(v);
+    for (g = 0; g < groups; ++g) {
+      vec_t *const blk = v + g * VEC_LANES;
+      transpose(blk);
+      for (j = 0; j < VEC_LANES; ++j) cols_in[g * n + i + j] = blk[j];
+    }
+  }
+
+  for (g = 0; g < groups; ++g) {
+    vec_t *const col = cols_in + g * n;
+    cols(col);
+    for (j = 0; j < n; ++j)
+      recon_store(dest + j * stride + g * VEC_LANES, col[j], shift, bd);
+  }
+}
+
+#ifdef HIGHBD_IHT4X4
+void HIGHBD_IHT4X4(const tran_low_t *input, uint8_t *dest8, int stride,
+                   int tx_type, int bd) {
+  highbd_iht(input, CONVERT_TO_SHORTPTR(dest8), stride, 4,
+             IHT_4[tx_type].rows, IHT_4[tx_type].cols, 4, bd);
+}
+#endif
+
+void HIGHBD_IHT8X8(const tran_low_t *input, uint8_t *dest8, int stride,
+                   int tx_type, int bd) {
+  highbd_iht(input, CONVERT_TO_SHORTPTR(dest8), stride, 8,
+             IHT_8[tx_type].rows, IHT_8[tx_type].cols, 5, bd);
+}
+
+void HIGHBD_IHT16X16(const tran_low_t *input, uint8_t *dest8, int stride,
+                     int tx_type, int bd) {
+  highbd_iht(input, CONVERT_TO_SHORTPTR(dest8), stride, 16,
+             IHT_16[tx_type].rows, IHT_16[tx_type].cols, 6, bd);
+}
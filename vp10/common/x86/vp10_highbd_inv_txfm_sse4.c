@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./vp10_rtcd.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_ports/mem.h"
+
+#define VEC_LANES 4
+
+typedef __m128i vec_t;
+
+// The products of lanes 0 and 2 and of lanes 1 and 3.
+typedef struct {
+  __m128i even, odd;
+} prod_t;
+
+static INLINE vec_t vec_zero(void) { return _mm_setzero_si128(); }
+
+static INLINE vec_t vec_add(vec_t a, vec_t b) { return _mm_add_epi32(a, b); }
+
+static INLINE vec_t vec_sub(vec_t a, vec_t b) { return _mm_sub_epi32(a, b); }
+
+static INLINE prod_t prod_mul(vec_t a, int c) {
+  const __m128i k = _mm_set1_epi32(c);
+  prod_t p;
+  p.even = _mm_mul_epi32(a, k);
+  p.odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), k);
+  return p;
+}
+
+static INLINE prod_t prod_add(prod_t a, prod_t b) {
+  prod_t p;
+  p.even = _mm_add_epi64(a.even, b.even);
+  p.odd = _mm_add_epi64(a.odd, b.odd);
+  return p;
+}
+
+static INLINE prod_t prod_sub(prod_t a, prod_t b) {
+  prod_t p;
+  p.even = _mm_sub_epi64(a.even, b.even);
+  p.odd = _mm_sub_epi64(a.odd, b.odd);
+  return p;
+}
+
+static INLINE prod_t prod_neg(prod_t a) {
+  prod_t p;
+  p.even = _mm_sub_epi64(_mm_setzero_si128(), a.even);
+  p.odd = _mm_sub_epi64(_mm_setzero_si128(), a.odd);
+  return p;
+}
+
+static INLINE vec_t prod_round(prod_t a) {
+  const __m128i rounding = _mm_set1_epi64x(1 << (DCT_CONST_BITS - 1));
+  // Only the low 32 bits of each result are kept, so logical shifts will do.
+  const __m128i even =
+      _mm_srli_epi64(_mm_add_epi64(a.even, rounding), DCT_CONST_BITS);
+  const __m128i odd =
+      _mm_slli_epi64(_mm_add_epi64(a.odd, rounding), 32 - DCT_CONST_BITS);
+  return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+static INLINE vec_t vec_load(const tran_low_t *p) {
+  return _mm_loadu_si128((const __m128i *)p);
+}
+
+static INLINE void transpose(vec_t *v) {
+  const __m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+  const __m128i t1 = _mm_unpacklo_epi32(v[2], v[3]);
+  const __m128i t2 = _mm_unpackhi_epi32(v[0], v[1]);
+  const __m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+  v[0] = _mm_unpacklo_epi64(t0, t1);
+  v[1] = _mm_unpackhi_epi64(t0, t1);
+  v[2] = _mm_unpacklo_epi64(t2, t3);
+  v[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+static INLINE void recon_store(uint16_t *dest, vec_t v, int shift, int bd) {
+  const __m128i d = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)dest));
+  __m128i x = _mm_srai_epi32(_mm_add_epi32(v, _mm_set1_epi32(1 << (shift - 1))),
+                             shift);
+  x = _mm_add_epi32(x, d);
+  x = _mm_min_epi32(_mm_max_epi32(x, _mm_setzero_si128()),
+                    _mm_set1_epi32((1 << bd) - 1));
+  _mm_storel_epi64((__m128i *)dest, _mm_packus_epi32(x, x));
+}
+
+#define HIGHBD_IHT4X4 vp10_highbd_iht4x4_16_add_sse4_1
+#define HIGHBD_IHT8X8 vp10_highbd_iht8x8_64_add_sse4_1
+#define HIGHBD_IHT16X16 vp10_highbd_iht16x16_256_add_sse4_1
+#include "vp10/common/x86/vp10_highbd_inv_txfm_impl.h"
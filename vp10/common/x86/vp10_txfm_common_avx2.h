@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP10_COMMON_X86_VP10_TXFM_COMMON_AVX2_H_
+#define VP10_COMMON_X86_VP10_TXFM_COMMON_AVX2_H_
+
+#include <immintrin.h>  // AVX2
+
+#include "vpx_dsp/txfm_common.h"
+
+#define pair256_set_epi16(a, b)                                            \
+  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
+
+// Transposes the 8x8 blocks held in each 128-bit lane of in[0..7].
+static INLINE void array_transpose_8x8_avx2(const __m256i *in, __m256i *res) {
+  const __m256i tr0_0 = _mm256_unpacklo_epi16(in[0], in[1]);
+  const __m256i tr0_1 = _mm256_unpacklo_epi16(in[2], in[3]);
+  const __m256i tr0_2 = _mm256_unpackhi_epi16(in[0], in[1]);
+  const __m256i tr0_3 = _mm256_unpackhi_epi16(in[2], in[3]);
+  const __m256i tr0_4 = _mm256_unpacklo_epi16(in[4], in[5]);
+  const __m256i tr0_5 = _mm256_unpacklo_epi16(in[6], in[7]);
+  const __m256i tr0_6 = _mm256_unpackhi_epi16(in[4], in[5]);
+  const __m256i tr0_7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  const __m256i tr1_0 = _mm256_unpacklo_epi32(tr0_0, tr0_1);
+  const __m256i tr1_1 = _mm256_unpacklo_epi32(tr0_4, tr0_5);
+  const __m256i tr1_2 = _mm256_unpackhi_epi32(tr0_0, tr0_1);
+  const __m256i tr1_3 = _mm256_unpackhi_epi32(tr0_4, tr0_5);
+  const __m256i tr1_4 = _mm256_unpacklo_epi32(tr0_2, tr0_3);
+  const __m256i tr1_5 = _mm256_unpacklo_epi32(tr0_6, tr0_7);
+  const __m256i tr1_6 = _mm256_unpackhi_epi32(tr0_2, tr0_3);
+  const __m256i tr1_7 = _mm256_unpackhi_epi32(tr0_6, tr0_7);
+
+  res[0] = _mm256_unpacklo_epi64(tr1_0, tr1_1);
+  res[1] = _mm256_unpackhi_epi64(tr1_0, tr1_1);
+  res[2] = _mm256_unpacklo_epi64(tr1_2, tr1_3);
+  res[3] = _mm256_unpackhi_epi64(tr1_2, tr1_3);
+  res[4] = _mm256_unpacklo_epi64(tr1_4, tr1_5);
+  res[5] = _mm256_unpackhi_epi64(tr1_4, tr1_5);
+  res[6] = _mm256_unpacklo_epi64(tr1_6, tr1_7);
+  res[7] = _mm256_unpackhi_epi64(tr1_6, tr1_7);
+}
+
+// Transposes a 16x16 block held one row per register. The lane-wise 8x8
+// transposes leave the quadrants in place, so the lanes are then regrouped.
+static INLINE void array_transpose_16x16_avx2(__m256i *in) {
+  __m256i tbuf[16];
+  int i;
+  array_transpose_8x8_avx2(in, tbuf);
+  array_transpose_8x8_avx2(in + 8, tbuf + 8);
+  for (i = 0; i < 8; ++i) {
+    in[i] = _mm256_permute2x128_si256(tbuf[i], tbuf[i + 8], 0x20);
+    in[i + 8] = _mm256_permute2x128_si256(tbuf[i], tbuf[i + 8], 0x31);
+  }
+}
+
+#endif  // VP10_COMMON_X86_VP10_TXFM_COMMON_AVX2_H_
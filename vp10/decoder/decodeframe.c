@@ -340,17 +340,13 @@ static void inverse_transform_block_intra(MACROBLOCKD *xd, int plane,
   }
 }
 
-static void predict_and_reconstruct_intra_block(MACROBLOCKD *const xd,
-                                                vpx_reader *r,
-                                                MB_MODE_INFO *const mbmi,
-                                                int plane, int row, int col,
-                                                TX_SIZE tx_size) {
+// Predicts the transform block at (row, col) in place. Returns the pixels.
+static uint8_t *predict_intra_block(MACROBLOCKD *const xd,
+                                    const MB_MODE_INFO *const mbmi, int plane,
+                                    int row, int col, TX_SIZE tx_size) {
   struct macroblockd_plane *const pd = &xd->plane[plane];
   PREDICTION_MODE mode = (plane == 0) ? mbmi->mode : mbmi->uv_mode;
-  PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
-  uint8_t *dst;
-  int block_idx = (row << 1) + col;
-  dst = &pd->dst.buf[4 * row * pd->dst.stride + 4 * col];
+  uint8_t *const dst = &pd->dst.buf[4 * row * pd->dst.stride + 4 * col];
 
   if (mbmi->sb_type < BLOCK_8X8)
     if (plane == 0) mode = xd->mi[0]->bmi[(row << 1) + col].as_mode;
@@ -358,6 +354,18 @@ static void predict_and_reconstruct_intra_block(MACROBLOCKD *const xd,
   vp10_predict_intra_block(xd, pd->n4_wl, pd->n4_hl, tx_size, mode, dst,
                            pd->dst.stride, dst, pd->dst.stride, col, row,
                            plane);
+  return dst;
+}
+
+static void predict_and_reconstruct_intra_block(MACROBLOCKD *const xd,
+                                                vpx_reader *r,
+                                                MB_MODE_INFO *const mbmi,
+                                                int plane, int row, int col,
+                                                TX_SIZE tx_size) {
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+  int block_idx = (row << 1) + col;
+  uint8_t *const dst = predict_intra_block(xd, mbmi, plane, row, col, tx_size);
 
   if (!mbmi->skip) {
     TX_TYPE tx_type = get_tx_type(plane_type, xd, block_idx);
@@ -612,11 +620,10 @@ static void dec_build_inter_predictors(
       y_pad = 1;
     }
 
-    // Wait until reference block is ready. Pad 7 more pixels as last 7
-    // pixels of each superblock row can be changed by next superblock row.
+    // Wait until the rows of the reference block are final.
     if (cm->frame_parallel_decode)
       vp10_frameworker_wait(pbi->frame_worker_owner, ref_frame_buf,
-                            VPXMAX(0, (y1 + 7)) << (plane == 0 ? 0 : 1));
+                            (VPXMAX(0, y1) + 1) << pd->subsampling_y);
 
     // Skip border extension if block is inside the frame.
     if (x0 < 0 || x0 > frame_width - 1 || x1 < 0 || x1 > frame_width - 1 ||
@@ -637,12 +644,11 @@ static void dec_build_inter_predictors(
       return;
     }
   } else {
-    // Wait until reference block is ready. Pad 7 more pixels as last 7
-    // pixels of each superblock row can be changed by next superblock row.
+    // Wait until the rows of the reference block are final.
     if (cm->frame_parallel_decode) {
       const int y1 = (y0_16 + (h - 1) * ys) >> SUBPEL_BITS;
       vp10_frameworker_wait(pbi->frame_worker_owner, ref_frame_buf,
-                            VPXMAX(0, (y1 + 7)) << (plane == 0 ? 0 : 1));
+                            (VPXMAX(0, y1) + 1) << pd->subsampling_y);
     }
   }
 #if CONFIG_VPX_HIGHBITDEPTH
@@ -773,9 +779,156 @@ static MB_MODE_INFO *set_offsets(VP10_COMMON *const cm, MACROBLOCKD *const xd,
   return &xd->mi[0]->mbmi;
 }
 
+// The number of 4x4 columns of the block in 'pd' that are inside the frame.
+static INLINE int dec_max_blocks_wide(const MACROBLOCKD *xd,
+                                      const struct macroblockd_plane *pd) {
+  return pd->n4_w + (xd->mb_to_right_edge >= 0
+                         ? 0
+                         : xd->mb_to_right_edge >> (5 + pd->subsampling_x));
+}
+
+// The number of 4x4 rows of the block in 'pd' that are inside the frame.
+static INLINE int dec_max_blocks_high(const MACROBLOCKD *xd,
+                                      const struct macroblockd_plane *pd) {
+  return pd->n4_h + (xd->mb_to_bottom_edge >= 0
+                         ? 0
+                         : xd->mb_to_bottom_edge >> (5 + pd->subsampling_y));
+}
+
+static INLINE TX_SIZE dec_get_tx_size(const MACROBLOCKD *xd,
+                                      const MB_MODE_INFO *mbmi, int plane) {
+  const struct macroblockd_plane *const pd = &xd->plane[plane];
+  return plane ? dec_get_uv_tx_size(mbmi, pd->n4_wl, pd->n4_hl)
+               : mbmi->tx_size;
+}
+
+// Parses the coefficients of the transform block at (row, col) into the next
+// place of 'coeffs'. Returns the eob.
+static int parse_coeffs(MACROBLOCKD *const xd, vpx_reader *r,
+                        const MB_MODE_INFO *const mbmi, int plane, int row,
+                        int col, TX_SIZE tx_size, VP10SbCoeffs *const coeffs) {
+  struct macroblockd_plane *const pd = &xd->plane[plane];
+  const PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+  const TX_TYPE tx_type = get_tx_type(plane_type, xd, (row << 1) + col);
+  const scan_order *sc = get_scan(tx_size, tx_type);
+  int eob;
+
+  pd->dqcoeff = coeffs->dqcoeff[plane];
+  eob = vp10_decode_block_tokens(xd, plane, sc, col, row, tx_size, r,
+                                 mbmi->segment_id);
+  *coeffs->eob[plane]++ = eob;
+  coeffs->dqcoeff[plane] += 16 << (tx_size << 1);
+  return eob;
+}
+
+// Parses the coefficients of the block into 'coeffs', for reconstruct_block()
+// to reconstruct the block later.
+static void parse_block_coeffs(MACROBLOCKD *const xd, vpx_reader *r,
+                               MB_MODE_INFO *const mbmi,
+                               VP10SbCoeffs *const coeffs) {
+#if !CONFIG_MISC_FIXES
+  const VP10SbCoeffs start = *coeffs;
+#endif
+  int eobtotal = 0;
+  int plane;
+
+  if (mbmi->skip) return;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const struct macroblockd_plane *const pd = &xd->plane[plane];
+    const TX_SIZE tx_size = dec_get_tx_size(xd, mbmi, plane);
+    const int step = (1 << tx_size);
+    const int max_blocks_wide = dec_max_blocks_wide(xd, pd);
+    const int max_blocks_high = dec_max_blocks_high(xd, pd);
+    int row, col;
+
+    for (row = 0; row < max_blocks_high; row += step)
+      for (col = 0; col < max_blocks_wide; col += step)
+        eobtotal +=
+            parse_coeffs(xd, r, mbmi, plane, row, col, tx_size, coeffs);
+  }
+
+  if (is_inter_block(mbmi) && mbmi->sb_type >= BLOCK_8X8 && eobtotal == 0) {
+#if CONFIG_MISC_FIXES
+    mbmi->has_no_coeffs = 1;  // skip loopfilter
+#else
+    // reconstruct_block() skips the block now, so there is nothing to keep.
+    *coeffs = start;
+    mbmi->skip = 1;  // skip loopfilter
+#endif
+  }
+}
+
+// Reconstructs a block that parse_block_coeffs() parsed, taking its
+// coefficients from 'coeffs'.
+static void reconstruct_block(VP10Decoder *const pbi, MACROBLOCKD *const xd,
+                              int mi_row, int mi_col, int bwl, int bhl,
+                              VP10SbCoeffs *const coeffs) {
+  VP10_COMMON *const cm = &pbi->common;
+  const int bw = 1 << (bwl - 1);
+  const int bh = 1 << (bhl - 1);
+  const MB_MODE_INFO *mbmi;
+  int plane;
+
+  xd->mi = cm->mi_grid_visible + mi_row * cm->mi_stride + mi_col;
+  mbmi = &xd->mi[0]->mbmi;
+  set_plane_n4(xd, bw, bh, bwl, bhl);
+  set_mi_row_col(xd, &xd->tile, mi_row, bh, mi_col, bw, cm->mi_rows,
+                 cm->mi_cols);
+  vp10_setup_dst_planes(xd->plane, get_frame_new_buffer(cm), mi_row, mi_col);
+
+  if (is_inter_block(mbmi)) {
+    int ref;
+    for (ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
+      RefBuffer *const ref_buf =
+          &cm->frame_refs[mbmi->ref_frame[ref] - LAST_FRAME];
+      xd->block_refs[ref] = ref_buf;
+      vp10_setup_pre_planes(xd, ref, ref_buf->buf, mi_row, mi_col,
+                            &ref_buf->sf);
+    }
+    dec_build_inter_predictors_sb(pbi, xd, mi_row, mi_col);
+    if (mbmi->skip) return;
+  }
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    struct macroblockd_plane *const pd = &xd->plane[plane];
+    const PLANE_TYPE plane_type = (plane == 0) ? PLANE_TYPE_Y : PLANE_TYPE_UV;
+    const TX_SIZE tx_size = dec_get_tx_size(xd, mbmi, plane);
+    const int step = (1 << tx_size);
+    const int max_blocks_wide = dec_max_blocks_wide(xd, pd);
+    const int max_blocks_high = dec_max_blocks_high(xd, pd);
+    int row, col;
+
+    for (row = 0; row < max_blocks_high; row += step) {
+      for (col = 0; col < max_blocks_wide; col += step) {
+        const int block_idx = (row << 1) + col;
+        uint8_t *dst = &pd->dst.buf[4 * row * pd->dst.stride + 4 * col];
+        int eob;
+
+        if (!is_inter_block(mbmi)) {
+          dst = predict_intra_block(xd, mbmi, plane, row, col, tx_size);
+          if (mbmi->skip) continue;
+        }
+        pd->dqcoeff = coeffs->dqcoeff[plane];
+        eob = *coeffs->eob[plane]++;
+        coeffs->dqcoeff[plane] += 16 << (tx_size << 1);
+        if (is_inter_block(mbmi))
+          inverse_transform_block_inter(xd, plane, tx_size, dst,
+                                        pd->dst.stride, eob, block_idx);
+        else
+          inverse_transform_block_intra(
+              xd, plane, get_tx_type(plane_type, xd, block_idx), tx_size, dst,
+              pd->dst.stride, eob);
+      }
+    }
+  }
+}
+
+// Decodes the block, or only parses it into 'coeffs' if that is not NULL.
 static void decode_block(VP10Decoder *const pbi, MACROBLOCKD *const xd,
                          int mi_row, int mi_col, vpx_reader *r,
-                         BLOCK_SIZE bsize, int bwl, int bhl) {
+                         BLOCK_SIZE bsize, int bwl, int bhl,
+                         VP10SbCoeffs *const coeffs) {
   VP10_COMMON *const cm = &pbi->common;
   const int less8x8 = bsize < BLOCK_8X8;
   const int bw = 1 << (bwl - 1);
@@ -800,25 +953,17 @@ static void decode_block(VP10Decoder *const pbi, MACROBLOCKD *const xd,
     dec_reset_skip_context(xd);
   }
 
-  if (!is_inter_block(mbmi)) {
+  if (coeffs != NULL) {
+    parse_block_coeffs(xd, r, mbmi, coeffs);
+  } else if (!is_inter_block(mbmi)) {
     int plane;
     for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
       const struct macroblockd_plane *const pd = &xd->plane[plane];
-      const TX_SIZE tx_size =
-          plane ? dec_get_uv_tx_size(mbmi, pd->n4_wl, pd->n4_hl)
-                : mbmi->tx_size;
-      const int num_4x4_w = pd->n4_w;
-      const int num_4x4_h = pd->n4_h;
+      const TX_SIZE tx_size = dec_get_tx_size(xd, mbmi, plane);
       const int step = (1 << tx_size);
       int row, col;
-      const int max_blocks_wide =
-          num_4x4_w + (xd->mb_to_right_edge >= 0
-                           ? 0
-                           : xd->mb_to_right_edge >> (5 + pd->subsampling_x));
-      const int max_blocks_high =
-          num_4x4_h + (xd->mb_to_bottom_edge >= 0
-                           ? 0
-                           : xd->mb_to_bottom_edge >> (5 + pd->subsampling_y));
+      const int max_blocks_wide = dec_max_blocks_wide(xd, pd);
+      const int max_blocks_high = dec_max_blocks_high(xd, pd);
 
       for (row = 0; row < max_blocks_high; row += step)
         for (col = 0; col < max_blocks_wide; col += step)
@@ -836,21 +981,11 @@ static void decode_block(VP10Decoder *const pbi, MACROBLOCKD *const xd,
 
       for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
         const struct macroblockd_plane *const pd = &xd->plane[plane];
-        const TX_SIZE tx_size =
-            plane ? dec_get_uv_tx_size(mbmi, pd->n4_wl, pd->n4_hl)
-                  : mbmi->tx_size;
-        const int num_4x4_w = pd->n4_w;
-        const int num_4x4_h = pd->n4_h;
+        const TX_SIZE tx_size = dec_get_tx_size(xd, mbmi, plane);
         const int step = (1 << tx_size);
         int row, col;
-        const int max_blocks_wide =
-            num_4x4_w + (xd->mb_to_right_edge >= 0
-                             ? 0
-                             : xd->mb_to_right_edge >> (5 + pd->subsampling_x));
-        const int max_blocks_high =
-            num_4x4_h +
-            (xd->mb_to_bottom_edge >= 0 ? 0 : xd->mb_to_bottom_edge >>
-                                                  (5 + pd->subsampling_y));
+        const int max_blocks_wide = dec_max_blocks_wide(xd, pd);
+        const int max_blocks_high = dec_max_blocks_high(xd, pd);
 
         for (row = 0; row < max_blocks_high; row += step)
           for (col = 0; col < max_blocks_wide; col += step)
@@ -919,7 +1054,8 @@ static PARTITION_TYPE read_partition(VP10_COMMON *cm, MACROBLOCKD *xd,
 // TODO(slavarnway): eliminate bsize and subsize in future commits
 static void decode_partition(VP10Decoder *const pbi, MACROBLOCKD *const xd,
                              int mi_row, int mi_col, vpx_reader *r,
-                             BLOCK_SIZE bsize, int n4x4_l2) {
+                             BLOCK_SIZE bsize, int n4x4_l2,
+                             VP10SbCoeffs *const coeffs) {
   VP10_COMMON *const cm = &pbi->common;
   const int n8x8_l2 = n4x4_l2 - 1;
   const int num_8x8_wh = 1 << n8x8_l2;
@@ -938,30 +1074,35 @@ static void decode_partition(VP10Decoder *const pbi, MACROBLOCKD *const xd,
     // calculate bmode block dimensions (log 2)
     xd->bmode_blocks_wl = 1 >> !!(partition & PARTITION_VERT);
     xd->bmode_blocks_hl = 1 >> !!(partition & PARTITION_HORZ);
-    decode_block(pbi, xd, mi_row, mi_col, r, subsize, 1, 1);
+    decode_block(pbi, xd, mi_row, mi_col, r, subsize, 1, 1, coeffs);
   } else {
     switch (partition) {
       case PARTITION_NONE:
-        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n4x4_l2, n4x4_l2);
+        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n4x4_l2, n4x4_l2,
+                     coeffs);
         break;
       case PARTITION_HORZ:
-        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n4x4_l2, n8x8_l2);
+        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n4x4_l2, n8x8_l2,
+                     coeffs);
         if (has_rows)
           decode_block(pbi, xd, mi_row + hbs, mi_col, r, subsize, n4x4_l2,
-                       n8x8_l2);
+                       n8x8_l2, coeffs);
         break;
       case PARTITION_VERT:
-        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n8x8_l2, n4x4_l2);
+        decode_block(pbi, xd, mi_row, mi_col, r, subsize, n8x8_l2, n4x4_l2,
+                     coeffs);
         if (has_cols)
           decode_block(pbi, xd, mi_row, mi_col + hbs, r, subsize, n8x8_l2,
-                       n4x4_l2);
+                       n4x4_l2, coeffs);
         break;
       case PARTITION_SPLIT:
-        decode_partition(pbi, xd, mi_row, mi_col, r, subsize, n8x8_l2);
-        decode_partition(pbi, xd, mi_row, mi_col + hbs, r, subsize, n8x8_l2);
-        decode_partition(pbi, xd, mi_row + hbs, mi_col, r, subsize, n8x8_l2);
+        decode_partition(pbi, xd, mi_row, mi_col, r, subsize, n8x8_l2, coeffs);
+        decode_partition(pbi, xd, mi_row, mi_col + hbs, r, subsize, n8x8_l2,
+                         coeffs);
+        decode_partition(pbi, xd, mi_row + hbs, mi_col, r, subsize, n8x8_l2,
+                         coeffs);
         decode_partition(pbi, xd, mi_row + hbs, mi_col + hbs, r, subsize,
-                         n8x8_l2);
+                         n8x8_l2, coeffs);
         break;
       default: assert(0 && "Invalid partition type");
     }
@@ -984,6 +1125,49 @@ static void decode_partition(VP10Decoder *const pbi, MACROBLOCKD *const xd,
 #endif
 }
 
+// Reconstructs the blocks of a partition that decode_partition() parsed,
+// walking the partition tree from the block sizes of the mode info.
+static void reconstruct_partition(VP10Decoder *const pbi,
+                                  MACROBLOCKD *const xd, int mi_row,
+                                  int mi_col, BLOCK_SIZE bsize, int n4x4_l2,
+                                  VP10SbCoeffs *const coeffs) {
+  VP10_COMMON *const cm = &pbi->common;
+  const int n8x8_l2 = n4x4_l2 - 1;
+  const int num_8x8_wh = 1 << n8x8_l2;
+  const int hbs = num_8x8_wh >> 1;
+  const int has_rows = (mi_row + hbs) < cm->mi_rows;
+  const int has_cols = (mi_col + hbs) < cm->mi_cols;
+  BLOCK_SIZE subsize;
+
+  if (mi_row >= cm->mi_rows || mi_col >= cm->mi_cols) return;
+
+  subsize = cm->mi_grid_visible[mi_row * cm->mi_stride + mi_col]->mbmi.sb_type;
+  if (!hbs) {
+    reconstruct_block(pbi, xd, mi_row, mi_col, 1, 1, coeffs);
+  } else if (subsize == bsize) {
+    reconstruct_block(pbi, xd, mi_row, mi_col, n4x4_l2, n4x4_l2, coeffs);
+  } else if (subsize == subsize_lookup[PARTITION_HORZ][bsize]) {
+    reconstruct_block(pbi, xd, mi_row, mi_col, n4x4_l2, n8x8_l2, coeffs);
+    if (has_rows)
+      reconstruct_block(pbi, xd, mi_row + hbs, mi_col, n4x4_l2, n8x8_l2,
+                        coeffs);
+  } else if (subsize == subsize_lookup[PARTITION_VERT][bsize]) {
+    reconstruct_block(pbi, xd, mi_row, mi_col, n8x8_l2, n4x4_l2, coeffs);
+    if (has_cols)
+      reconstruct_block(pbi, xd, mi_row, mi_col + hbs, n8x8_l2, n4x4_l2,
+                        coeffs);
+  } else {
+    subsize = subsize_lookup[PARTITION_SPLIT][bsize];
+    reconstruct_partition(pbi, xd, mi_row, mi_col, subsize, n8x8_l2, coeffs);
+    reconstruct_partition(pbi, xd, mi_row, mi_col + hbs, subsize, n8x8_l2,
+                          coeffs);
+    reconstruct_partition(pbi, xd, mi_row + hbs, mi_col, subsize, n8x8_l2,
+                          coeffs);
+    reconstruct_partition(pbi, xd, mi_row + hbs, mi_col + hbs, subsize,
+                          n8x8_l2, coeffs);
+  }
+}
+
 static void setup_token_decoder(const uint8_t *data, const uint8_t *data_end,
                                 size_t read_size,
                                 struct vpx_internal_error_info *error_info,
@@ -1487,10 +1671,208 @@ static void get_tile_buffers(VP10Decoder *pbi, const uint8_t *data,
   }
 }
 
+// Deringing level and CLPF flag of the frame, or 0 if the tool is not built.
+static int get_dering_level(const VP10_COMMON *cm) {
+#if CONFIG_DERING
+  return cm->dering_level;
+#else
+  (void)cm;
+  return 0;
+#endif  // CONFIG_DERING
+}
+
+static int get_clpf(const VP10_COMMON *cm) {
+#if CONFIG_CLPF
+  return cm->clpf;
+#else
+  (void)cm;
+  return 0;
+#endif  // CONFIG_CLPF
+}
+
+static struct VP10DeringSyncData *get_dering_sync(VP10Decoder *pbi) {
+#if CONFIG_DERING
+  return &pbi->dering_sync;
+#else
+  (void)pbi;
+  return NULL;
+#endif  // CONFIG_DERING
+}
+
+// Whether the decoded rows go through the loop filter, deringing or CLPF.
+static int use_post_filters(const VP10_COMMON *cm) {
+  return !cm->skip_loop_filter &&
+         (cm->lf.filter_level || get_dering_level(cm) || get_clpf(cm));
+}
+
+// Returns the thread pool the jobs run on, or NULL without threads. Unless
+// the application set a pool, takes a reference to the shared pool on first
+// use, asking for a thread for each job besides the calling thread.
+static VPxThreadPool *get_thread_pool(VP10Decoder *pbi) {
+  if (pbi->max_threads <= 1) return NULL;
+  if (pbi->thread_pool == NULL) {
+    pbi->thread_pool = vpx_thread_pool_get_shared(pbi->max_threads - 1);
+    if (pbi->thread_pool == NULL)
+      vpx_internal_error(&pbi->common.error, VPX_CODEC_ERROR,
+                         "Decoder thread creation failed");
+  }
+  return pbi->thread_pool;
+}
+
+// Allocate the data of the tile jobs on first use. The jobs run on the
+// thread pool, which is shared with the multi-threaded post-processing
+// filters.
+static void init_tile_jobs(VP10Decoder *pbi) {
+  VP10_COMMON *const cm = &pbi->common;
+
+  get_thread_pool(pbi);
+  if (pbi->num_tile_workers == 0) {
+    const int num_threads = pbi->max_threads;
+    // Ensure tile data offsets will be properly aligned. This may fail on
+    // platforms without DECLARE_ALIGNED().
+    assert((sizeof(*pbi->tile_worker_data) % 16) == 0);
+    CHECK_MEM_ERROR(
+        cm, pbi->tile_worker_data,
+        vpx_memalign(32, num_threads * sizeof(*pbi->tile_worker_data)));
+    pbi->num_tile_workers = num_threads;
+  }
+}
+
+// Loop filters, derings and CLPFs the decoded frame with the thread pool.
+static void post_filter_frame_mt(VP10Decoder *pbi) {
+  VP10_COMMON *const cm = &pbi->common;
+  if (!cm->skip_loop_filter) {
+    vp10_post_filter_frame_mt(get_frame_new_buffer(cm), cm, pbi->mb.plane,
+                              cm->lf.filter_level, get_dering_level(cm),
+                              get_clpf(cm), pbi->thread_pool,
+                              pbi->max_threads, &pbi->lf_row_sync,
+                              get_dering_sync(pbi));
+  }
+}
+
+// Whether the tile decoder only parses the superblocks, for jobs on the
+// thread pool to reconstruct the rows behind it. The reconstruction follows
+// the parsing in raster order, which the inverted tile order of the tests
+// does not. Without pool threads the jobs would run, and wait for the
+// parsing, as they are submitted.
+static int use_row_mt(VP10Decoder *pbi) {
+  return pbi->max_threads > 1 && !pbi->inv_tile_order &&
+         vpx_thread_pool_num_threads(get_thread_pool(pbi)) > 0;
+}
+
+// The number of coefficients of a superblock in 'plane'.
+static int get_sb_coeffs_size(const VP10SbCoeffBuffer *sb_coeffs, int plane) {
+  const int size = (MI_BLOCK_SIZE * MI_SIZE) * (MI_BLOCK_SIZE * MI_SIZE);
+  return plane ? size >> (sb_coeffs->subsampling_x + sb_coeffs->subsampling_y)
+               : size;
+}
+
+// Points 'coeffs' at the start of the slots of superblock 'sb_index'.
+static void get_sb_coeffs(VP10Decoder *pbi, int sb_index,
+                          VP10SbCoeffs *coeffs) {
+  const VP10SbCoeffBuffer *const sb_coeffs = &pbi->sb_coeffs;
+  int plane;
+
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+    const int size = get_sb_coeffs_size(sb_coeffs, plane);
+    coeffs->dqcoeff[plane] = sb_coeffs->dqcoeff[plane] + sb_index * size;
+    coeffs->eob[plane] = sb_coeffs->eob[plane] + sb_index * (size >> 4);
+  }
+}
+
+// Allocates the coefficient buffer for 'num_sbs' superblocks, and clears it
+// if the last frame left coefficients in it.
+static void init_sb_coeffs(VP10Decoder *pbi, int num_sbs) {
+  VP10_COMMON *const cm = &pbi->common;
+  VP10SbCoeffBuffer *const sb_coeffs = &pbi->sb_coeffs;
+  int plane;
+
+  if (sb_coeffs->num_sbs != num_sbs ||
+      sb_coeffs->subsampling_x != cm->subsampling_x ||
+      sb_coeffs->subsampling_y != cm->subsampling_y) {
+    sb_coeffs->num_sbs = 0;
+    sb_coeffs->subsampling_x = cm->subsampling_x;
+    sb_coeffs->subsampling_y = cm->subsampling_y;
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      const int size = get_sb_coeffs_size(sb_coeffs, plane);
+      vpx_free(sb_coeffs->dqcoeff[plane]);
+      vpx_free(sb_coeffs->eob[plane]);
+      sb_coeffs->dqcoeff[plane] = NULL;
+      sb_coeffs->eob[plane] = NULL;
+      CHECK_MEM_ERROR(cm, sb_coeffs->dqcoeff[plane],
+                      vpx_calloc(num_sbs * size,
+                                 sizeof(*sb_coeffs->dqcoeff[plane])));
+      CHECK_MEM_ERROR(cm, sb_coeffs->eob[plane],
+                      vpx_malloc(num_sbs * (size >> 4) *
+                                 sizeof(*sb_coeffs->eob[plane])));
+    }
+    sb_coeffs->num_sbs = num_sbs;
+  } else if (sb_coeffs->pending) {
+    for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
+      memset(sb_coeffs->dqcoeff[plane], 0,
+             num_sbs * get_sb_coeffs_size(sb_coeffs, plane) *
+                 sizeof(*sb_coeffs->dqcoeff[plane]));
+    }
+  }
+  sb_coeffs->pending = 1;
+}
+
+// Allocates the coefficient buffer and the synchronization of the
+// reconstruction jobs for the frame size, and resets them.
+static void init_row_mt(VP10Decoder *pbi) {
+  VP10_COMMON *const cm = &pbi->common;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int sb_cols = mi_cols_aligned_to_sb(cm->mi_cols) >> MI_BLOCK_SIZE_LOG2;
+
+  init_tile_jobs(pbi);
+
+  if (pbi->row_mt_sync.rows != sb_rows || pbi->row_mt_sync.cols != sb_cols) {
+    vp10_row_mt_dealloc(&pbi->row_mt_sync);
+    vp10_row_mt_alloc(&pbi->row_mt_sync, cm, sb_rows, sb_cols);
+  }
+  vp10_row_mt_init(&pbi->row_mt_sync);
+  init_sb_coeffs(pbi, sb_rows * sb_cols);
+}
+
+// Reconstructs the superblock rows handed out by the group in turn, each
+// superblock once it is parsed and the row above is far enough ahead.
+static int recon_row_job_hook(TileWorkerData *const tile_data,
+                              VP10RowMtSync *const row_mt_sync) {
+  VP10Decoder *const pbi = tile_data->pbi;
+  VP10_COMMON *const cm = &pbi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  int sb_row;
+
+  while ((sb_row = vpx_job_group_next_index(&pbi->recon_jobs)) <
+         row_mt_sync->rows) {
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    int tile_row = 0;
+    int tile_col, mi_col;
+    TileInfo tile;
+
+    vp10_tile_set_row(&tile, cm, tile_row);
+    while (mi_row >= tile.mi_row_end) vp10_tile_set_row(&tile, cm, ++tile_row);
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      vp10_tile_set_col(&tile, cm, tile_col);
+      tile_data->xd.tile = tile;
+      for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
+           mi_col += MI_BLOCK_SIZE) {
+        const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+        VP10SbCoeffs coeffs;
+        if (!vp10_row_mt_wait(row_mt_sync, sb_row, sb_col)) return 0;
+        get_sb_coeffs(pbi, sb_row * row_mt_sync->cols + sb_col, &coeffs);
+        reconstruct_partition(pbi, &tile_data->xd, mi_row, mi_col, BLOCK_64X64,
+                              4, &coeffs);
+        vp10_row_mt_set_reconstructed(row_mt_sync, sb_row, sb_col);
+      }
+    }
+  }
+  return 1;
+}
+
 static const uint8_t *decode_tiles(VP10Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end) {
   VP10_COMMON *const cm = &pbi->common;
-  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
   const int aligned_cols = mi_cols_aligned_to_sb(cm->mi_cols);
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
@@ -1498,24 +1880,25 @@ static const uint8_t *decode_tiles(VP10Decoder *pbi, const uint8_t *data,
   int tile_row, tile_col;
   int mi_row, mi_col;
   TileData *tile_data = NULL;
+  const int row_mt = use_row_mt(pbi);
+  const int parse_ahead = !row_mt && pbi->parse_ahead;
+  // Loop filter, dering and CLPF the decoded rows in lf_job. The rows that
+  // the jobs reconstruct are filtered once the whole frame is.
+  const int filter_rows = !row_mt && use_post_filters(cm);
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter &&
-      pbi->lf_worker.data1 == NULL) {
-    CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
-                    vpx_memalign(32, sizeof(LFWorkerData)));
-    pbi->lf_worker.hook = (VPxWorkerHook)vp10_loop_filter_worker;
-    if (pbi->max_threads > 1 && !winterface->reset(&pbi->lf_worker)) {
-      vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
-                         "Loop filter thread creation failed");
-    }
+  if (filter_rows && pbi->lf_data == NULL) {
+    CHECK_MEM_ERROR(cm, pbi->lf_data, vpx_memalign(32, sizeof(LFWorkerData)));
   }
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
-    LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
+  if (filter_rows) {
+    LFWorkerData *const lf_data = pbi->lf_data;
     // Be sure to sync as we might be resuming after a failed frame decode.
-    winterface->sync(&pbi->lf_worker);
+    vpx_job_group_wait(&pbi->lf_job);
     vp10_loop_filter_data_reset(lf_data, get_frame_new_buffer(cm), cm,
                                 pbi->mb.plane);
+    vp10_loop_filter_rows_init(&pbi->lf_row_sync, cm, 1, cm->lf.filter_level,
+                               get_dering_level(cm), get_clpf(cm),
+                               get_dering_sync(pbi));
   }
 
   assert(tile_rows <= 4);
@@ -1562,6 +1945,29 @@ static const uint8_t *decode_tiles(VP10Decoder *pbi, const uint8_t *data,
     }
   }
 
+  if (row_mt) {
+    VP10RowMtSync *const row_mt_sync = &pbi->row_mt_sync;
+    int num_jobs, n;
+    init_row_mt(pbi);
+    // The jobs may wait for the parsing, so each must be queued and run on
+    // a pool thread.
+    num_jobs = VPXMIN(pbi->max_threads - 1, row_mt_sync->rows);
+    vpx_job_group_init(&pbi->recon_jobs, pbi->thread_pool);
+    for (n = 0; n < num_jobs; ++n) {
+      TileWorkerData *const worker_data = &pbi->tile_worker_data[n];
+      worker_data->pbi = pbi;
+      worker_data->xd = pbi->mb;
+      // The rows are handed out to the jobs in turn, so the jobs queued
+      // already reconstruct all of them if the queue cannot grow.
+      if (!vpx_job_group_submit(&pbi->recon_jobs,
+                                (VPxWorkerHook)recon_row_job_hook, worker_data,
+                                row_mt_sync))
+        break;
+    }
+  } else if (parse_ahead) {
+    init_sb_coeffs(pbi, aligned_cols >> MI_BLOCK_SIZE_LOG2);
+  }
+
   for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
     TileInfo tile;
     vp10_tile_set_row(&tile, cm, tile_row);
@@ -1576,65 +1982,81 @@ static const uint8_t *decode_tiles(VP10Decoder *pbi, const uint8_t *data,
         vp10_zero(tile_data->xd.left_seg_context);
         for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
              mi_col += MI_BLOCK_SIZE) {
+          const int sb_row = mi_row >> MI_BLOCK_SIZE_LOG2;
+          const int sb_col = mi_col >> MI_BLOCK_SIZE_LOG2;
+          VP10SbCoeffs coeffs;
+          if (row_mt)
+            get_sb_coeffs(pbi, sb_row * pbi->row_mt_sync.cols + sb_col,
+                          &coeffs);
+          else if (parse_ahead)
+            get_sb_coeffs(pbi, sb_col, &coeffs);
           decode_partition(pbi, &tile_data->xd, mi_row, mi_col,
-                           &tile_data->bit_reader, BLOCK_64X64, 4);
+                           &tile_data->bit_reader, BLOCK_64X64, 4,
+                           row_mt || parse_ahead ? &coeffs : NULL);
+          if (row_mt) vp10_row_mt_set_parsed(&pbi->row_mt_sync, sb_row, sb_col);
+        }
+        // Reconstruct the superblock row of the tile that was just parsed.
+        if (parse_ahead) {
+          for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
+               mi_col += MI_BLOCK_SIZE) {
+            VP10SbCoeffs coeffs;
+            get_sb_coeffs(pbi, mi_col >> MI_BLOCK_SIZE_LOG2, &coeffs);
+            reconstruct_partition(pbi, &tile_data->xd, mi_row, mi_col,
+                                  BLOCK_64X64, 4, &coeffs);
+          }
         }
         pbi->mb.corrupted |= tile_data->xd.corrupted;
         if (pbi->mb.corrupted)
           vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                              "Failed to decode tile data");
       }
-      // Loopfilter one row.
-      if (cm->lf.filter_level && !cm->skip_loop_filter) {
-        const int lf_start = mi_row - MI_BLOCK_SIZE;
-        LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-
-        // delay the loopfilter by 1 macroblock row.
-        if (lf_start < 0) continue;
-
-        // decoding has completed: finish up the loop filter in this thread.
-        if (mi_row + MI_BLOCK_SIZE >= cm->mi_rows) continue;
-
-        winterface->sync(&pbi->lf_worker);
-        lf_data->start = lf_start;
+      // Loopfilter one row, delayed by 1 superblock row. The last row is
+      // finished up below.
+      if (filter_rows && mi_row >= MI_BLOCK_SIZE &&
+          mi_row + MI_BLOCK_SIZE < cm->mi_rows) {
+        LFWorkerData *const lf_data = pbi->lf_data;
+        vpx_job_group_wait(&pbi->lf_job);
+        lf_data->start = mi_row - MI_BLOCK_SIZE;
         lf_data->stop = mi_row;
-        if (pbi->max_threads > 1) {
-          winterface->launch(&pbi->lf_worker);
-        } else {
-          winterface->execute(&pbi->lf_worker);
+        vpx_job_group_init(&pbi->lf_job, get_thread_pool(pbi));
+        vpx_job_group_submit(&pbi->lf_job,
+                             (VPxWorkerHook)vp10_loop_filter_row_worker,
+                             &pbi->lf_row_sync, lf_data);
+      }
+      // Let the frames that predict from this one read the rows that are
+      // final. Without filters those are the decoded rows, otherwise the
+      // filtering lags behind them. There are no pool threads in frame
+      // parallel mode, so the filter job has already run.
+      if (cm->frame_parallel_decode) {
+        int final_rows = (mi_row + MI_BLOCK_SIZE) << MI_SIZE_LOG2;
+        if (filter_rows) {
+          vpx_job_group_wait(&pbi->lf_job);
+          final_rows = vp10_loop_filter_rows_final(&pbi->lf_row_sync,
+                                                   pbi->lf_data->stop);
         }
+        vp10_frameworker_broadcast(pbi->cur_buf, final_rows);
       }
-      // After loopfiltering, the last 7 row pixels in each superblock row may
-      // still be changed by the longest loopfilter of the next superblock
-      // row.
-      if (cm->frame_parallel_decode)
-        vp10_frameworker_broadcast(pbi->cur_buf, mi_row << MI_BLOCK_SIZE_LOG2);
     }
   }
 
+  if (row_mt) {
+    vpx_job_group_wait(&pbi->recon_jobs);
+    post_filter_frame_mt(pbi);
+  }
+  if (row_mt || parse_ahead) pbi->sb_coeffs.pending = 0;
+
   // Loopfilter remaining rows in the frame.
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
-    LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
+  if (filter_rows) {
+    LFWorkerData *const lf_data = pbi->lf_data;
+    vpx_job_group_wait(&pbi->lf_job);
     lf_data->start = lf_data->stop;
     lf_data->stop = cm->mi_rows;
-    winterface->execute(&pbi->lf_worker);
-  }
-#if CONFIG_CLPF
-  if (cm->clpf && !cm->skip_loop_filter)
-    vp10_clpf_frame(&pbi->cur_buf->buf, cm, &pbi->mb);
-#endif
-#if CONFIG_DERING
-  if (cm->dering_level && !cm->skip_loop_filter) {
-    vp10_dering_frame(&pbi->cur_buf->buf, cm, &pbi->mb, cm->dering_level);
+    vp10_loop_filter_row_worker(&pbi->lf_row_sync, lf_data);
   }
-#endif  // CONFIG_DERING
 
   // Get last tile data.
   tile_data = pbi->tile_data + tile_cols * tile_rows - 1;
 
-  if (cm->frame_parallel_decode)
-    vp10_frameworker_broadcast(pbi->cur_buf, INT_MAX);
   return vpx_reader_find_end(&tile_data->bit_reader);
 }
 
@@ -1658,7 +2080,7 @@ static int tile_worker_hook(TileWorkerData *const tile_data,
     for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
          mi_col += MI_BLOCK_SIZE) {
       decode_partition(tile_data->pbi, &tile_data->xd, mi_row, mi_col,
-                       &tile_data->bit_reader, BLOCK_64X64, 4);
+                       &tile_data->bit_reader, BLOCK_64X64, 4, NULL);
     }
   }
   return !tile_data->xd.corrupted;
@@ -1671,58 +2093,70 @@ static int compare_tile_buffers(const void *a, const void *b) {
   return (int)(buf2->size - buf1->size);
 }
 
+// The tile columns of a frame that the tile jobs share out, largest first.
+typedef struct TileJobQueue {
+  const TileBuffer *buffers;
+  vpx_reader bit_readers[1 << 6];
+  int num_tiles;
+  // The end of the last tile column, once it has been decoded.
+  const uint8_t *bit_reader_end;
+} TileJobQueue;
+
+// Decodes the tile columns of 'queue' in turn with the other tile jobs.
+static int tile_job_hook(TileWorkerData *const tile_data,
+                         TileJobQueue *const queue) {
+  VP10Decoder *const pbi = tile_data->pbi;
+  VP10_COMMON *const cm = &pbi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  int ok = 1;
+  int n;
+
+  // The counts are cleared here rather than by the caller, so that pinned
+  // threads first write their job's data on their own node.
+  if (cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD)
+    vp10_zero(tile_data->counts);
+
+  while ((n = vpx_job_group_next_index(&pbi->tile_jobs)) < queue->num_tiles) {
+    const TileBuffer *const buf = &queue->buffers[n];
+    TileInfo tile;
+
+    tile_data->xd = pbi->mb;
+    tile_data->xd.corrupted = 0;
+    tile_data->xd.counts =
+        cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD
+            ? &tile_data->counts
+            : NULL;
+    vp10_zero(tile_data->dqcoeff);
+    vp10_tile_init(&tile, cm, 0, buf->col);
+    vp10_tile_init(&tile_data->xd.tile, cm, 0, buf->col);
+    tile_data->bit_reader = queue->bit_readers[n];
+    vp10_init_macroblockd(cm, &tile_data->xd, tile_data->dqcoeff);
+    tile_data->xd.plane[0].color_index_map = tile_data->color_index_map[0];
+    tile_data->xd.plane[1].color_index_map = tile_data->color_index_map[1];
+
+    ok &= tile_worker_hook(tile_data, &tile);
+    if (buf->col == tile_cols - 1)
+      queue->bit_reader_end = vpx_reader_find_end(&tile_data->bit_reader);
+  }
+  return ok;
+}
+
 static const uint8_t *decode_tiles_mt(VP10Decoder *pbi, const uint8_t *data,
                                       const uint8_t *data_end) {
   VP10_COMMON *const cm = &pbi->common;
-  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
-  const uint8_t *bit_reader_end = NULL;
   const int aligned_mi_cols = mi_cols_aligned_to_sb(cm->mi_cols);
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
-  const int num_workers = VPXMIN(pbi->max_threads & ~1, tile_cols);
+  const int num_workers = VPXMIN(pbi->max_threads, tile_cols);
   TileBuffer tile_buffers[1][1 << 6];
+  TileJobQueue queue;
   int n;
-  int final_worker = -1;
 
   assert(tile_cols <= (1 << 6));
   assert(tile_rows == 1);
   (void)tile_rows;
 
-  // TODO(jzern): See if we can remove the restriction of passing in max
-  // threads to the decoder.
-  if (pbi->num_tile_workers == 0) {
-    const int num_threads = pbi->max_threads & ~1;
-    int i;
-    CHECK_MEM_ERROR(cm, pbi->tile_workers,
-                    vpx_malloc(num_threads * sizeof(*pbi->tile_workers)));
-    // Ensure tile data offsets will be properly aligned. This may fail on
-    // platforms without DECLARE_ALIGNED().
-    assert((sizeof(*pbi->tile_worker_data) % 16) == 0);
-    CHECK_MEM_ERROR(
-        cm, pbi->tile_worker_data,
-        vpx_memalign(32, num_threads * sizeof(*pbi->tile_worker_data)));
-    CHECK_MEM_ERROR(cm, pbi->tile_worker_info,
-                    vpx_malloc(num_threads * sizeof(*pbi->tile_worker_info)));
-    for (i = 0; i < num_threads; ++i) {
-      VPxWorker *const worker = &pbi->tile_workers[i];
-      ++pbi->num_tile_workers;
-
-      winterface->init(worker);
-      if (i < num_threads - 1 && !winterface->reset(worker)) {
-        vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
-                           "Tile decoder thread creation failed");
-      }
-    }
-  }
-
-  // Reset tile decoding hook
-  for (n = 0; n < num_workers; ++n) {
-    VPxWorker *const worker = &pbi->tile_workers[n];
-    winterface->sync(worker);
-    worker->hook = (VPxWorkerHook)tile_worker_hook;
-    worker->data1 = &pbi->tile_worker_data[n];
-    worker->data2 = &pbi->tile_worker_info[n];
-  }
+  init_tile_jobs(pbi);
 
   // Note: this memset assumes above_context[0], [1] and [2]
   // are allocated as part of the same buffer.
@@ -1734,104 +2168,42 @@ static const uint8_t *decode_tiles_mt(VP10Decoder *pbi, const uint8_t *data,
   // Load tile data into tile_buffers
   get_tile_buffers(pbi, data, data_end, tile_cols, tile_rows, tile_buffers);
 
-  // Sort the buffers based on size in descending order.
+  // Sort the buffers based on size in descending order, so that the largest,
+  // and presumably the most difficult, tiles are started first.
   qsort(tile_buffers[0], tile_cols, sizeof(tile_buffers[0][0]),
         compare_tile_buffers);
 
-  // Rearrange the tile buffers such that per-tile group the largest, and
-  // presumably the most difficult, tile will be decoded in the main thread.
-  // This should help minimize the number of instances where the main thread is
-  // waiting for a worker to complete.
-  {
-    int group_start = 0;
-    while (group_start < tile_cols) {
-      const TileBuffer largest = tile_buffers[0][group_start];
-      const int group_end = VPXMIN(group_start + num_workers, tile_cols) - 1;
-      memmove(tile_buffers[0] + group_start, tile_buffers[0] + group_start + 1,
-              (group_end - group_start) * sizeof(tile_buffers[0][0]));
-      tile_buffers[0][group_end] = largest;
-      group_start = group_end + 1;
-    }
+  // Check the tile sizes here, as an error can only be raised on this thread.
+  queue.buffers = tile_buffers[0];
+  queue.num_tiles = tile_cols;
+  queue.bit_reader_end = NULL;
+  for (n = 0; n < tile_cols; ++n) {
+    const TileBuffer *const buf = &tile_buffers[0][n];
+    setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
+                        &queue.bit_readers[n], pbi->decrypt_cb,
+                        pbi->decrypt_state);
   }
 
-  // Initialize thread frame counts.
+  vpx_job_group_init(&pbi->tile_jobs, pbi->thread_pool);
+  for (n = 0; n < num_workers; ++n) {
+    TileWorkerData *const tile_data = &pbi->tile_worker_data[n];
+    tile_data->pbi = pbi;
+    vpx_job_group_submit(&pbi->tile_jobs, (VPxWorkerHook)tile_job_hook,
+                         tile_data, &queue);
+  }
+  // TODO(jzern): The tile may have specific error data associated with
+  // its vpx_internal_error_info which could be propagated to the main info
+  // in cm. Additionally once the threads have been synced and an error is
+  // detected, there's no point in continuing to decode tiles.
+  pbi->mb.corrupted |= !vpx_job_group_wait(&pbi->tile_jobs);
+
+  // Accumulate thread frame counts.
   if (cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
-    int i;
-
-    for (i = 0; i < num_workers; ++i) {
-      TileWorkerData *const tile_data =
-          (TileWorkerData *)pbi->tile_workers[i].data1;
-      vp10_zero(tile_data->counts);
-    }
-  }
-
-  n = 0;
-  while (n < tile_cols) {
-    int i;
-    for (i = 0; i < num_workers && n < tile_cols; ++i) {
-      VPxWorker *const worker = &pbi->tile_workers[i];
-      TileWorkerData *const tile_data = (TileWorkerData *)worker->data1;
-      TileInfo *const tile = (TileInfo *)worker->data2;
-      TileBuffer *const buf = &tile_buffers[0][n];
-
-      tile_data->pbi = pbi;
-      tile_data->xd = pbi->mb;
-      tile_data->xd.corrupted = 0;
-      tile_data->xd.counts =
-          cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD
-              ? &tile_data->counts
-              : NULL;
-      vp10_zero(tile_data->dqcoeff);
-      vp10_tile_init(tile, cm, 0, buf->col);
-      vp10_tile_init(&tile_data->xd.tile, cm, 0, buf->col);
-      setup_token_decoder(buf->data, data_end, buf->size, &cm->error,
-                          &tile_data->bit_reader, pbi->decrypt_cb,
-                          pbi->decrypt_state);
-      vp10_init_macroblockd(cm, &tile_data->xd, tile_data->dqcoeff);
-      tile_data->xd.plane[0].color_index_map = tile_data->color_index_map[0];
-      tile_data->xd.plane[1].color_index_map = tile_data->color_index_map[1];
-
-      worker->had_error = 0;
-      if (i == num_workers - 1 || n == tile_cols - 1) {
-        winterface->execute(worker);
-      } else {
-        winterface->launch(worker);
-      }
-
-      if (buf->col == tile_cols - 1) {
-        final_worker = i;
-      }
-
-      ++n;
-    }
-
-    for (; i > 0; --i) {
-      VPxWorker *const worker = &pbi->tile_workers[i - 1];
-      // TODO(jzern): The tile may have specific error data associated with
-      // its vpx_internal_error_info which could be propagated to the main info
-      // in cm. Additionally once the threads have been synced and an error is
-      // detected, there's no point in continuing to decode tiles.
-      pbi->mb.corrupted |= !winterface->sync(worker);
-    }
-    if (final_worker > -1) {
-      TileWorkerData *const tile_data =
-          (TileWorkerData *)pbi->tile_workers[final_worker].data1;
-      bit_reader_end = vpx_reader_find_end(&tile_data->bit_reader);
-      final_worker = -1;
-    }
-
-    // Accumulate thread frame counts.
-    if (n >= tile_cols &&
-        cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
-      for (i = 0; i < num_workers; ++i) {
-        TileWorkerData *const tile_data =
-            (TileWorkerData *)pbi->tile_workers[i].data1;
-        vp10_accumulate_frame_counts(cm, &tile_data->counts, 1);
-      }
-    }
+    for (n = 0; n < num_workers; ++n)
+      vp10_accumulate_frame_counts(cm, &pbi->tile_worker_data[n].counts, 1);
   }
 
-  return bit_reader_end;
+  return queue.bit_reader_end;
 }
 
 static void error_handler(void *data) {
@@ -2407,13 +2779,9 @@ void vp10_decode_frame(VP10Decoder *pbi, const uint8_t *data,
     // Multi-threaded tile decoder
     *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
     if (!xd->corrupted) {
-      if (!cm->skip_loop_filter) {
-        // If multiple threads are used to decode tiles, then we use those
-        // threads to do parallel loopfiltering.
-        vp10_loop_filter_frame_mt(new_fb, cm, pbi->mb.plane,
-                                  cm->lf.filter_level, 0, 0, pbi->tile_workers,
-                                  pbi->num_tile_workers, &pbi->lf_row_sync);
-      }
+      // If multiple threads are used to decode tiles, then we use those
+      // threads to do parallel loopfiltering, deringing and CLPF.
+      post_filter_frame_mt(pbi);
     } else {
       vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                          "Decode failed. Frame data is corrupted.");
@@ -2422,6 +2790,9 @@ void vp10_decode_frame(VP10Decoder *pbi, const uint8_t *data,
     *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
   }
 
+  if (cm->frame_parallel_decode)
+    vp10_frameworker_broadcast(pbi->cur_buf, INT_MAX);
+
   if (!xd->corrupted) {
     if (cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_BACKWARD) {
       vp10_adapt_coef_probs(cm);
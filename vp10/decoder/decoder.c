@@ -115,8 +115,6 @@ VP10Decoder *vp10_decoder_create(BufferPool *const pool) {
 
   cm->error.setjmp = 0;
 
-  vpx_get_worker_interface()->init(&pbi->lf_worker);
-
   return pbi;
 }
 
@@ -125,24 +123,35 @@ void vp10_decoder_remove(VP10Decoder *pbi) {
 
   if (!pbi) return;
 
-  vpx_get_worker_interface()->end(&pbi->lf_worker);
-  vpx_free(pbi->lf_worker.data1);
+  vpx_job_group_wait(&pbi->lf_job);
+  vpx_job_group_wait(&pbi->tile_jobs);
+  vpx_job_group_wait(&pbi->recon_jobs);
+  vpx_thread_pool_release(pbi->thread_pool);
+  vpx_free(pbi->lf_data);
   vpx_free(pbi->tile_data);
-  for (i = 0; i < pbi->num_tile_workers; ++i) {
-    VPxWorker *const worker = &pbi->tile_workers[i];
-    vpx_get_worker_interface()->end(worker);
-  }
   vpx_free(pbi->tile_worker_data);
-  vpx_free(pbi->tile_worker_info);
-  vpx_free(pbi->tile_workers);
-
-  if (pbi->num_tile_workers > 0) {
-    vp10_loop_filter_dealloc(&pbi->lf_row_sync);
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    vpx_free(pbi->sb_coeffs.dqcoeff[i]);
+    vpx_free(pbi->sb_coeffs.eob[i]);
   }
 
+  vp10_loop_filter_dealloc(&pbi->lf_row_sync);
+  vp10_row_mt_dealloc(&pbi->row_mt_sync);
+#if CONFIG_DERING
+  vp10_dering_dealloc(&pbi->dering_sync);
+#endif
+
   vpx_free(pbi);
 }
 
+void vp10_decoder_set_thread_pool(VP10Decoder *pbi, VPxThreadPool *pool) {
+  vpx_job_group_wait(&pbi->lf_job);
+  vpx_job_group_wait(&pbi->tile_jobs);
+  vpx_job_group_wait(&pbi->recon_jobs);
+  vpx_thread_pool_release(pbi->thread_pool);
+  pbi->thread_pool = vpx_thread_pool_retain(pool);
+}
+
 static int equal_dimensions(const YV12_BUFFER_CONFIG *a,
                             const YV12_BUFFER_CONFIG *b) {
   return a->y_height == b->y_height && a->y_width == b->y_width &&
@@ -318,18 +327,16 @@ int vp10_receive_compressed_data(VP10Decoder *pbi, size_t size,
   }
 
   if (setjmp(cm->error.jmp)) {
-    const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
-    int i;
-
     cm->error.setjmp = 0;
     pbi->ready_for_new_data = 1;
 
     // Synchronize all threads immediately as a subsequent decode call may
-    // cause a resize invalidating some allocations.
-    winterface->sync(&pbi->lf_worker);
-    for (i = 0; i < pbi->num_tile_workers; ++i) {
-      winterface->sync(&pbi->tile_workers[i]);
-    }
+    // cause a resize invalidating some allocations. The reconstruction jobs
+    // wait for the parsing, which has stopped.
+    vp10_row_mt_abort(&pbi->row_mt_sync);
+    vpx_job_group_wait(&pbi->recon_jobs);
+    vpx_job_group_wait(&pbi->lf_job);
+    vpx_job_group_wait(&pbi->tile_jobs);
 
     lock_buffer_pool(pool);
     // Release all the reference buffers if worker thread is holding them.
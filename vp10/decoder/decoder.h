@@ -17,9 +17,13 @@
 #include "vpx_dsp/bitreader.h"
 #include "vpx_scale/yv12config.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #include "vp10/common/thread_common.h"
 #include "vp10/common/onyxc_int.h"
+#if CONFIG_DERING
+#include "vp10/common/dering.h"
+#endif
 #include "vp10/decoder/dthread.h"
 
 #ifdef __cplusplus
@@ -47,6 +51,29 @@ typedef struct TileWorkerData {
   struct vpx_internal_error_info error_info;
 } TileWorkerData;
 
+// The coefficients of the superblocks that are parsed ahead of their
+// reconstruction: those of the frame for the row-based multi-threaded
+// decoder, or those of a superblock row of a tile when parsing ahead. Each
+// superblock has a slot in each plane, which holds the dequantized
+// coefficients and the eob of its transform blocks in decoding order. The
+// reconstruction clears the coefficients it reads.
+typedef struct VP10SbCoeffBuffer {
+  tran_low_t *dqcoeff[MAX_MB_PLANE];
+  uint16_t *eob[MAX_MB_PLANE];
+  int num_sbs;
+  int subsampling_x;
+  int subsampling_y;
+  // Set while the slots may hold coefficients that were parsed and not
+  // reconstructed, which happens when an error stops the frame.
+  int pending;
+} VP10SbCoeffBuffer;
+
+// The place of the next transform block in the slots of a superblock.
+typedef struct VP10SbCoeffs {
+  tran_low_t *dqcoeff[MAX_MB_PLANE];
+  uint16_t *eob[MAX_MB_PLANE];
+} VP10SbCoeffs;
+
 typedef struct VP10Decoder {
   DECLARE_ALIGNED(16, MACROBLOCKD, mb);
 
@@ -61,22 +88,36 @@ typedef struct VP10Decoder {
   RefCntBuffer *cur_buf;  //  Current decoding frame buffer.
 
   VPxWorker *frame_worker_owner;  // frame_worker that owns this pbi.
-  VPxWorker lf_worker;
-  VPxWorker *tile_workers;
+  // The threads that decode the tiles and filter the rows of the frame.
+  VPxThreadPool *thread_pool;
+  // The job that filters the rows behind the single threaded tile decoder.
+  VPxJobGroup lf_job;
+  LFWorkerData *lf_data;
+  VPxJobGroup tile_jobs;
   TileWorkerData *tile_worker_data;
-  TileInfo *tile_worker_info;
   int num_tile_workers;
 
   TileData *tile_data;
   int total_tiles;
 
   VP10LfSync lf_row_sync;
+  // The jobs that reconstruct the superblock rows behind the parsing of the
+  // tiles, when they are not decoded in parallel.
+  VPxJobGroup recon_jobs;
+  VP10RowMtSync row_mt_sync;
+  VP10SbCoeffBuffer sb_coeffs;
+#if CONFIG_DERING
+  VP10DeringSync dering_sync;
+#endif
 
   vpx_decrypt_cb decrypt_cb;
   void *decrypt_state;
 
   int max_threads;
   int inv_tile_order;
+  // Parse each superblock row of a tile before reconstructing it, when the
+  // rows are not reconstructed in parallel.
+  int parse_ahead;
   int need_resync;   // wait for key/intra-only frame.
   int hold_ref_buf;  // hold the reference buffer.
 } VP10Decoder;
@@ -115,6 +156,10 @@ struct VP10Decoder *vp10_decoder_create(BufferPool *const pool);
 
 void vp10_decoder_remove(struct VP10Decoder *pbi);
 
+// Runs the jobs of the decoder on 'pool', holding a reference to it. A NULL
+// pool goes back to the shared pool.
+void vp10_decoder_set_thread_pool(struct VP10Decoder *pbi, VPxThreadPool *pool);
+
 static INLINE void decrease_ref_count(int idx, RefCntBuffer *const frame_bufs,
                                       BufferPool *const pool) {
   if (idx >= 0) {
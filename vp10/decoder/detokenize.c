@@ -37,6 +37,11 @@
     if (counts) ++coef_counts[band][ctx][token]; \
   } while (0)
 
+// The smallest value of each category token, from CATEGORY1_TOKEN.
+static const int16_t cat_min_val[6] = { CAT1_MIN_VAL, CAT2_MIN_VAL,
+                                        CAT3_MIN_VAL, CAT4_MIN_VAL,
+                                        CAT5_MIN_VAL, CAT6_MIN_VAL };
+
 static INLINE int read_coeff(const vpx_prob *probs, int n, vpx_reader *r) {
   int i, val = 0;
   for (i = 0; i < n; ++i) val = (val << 1) | vpx_read(r, probs[i]);
@@ -73,12 +78,15 @@ static int decode_coefs(const MACROBLOCKD *xd, PLANE_TYPE type,
   const int dq_shift = (tx_size == TX_32X32);
   int v, token;
   int16_t dqv = dq[0];
-  const uint8_t *cat1_prob;
-  const uint8_t *cat2_prob;
-  const uint8_t *cat3_prob;
-  const uint8_t *cat4_prob;
-  const uint8_t *cat5_prob;
-  const uint8_t *cat6_prob;
+  // The probabilities and the number of the extra bits of each category
+  // token, from CATEGORY1_TOKEN.
+  const uint8_t *cat_probs[6];
+  int cat_bits[6] = { 1, 2, 3, 4, 5, 14 };
+#if CONFIG_MISC_FIXES
+  const int skip_bits = TX_SIZES - 1 - tx_size;
+#else
+  const int skip_bits = 0;
+#endif
 
   if (counts) {
     coef_counts = counts->coef[tx_size][type][ref];
@@ -88,36 +96,41 @@ static int decode_coefs(const MACROBLOCKD *xd, PLANE_TYPE type,
 #if CONFIG_VPX_HIGHBITDEPTH
   if (xd->bd > VPX_BITS_8) {
     if (xd->bd == VPX_BITS_10) {
-      cat1_prob = vp10_cat1_prob_high10;
-      cat2_prob = vp10_cat2_prob_high10;
-      cat3_prob = vp10_cat3_prob_high10;
-      cat4_prob = vp10_cat4_prob_high10;
-      cat5_prob = vp10_cat5_prob_high10;
-      cat6_prob = vp10_cat6_prob_high10;
+      cat_probs[0] = vp10_cat1_prob_high10;
+      cat_probs[1] = vp10_cat2_prob_high10;
+      cat_probs[2] = vp10_cat3_prob_high10;
+      cat_probs[3] = vp10_cat4_prob_high10;
+      cat_probs[4] = vp10_cat5_prob_high10;
+      cat_probs[5] = vp10_cat6_prob_high10;
+      cat_bits[5] = 16;
     } else {
-      cat1_prob = vp10_cat1_prob_high12;
-      cat2_prob = vp10_cat2_prob_high12;
-      cat3_prob = vp10_cat3_prob_high12;
-      cat4_prob = vp10_cat4_prob_high12;
-      cat5_prob = vp10_cat5_prob_high12;
-      cat6_prob = vp10_cat6_prob_high12;
+      assert(xd->bd == VPX_BITS_12);
+      cat_probs[0] = vp10_cat1_prob_high12;
+      cat_probs[1] = vp10_cat2_prob_high12;
+      cat_probs[2] = vp10_cat3_prob_high12;
+      cat_probs[3] = vp10_cat4_prob_high12;
+      cat_probs[4] = vp10_cat5_prob_high12;
+      cat_probs[5] = vp10_cat6_prob_high12;
+      cat_bits[5] = 18;
     }
   } else {
-    cat1_prob = vp10_cat1_prob;
-    cat2_prob = vp10_cat2_prob;
-    cat3_prob = vp10_cat3_prob;
-    cat4_prob = vp10_cat4_prob;
-    cat5_prob = vp10_cat5_prob;
-    cat6_prob = vp10_cat6_prob;
+    cat_probs[0] = vp10_cat1_prob;
+    cat_probs[1] = vp10_cat2_prob;
+    cat_probs[2] = vp10_cat3_prob;
+    cat_probs[3] = vp10_cat4_prob;
+    cat_probs[4] = vp10_cat5_prob;
+    cat_probs[5] = vp10_cat6_prob;
   }
 #else
-  cat1_prob = vp10_cat1_prob;
-  cat2_prob = vp10_cat2_prob;
-  cat3_prob = vp10_cat3_prob;
-  cat4_prob = vp10_cat4_prob;
-  cat5_prob = vp10_cat5_prob;
-  cat6_prob = vp10_cat6_prob;
+  cat_probs[0] = vp10_cat1_prob;
+  cat_probs[1] = vp10_cat2_prob;
+  cat_probs[2] = vp10_cat3_prob;
+  cat_probs[3] = vp10_cat4_prob;
+  cat_probs[4] = vp10_cat5_prob;
+  cat_probs[5] = vp10_cat6_prob;
 #endif
+  cat_probs[5] += skip_bits;
+  cat_bits[5] -= skip_bits;
 
   while (c < max_eob) {
     int val = -1;
@@ -148,50 +161,11 @@ static int decode_coefs(const MACROBLOCKD *xd, PLANE_TYPE type,
       INCREMENT_COUNT(TWO_TOKEN);
       token = vpx_read_tree(r, vp10_coef_con_tree,
                             vp10_pareto8_full[prob[PIVOT_NODE] - 1]);
-      switch (token) {
-        case TWO_TOKEN:
-        case THREE_TOKEN:
-        case FOUR_TOKEN: val = token; break;
-        case CATEGORY1_TOKEN:
-          val = CAT1_MIN_VAL + read_coeff(cat1_prob, 1, r);
-          break;
-        case CATEGORY2_TOKEN:
-          val = CAT2_MIN_VAL + read_coeff(cat2_prob, 2, r);
-          break;
-        case CATEGORY3_TOKEN:
-          val = CAT3_MIN_VAL + read_coeff(cat3_prob, 3, r);
-          break;
-        case CATEGORY4_TOKEN:
-          val = CAT4_MIN_VAL + read_coeff(cat4_prob, 4, r);
-          break;
-        case CATEGORY5_TOKEN:
-          val = CAT5_MIN_VAL + read_coeff(cat5_prob, 5, r);
-          break;
-        case CATEGORY6_TOKEN: {
-#if CONFIG_MISC_FIXES
-          const int skip_bits = TX_SIZES - 1 - tx_size;
-#else
-          const int skip_bits = 0;
-#endif
-          const uint8_t *cat6p = cat6_prob + skip_bits;
-#if CONFIG_VPX_HIGHBITDEPTH
-          switch (xd->bd) {
-            case VPX_BITS_8:
-              val = CAT6_MIN_VAL + read_coeff(cat6p, 14 - skip_bits, r);
-              break;
-            case VPX_BITS_10:
-              val = CAT6_MIN_VAL + read_coeff(cat6p, 16 - skip_bits, r);
-              break;
-            case VPX_BITS_12:
-              val = CAT6_MIN_VAL + read_coeff(cat6p, 18 - skip_bits, r);
-              break;
-            default: assert(0); return -1;
-          }
-#else
-          val = CAT6_MIN_VAL + read_coeff(cat6p, 14 - skip_bits, r);
-#endif
-          break;
-        }
+      if (token < CATEGORY1_TOKEN) {
+        val = token;
+      } else {
+        const int cat = token - CATEGORY1_TOKEN;
+        val = cat_min_val[cat] + read_coeff(cat_probs[cat], cat_bits[cat], r);
       }
     }
 #if CONFIG_AOM_QM
@@ -56,6 +56,8 @@ void vp10_frameworker_signal_stats(VPxWorker *const worker) {
 #if __has_feature(thread_sanitizer)
 #define BUILDING_WITH_TSAN
 #endif
+#elif defined(__SANITIZE_THREAD__)
+#define BUILDING_WITH_TSAN
 #endif
 
 // TODO(hkuang): Remove worker parameter as it is only used in debug code.
@@ -188,3 +190,115 @@ void vp10_frameworker_copy_context(VPxWorker *const dst_worker,
   (void)src_worker;
 #endif  // CONFIG_MULTITHREAD
 }
+
+void vp10_row_mt_alloc(VP10RowMtSync *row_mt_sync, VP10_COMMON *cm, int rows,
+                       int cols) {
+  row_mt_sync->rows = rows;
+  row_mt_sync->cols = cols;
+#if CONFIG_MULTITHREAD
+  {
+    int i;
+
+    pthread_mutex_init(&row_mt_sync->mutex, NULL);
+    CHECK_MEM_ERROR(cm, row_mt_sync->cond_,
+                    vpx_malloc(sizeof(*row_mt_sync->cond_) * rows));
+    if (row_mt_sync->cond_) {
+      for (i = 0; i < rows; ++i) {
+        pthread_cond_init(&row_mt_sync->cond_[i], NULL);
+      }
+    }
+  }
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->parsed,
+                  vpx_malloc(sizeof(*row_mt_sync->parsed) * rows));
+  CHECK_MEM_ERROR(cm, row_mt_sync->reconstructed,
+                  vpx_malloc(sizeof(*row_mt_sync->reconstructed) * rows));
+}
+
+void vp10_row_mt_dealloc(VP10RowMtSync *row_mt_sync) {
+  if (row_mt_sync != NULL) {
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (row_mt_sync->cond_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_cond_destroy(&row_mt_sync->cond_[i]);
+      }
+      vpx_free(row_mt_sync->cond_);
+      pthread_mutex_destroy(&row_mt_sync->mutex);
+    }
+#endif  // CONFIG_MULTITHREAD
+    vpx_free(row_mt_sync->parsed);
+    vpx_free(row_mt_sync->reconstructed);
+    // clear the structure as the source of this call may be a resize in which
+    // case this call will be followed by an _alloc() which may fail.
+    vp10_zero(*row_mt_sync);
+  }
+}
+
+void vp10_row_mt_init(VP10RowMtSync *row_mt_sync) {
+  memset(row_mt_sync->parsed, 0,
+         sizeof(*row_mt_sync->parsed) * row_mt_sync->rows);
+  memset(row_mt_sync->reconstructed, 0,
+         sizeof(*row_mt_sync->reconstructed) * row_mt_sync->rows);
+  row_mt_sync->aborted = 0;
+}
+
+void vp10_row_mt_set_parsed(VP10RowMtSync *row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&row_mt_sync->mutex);
+  row_mt_sync->parsed[r] = c + 1;
+  pthread_cond_signal(&row_mt_sync->cond_[r]);
+  pthread_mutex_unlock(&row_mt_sync->mutex);
+#else
+  row_mt_sync->parsed[r] = c + 1;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp10_row_mt_set_reconstructed(VP10RowMtSync *row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&row_mt_sync->mutex);
+  row_mt_sync->reconstructed[r] = c + 1;
+  if (r + 1 < row_mt_sync->rows)
+    pthread_cond_signal(&row_mt_sync->cond_[r + 1]);
+  pthread_mutex_unlock(&row_mt_sync->mutex);
+#else
+  row_mt_sync->reconstructed[r] = c + 1;
+#endif  // CONFIG_MULTITHREAD
+}
+
+int vp10_row_mt_wait(VP10RowMtSync *row_mt_sync, int r, int c) {
+  // Intra prediction reads above and to the right of the superblock.
+  const int above = VPXMIN(c + 1, row_mt_sync->cols - 1);
+  int ready;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&row_mt_sync->mutex);
+  while (!row_mt_sync->aborted &&
+         (row_mt_sync->parsed[r] <= c ||
+          (r > 0 && row_mt_sync->reconstructed[r - 1] <= above))) {
+    pthread_cond_wait(&row_mt_sync->cond_[r], &row_mt_sync->mutex);
+  }
+  ready = !row_mt_sync->aborted;
+  pthread_mutex_unlock(&row_mt_sync->mutex);
+#else
+  ready = row_mt_sync->parsed[r] > c &&
+          (r == 0 || row_mt_sync->reconstructed[r - 1] > above);
+#endif  // CONFIG_MULTITHREAD
+  return ready;
+}
+
+void vp10_row_mt_abort(VP10RowMtSync *row_mt_sync) {
+#if CONFIG_MULTITHREAD
+  int i;
+
+  if (row_mt_sync->cond_ == NULL) return;
+  pthread_mutex_lock(&row_mt_sync->mutex);
+  row_mt_sync->aborted = 1;
+  for (i = 0; i < row_mt_sync->rows; ++i)
+    pthread_cond_signal(&row_mt_sync->cond_[i]);
+  pthread_mutex_unlock(&row_mt_sync->mutex);
+#else
+  row_mt_sync->aborted = 1;
+#endif  // CONFIG_MULTITHREAD
+}
@@ -52,21 +52,61 @@ void vp10_frameworker_lock_stats(VPxWorker *const worker);
 void vp10_frameworker_unlock_stats(VPxWorker *const worker);
 void vp10_frameworker_signal_stats(VPxWorker *const worker);
 
-// Wait until ref_buf has been decoded to row in real pixel unit.
+// Wait until the first 'row' luma pixel rows of ref_buf are final.
 // Note: worker may already finish decoding ref_buf and release it in order to
 // start decoding next frame. So need to check whether worker is still decoding
 // ref_buf.
 void vp10_frameworker_wait(VPxWorker *const worker, RefCntBuffer *const ref_buf,
                            int row);
 
-// FrameWorker broadcasts its decoding progress so other workers that are
-// waiting on it can resume decoding.
+// FrameWorker broadcasts its decoding progress, the number of luma pixel
+// rows of buf that are final, so other workers that are waiting on it can
+// resume decoding.
 void vp10_frameworker_broadcast(RefCntBuffer *const buf, int row);
 
 // Copy necessary decoding context from src worker to dst worker.
 void vp10_frameworker_copy_context(VPxWorker *const dst_worker,
                                    VPxWorker *const src_worker);
 
+// Superblock row synchronization of the row-based multi-threaded decoder, in
+// which the tile decoder parses the superblocks ahead of the jobs that
+// reconstruct them.
+typedef struct VP10RowMtSync {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+  // cond_[r] wakes the job reconstructing row r.
+  pthread_cond_t *cond_;
+#endif
+  // The number of superblocks parsed and reconstructed in each row.
+  int *parsed;
+  int *reconstructed;
+  int rows;
+  int cols;
+  // Set when the parsing stops on an error, to release the waiting jobs.
+  int aborted;
+} VP10RowMtSync;
+
+// Allocate the synchronization of a frame of rows x cols superblocks.
+void vp10_row_mt_alloc(VP10RowMtSync *row_mt_sync, struct VP10Common *cm,
+                       int rows, int cols);
+
+void vp10_row_mt_dealloc(VP10RowMtSync *row_mt_sync);
+
+// Resets the progress for a new frame.
+void vp10_row_mt_init(VP10RowMtSync *row_mt_sync);
+
+void vp10_row_mt_set_parsed(VP10RowMtSync *row_mt_sync, int r, int c);
+
+void vp10_row_mt_set_reconstructed(VP10RowMtSync *row_mt_sync, int r, int c);
+
+// Waits until superblock (r, c) is parsed and the row above is reconstructed
+// past it, as far as intra prediction reads. Returns 0 if the parsing was
+// aborted.
+int vp10_row_mt_wait(VP10RowMtSync *row_mt_sync, int r, int c);
+
+// Releases the jobs waiting for the parsing, which is not going to go on.
+void vp10_row_mt_abort(VP10RowMtSync *row_mt_sync);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
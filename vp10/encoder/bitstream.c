@@ -36,6 +36,7 @@
 #include "vp10/encoder/cost.h"
 #include "vp10/encoder/bitstream.h"
 #include "vp10/encoder/encodemv.h"
+#include "vp10/encoder/ethread.h"
 #include "vp10/encoder/mcomp.h"
 #include "vp10/encoder/segmentation.h"
 #include "vp10/encoder/subexp.h"
@@ -319,11 +320,12 @@ static void write_ref_frames(const VP10_COMMON *cm, const MACROBLOCKD *xd,
   }
 }
 
-static void pack_inter_mode_mvs(VP10_COMP *cpi, const MODE_INFO *mi,
-                                vpx_writer *w) {
+static void pack_inter_mode_mvs(VP10_COMP *cpi, const MACROBLOCK *const x,
+                                const MODE_INFO *mi, vpx_writer *w,
+                                unsigned int *const max_mv_magnitude,
+                                int *const interp_filter_selected) {
   VP10_COMMON *const cm = &cpi->common;
   const nmv_context *nmvc = &cm->fc->nmvc;
-  const MACROBLOCK *const x = &cpi->td.mb;
   const MACROBLOCKD *const xd = &x->e_mbd;
   const struct segmentation *const seg = &cm->seg;
 #if CONFIG_MISC_FIXES
@@ -394,7 +396,7 @@ static void pack_inter_mode_mvs(VP10_COMP *cpi, const MODE_INFO *mi,
       vp10_write_token(w, vp10_switchable_interp_tree,
                        cm->fc->switchable_interp_prob[ctx],
                        &switchable_interp_encodings[mbmi->interp_filter]);
-      ++cpi->interp_filter_selected[0][mbmi->interp_filter];
+      ++interp_filter_selected[mbmi->interp_filter];
     } else {
       assert(mbmi->interp_filter == cm->interp_filter);
     }
@@ -412,7 +414,7 @@ static void pack_inter_mode_mvs(VP10_COMP *cpi, const MODE_INFO *mi,
             for (ref = 0; ref < 1 + is_compound; ++ref)
               vp10_encode_mv(cpi, w, &mi->bmi[j].as_mv[ref].as_mv,
                              &mbmi_ext->ref_mvs[mbmi->ref_frame[ref]][0].as_mv,
-                             nmvc, allow_hp);
+                             nmvc, allow_hp, max_mv_magnitude);
           }
         }
       }
@@ -421,7 +423,7 @@ static void pack_inter_mode_mvs(VP10_COMP *cpi, const MODE_INFO *mi,
         for (ref = 0; ref < 1 + is_compound; ++ref)
           vp10_encode_mv(cpi, w, &mbmi->mv[ref].as_mv,
                          &mbmi_ext->ref_mvs[mbmi->ref_frame[ref]][0].as_mv,
-                         nmvc, allow_hp);
+                         nmvc, allow_hp, max_mv_magnitude);
       }
     }
   }
@@ -494,19 +496,21 @@ static void write_mb_modes_kf(const VP10_COMMON *cm, const MACROBLOCKD *xd,
   }
 }
 
-static void write_modes_b(VP10_COMP *cpi, const TileInfo *const tile,
-                          vpx_writer *w, TOKENEXTRA **tok,
-                          const TOKENEXTRA *const tok_end, int mi_row,
-                          int mi_col) {
+static void write_modes_b(VP10_COMP *cpi, MACROBLOCK *const x,
+                          const TileInfo *const tile, vpx_writer *w,
+                          TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
+                          int mi_row, int mi_col,
+                          unsigned int *const max_mv_magnitude,
+                          int *const interp_filter_selected) {
   const VP10_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &x->e_mbd;
   MODE_INFO *m;
   int plane;
 
   xd->mi = cm->mi_grid_visible + (mi_row * cm->mi_stride + mi_col);
   m = xd->mi[0];
 
-  cpi->td.mb.mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
+  x->mbmi_ext = cpi->mbmi_ext_base + (mi_row * cm->mi_cols + mi_col);
 
   set_mi_row_col(xd, tile, mi_row, num_8x8_blocks_high_lookup[m->mbmi.sb_type],
                  mi_col, num_8x8_blocks_wide_lookup[m->mbmi.sb_type],
@@ -514,7 +518,8 @@ static void write_modes_b(VP10_COMP *cpi, const TileInfo *const tile,
   if (frame_is_intra_only(cm)) {
     write_mb_modes_kf(cm, xd, xd->mi, w);
   } else {
-    pack_inter_mode_mvs(cpi, m, w);
+    pack_inter_mode_mvs(cpi, x, m, w, max_mv_magnitude,
+                        interp_filter_selected);
   }
 
   if (!m->mbmi.skip) {
@@ -551,12 +556,14 @@ static void write_partition(const VP10_COMMON *const cm,
   }
 }
 
-static void write_modes_sb(VP10_COMP *cpi, const TileInfo *const tile,
-                           vpx_writer *w, TOKENEXTRA **tok,
-                           const TOKENEXTRA *const tok_end, int mi_row,
-                           int mi_col, BLOCK_SIZE bsize) {
+static void write_modes_sb(VP10_COMP *cpi, MACROBLOCK *const x,
+                           const TileInfo *const tile, vpx_writer *w,
+                           TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
+                           int mi_row, int mi_col, BLOCK_SIZE bsize,
+                           unsigned int *const max_mv_magnitude,
+                           int *const interp_filter_selected) {
   const VP10_COMMON *const cm = &cpi->common;
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  MACROBLOCKD *const xd = &x->e_mbd;
 
   const int bsl = b_width_log2_lookup[bsize];
   const int bs = (1 << bsl) / 4;
@@ -572,30 +579,37 @@ static void write_modes_sb(VP10_COMP *cpi, const TileInfo *const tile,
   write_partition(cm, xd, bs, mi_row, mi_col, partition, bsize, w);
   subsize = get_subsize(bsize, partition);
   if (subsize < BLOCK_8X8) {
-    write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+    write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row, mi_col,
+                  max_mv_magnitude, interp_filter_selected);
   } else {
     switch (partition) {
       case PARTITION_NONE:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row, mi_col,
+                      max_mv_magnitude, interp_filter_selected);
         break;
       case PARTITION_HORZ:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row, mi_col,
+                      max_mv_magnitude, interp_filter_selected);
         if (mi_row + bs < cm->mi_rows)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col);
+          write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row + bs, mi_col,
+                        max_mv_magnitude, interp_filter_selected);
         break;
       case PARTITION_VERT:
-        write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col);
+        write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row, mi_col,
+                      max_mv_magnitude, interp_filter_selected);
         if (mi_col + bs < cm->mi_cols)
-          write_modes_b(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs);
+          write_modes_b(cpi, x, tile, w, tok, tok_end, mi_row, mi_col + bs,
+                        max_mv_magnitude, interp_filter_selected);
         break;
       case PARTITION_SPLIT:
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col + bs,
-                       subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col,
-                       subsize);
-        write_modes_sb(cpi, tile, w, tok, tok_end, mi_row + bs, mi_col + bs,
-                       subsize);
+        write_modes_sb(cpi, x, tile, w, tok, tok_end, mi_row, mi_col, subsize,
+                       max_mv_magnitude, interp_filter_selected);
+        write_modes_sb(cpi, x, tile, w, tok, tok_end, mi_row, mi_col + bs,
+                       subsize, max_mv_magnitude, interp_filter_selected);
+        write_modes_sb(cpi, x, tile, w, tok, tok_end, mi_row + bs, mi_col,
+                       subsize, max_mv_magnitude, interp_filter_selected);
+        write_modes_sb(cpi, x, tile, w, tok, tok_end, mi_row + bs, mi_col + bs,
+                       subsize, max_mv_magnitude, interp_filter_selected);
         break;
       default: assert(0);
     }
@@ -616,10 +630,12 @@ static void write_modes_sb(VP10_COMP *cpi, const TileInfo *const tile,
 #endif
 }
 
-static void write_modes(VP10_COMP *cpi, const TileInfo *const tile,
-                        vpx_writer *w, TOKENEXTRA **tok,
-                        const TOKENEXTRA *const tok_end) {
-  MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+static void write_modes(VP10_COMP *cpi, MACROBLOCK *const x,
+                        const TileInfo *const tile, vpx_writer *w,
+                        TOKENEXTRA **tok, const TOKENEXTRA *const tok_end,
+                        unsigned int *const max_mv_magnitude,
+                        int *const interp_filter_selected) {
+  MACROBLOCKD *const xd = &x->e_mbd;
   int mi_row, mi_col;
 
   for (mi_row = tile->mi_row_start; mi_row < tile->mi_row_end;
@@ -627,7 +643,8 @@ static void write_modes(VP10_COMP *cpi, const TileInfo *const tile,
     vp10_zero(xd->left_seg_context);
     for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
          mi_col += MI_BLOCK_SIZE)
-      write_modes_sb(cpi, tile, w, tok, tok_end, mi_row, mi_col, BLOCK_64X64);
+      write_modes_sb(cpi, x, tile, w, tok, tok_end, mi_row, mi_col,
+                     BLOCK_64X64, max_mv_magnitude, interp_filter_selected);
   }
 }
 
@@ -1098,12 +1115,144 @@ static int get_refresh_mask(VP10_COMP *cpi) {
   }
 }
 
+// Writes the modes and tokens of one tile to 'dest' and returns the number of
+// bytes written.
+static size_t write_tile(VP10_COMP *cpi, MACROBLOCK *const x, int tile_row,
+                         int tile_col, uint8_t *dest,
+                         unsigned int *const max_mv_magnitude,
+                         int *const interp_filter_selected) {
+  const VP10_COMMON *const cm = &cpi->common;
+  const int tile_idx = tile_row * (1 << cm->log2_tile_cols) + tile_col;
+  TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col];
+  const TOKENEXTRA *const tok_end = tok + cpi->tok_count[tile_row][tile_col];
+  vpx_writer residual_bc;
+
+  vpx_start_encode(&residual_bc, dest);
+  write_modes(cpi, x, &cpi->tile_data[tile_idx].tile_info, &residual_bc, &tok,
+              tok_end, max_mv_magnitude, interp_filter_selected);
+  assert(tok == tok_end);
+  vpx_stop_encode(&residual_bc);
+  return residual_bc.pos;
+}
+
+// Returns a bound on the bytes a tile column 'mi_cols' wide can take, from
+// the same per pixel allowance the encoder makes for a whole frame.
+static size_t get_tile_col_buf_size(const VP10_COMMON *cm, int mi_cols) {
+  const int ss = cm->subsampling_x + cm->subsampling_y;
+  size_t size = (size_t)(mi_cols * MI_SIZE) * (cm->mi_rows * MI_SIZE) *
+                (2 + (4 >> ss));
+#if CONFIG_VPX_HIGHBITDEPTH
+  if (cm->use_highbitdepth) size *= 2;
+#endif
+  return size + 4096;
+}
+
+static void alloc_tile_col_bufs(VP10_COMP *cpi) {
+  VP10_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  int tile_col;
+
+  if (cpi->tile_col_buf == NULL) {
+    CHECK_MEM_ERROR(cm, cpi->tile_col_buf,
+                    vpx_calloc(1 << 6, sizeof(*cpi->tile_col_buf)));
+  }
+
+  for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+    VP10TileColBuffer *const buf = &cpi->tile_col_buf[tile_col];
+    const TileInfo *const tile = &cpi->tile_data[tile_col].tile_info;
+    const size_t size =
+        get_tile_col_buf_size(cm, tile->mi_col_end - tile->mi_col_start);
+
+    if (buf->data_size < size) {
+      vpx_free(buf->data);
+      buf->data_size = 0;
+      CHECK_MEM_ERROR(cm, buf->data, vpx_malloc(size));
+      buf->data_size = size;
+    }
+  }
+}
+
+void vp10_free_tile_col_bufs(VP10_COMP *cpi) {
+  int tile_col;
+
+  if (cpi->tile_col_buf == NULL) return;
+  for (tile_col = 0; tile_col < 1 << 6; ++tile_col)
+    vpx_free(cpi->tile_col_buf[tile_col].data);
+  vpx_free(cpi->tile_col_buf);
+  cpi->tile_col_buf = NULL;
+}
+
+void vp10_pack_tile_col(VP10_COMP *cpi, ThreadData *td, int tile_col) {
+  const VP10_COMMON *const cm = &cpi->common;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  VP10TileColBuffer *const buf = &cpi->tile_col_buf[tile_col];
+  size_t pos = 0;
+  int tile_row;
+
+  buf->max_mv_magnitude = 0;
+  vp10_zero(buf->interp_filter_selected);
+
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    buf->tile_sz[tile_row] =
+        write_tile(cpi, &td->mb, tile_row, tile_col, buf->data + pos,
+                   &buf->max_mv_magnitude, buf->interp_filter_selected);
+    pos += buf->tile_sz[tile_row];
+    assert(pos <= buf->data_size);
+  }
+}
+
+// Lays the tiles packed by the column workers out in raster order, each but
+// the last preceded by its size, which is the layout encode_tiles() writes
+// directly when it runs on one thread.
+static size_t copy_tile_cols(VP10_COMP *cpi, uint8_t *data_ptr,
+                             unsigned int *max_tile_sz) {
+  VP10_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  size_t col_pos[1 << 6] = { 0 };
+  size_t total_size = 0;
+  unsigned int max_tile = 0;
+  int tile_row, tile_col, i;
+
+  for (tile_row = 0; tile_row < tile_rows; tile_row++) {
+    for (tile_col = 0; tile_col < tile_cols; tile_col++) {
+      const VP10TileColBuffer *const buf = &cpi->tile_col_buf[tile_col];
+      const size_t tile_sz = buf->tile_sz[tile_row];
+
+      if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1) {
+        // size of this tile
+        const unsigned int sz = (unsigned int)tile_sz - CONFIG_MISC_FIXES;
+        assert(tile_sz > 0);
+        mem_put_le32(data_ptr + total_size, sz);
+        max_tile = max_tile > sz ? max_tile : sz;
+        total_size += 4;
+      }
+
+      memcpy(data_ptr + total_size, buf->data + col_pos[tile_col], tile_sz);
+      col_pos[tile_col] += tile_sz;
+      total_size += tile_sz;
+    }
+  }
+
+  // The counts the columns kept are folded in as if the tiles had been
+  // written here.
+  for (tile_col = 0; tile_col < tile_cols; tile_col++) {
+    const VP10TileColBuffer *const buf = &cpi->tile_col_buf[tile_col];
+    cpi->max_mv_magnitude =
+        VPXMAX(cpi->max_mv_magnitude, buf->max_mv_magnitude);
+    for (i = 0; i < SWITCHABLE; ++i)
+      cpi->interp_filter_selected[0][i] += buf->interp_filter_selected[i];
+  }
+
+  *max_tile_sz = max_tile;
+
+  return total_size;
+}
+
 static size_t encode_tiles(VP10_COMP *cpi, uint8_t *data_ptr,
                            unsigned int *max_tile_sz) {
   VP10_COMMON *const cm = &cpi->common;
-  vpx_writer residual_bc;
   int tile_row, tile_col;
-  TOKENEXTRA *tok_end;
   size_t total_size = 0;
   const int tile_cols = 1 << cm->log2_tile_cols;
   const int tile_rows = 1 << cm->log2_tile_rows;
@@ -1112,35 +1261,38 @@ static size_t encode_tiles(VP10_COMP *cpi, uint8_t *data_ptr,
   memset(cm->above_seg_context, 0,
          sizeof(*cm->above_seg_context) * mi_cols_aligned_to_sb(cm->mi_cols));
 
+  // The tile columns share no context, so they are packed in parallel, each
+  // into its own buffer.
+  if (cpi->oxcf.max_threads > 1 && tile_cols > 1) {
+    alloc_tile_col_bufs(cpi);
+    vp10_pack_tile_cols_mt(cpi);
+    return copy_tile_cols(cpi, data_ptr, max_tile_sz);
+  }
+
   for (tile_row = 0; tile_row < tile_rows; tile_row++) {
     for (tile_col = 0; tile_col < tile_cols; tile_col++) {
-      int tile_idx = tile_row * tile_cols + tile_col;
-      TOKENEXTRA *tok = cpi->tile_tok[tile_row][tile_col];
-
-      tok_end = cpi->tile_tok[tile_row][tile_col] +
-                cpi->tok_count[tile_row][tile_col];
+      size_t tile_sz;
 
-      if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1)
-        vpx_start_encode(&residual_bc, data_ptr + total_size + 4);
-      else
-        vpx_start_encode(&residual_bc, data_ptr + total_size);
-
-      write_modes(cpi, &cpi->tile_data[tile_idx].tile_info, &residual_bc, &tok,
-                  tok_end);
-      assert(tok == tok_end);
-      vpx_stop_encode(&residual_bc);
       if (tile_col < tile_cols - 1 || tile_row < tile_rows - 1) {
-        unsigned int tile_sz;
+        unsigned int sz;
+
+        tile_sz = write_tile(cpi, &cpi->td.mb, tile_row, tile_col,
+                             data_ptr + total_size + 4, &cpi->max_mv_magnitude,
+                             cpi->interp_filter_selected[0]);
 
         // size of this tile
-        assert(residual_bc.pos > 0);
-        tile_sz = residual_bc.pos - CONFIG_MISC_FIXES;
-        mem_put_le32(data_ptr + total_size, tile_sz);
-        max_tile = max_tile > tile_sz ? max_tile : tile_sz;
+        assert(tile_sz > 0);
+        sz = (unsigned int)tile_sz - CONFIG_MISC_FIXES;
+        mem_put_le32(data_ptr + total_size, sz);
+        max_tile = max_tile > sz ? max_tile : sz;
         total_size += 4;
+      } else {
+        tile_sz = write_tile(cpi, &cpi->td.mb, tile_row, tile_col,
+                             data_ptr + total_size, &cpi->max_mv_magnitude,
+                             cpi->interp_filter_selected[0]);
       }
 
-      total_size += residual_bc.pos;
+      total_size += tile_sz;
     }
   }
   *max_tile_sz = max_tile;
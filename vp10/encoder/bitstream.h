@@ -17,9 +17,29 @@ extern "C" {
 
 #include "vp10/encoder/encoder.h"
 
+// The tiles of one column packed by vp10_pack_tile_col(). Tile columns share
+// no context, so each one is packed into a buffer of its own and the tiles are
+// copied into the frame once all columns are done.
+typedef struct VP10TileColBuffer {
+  uint8_t *data;
+  size_t data_size;
+  // The size of each tile of the column, in tile row order.
+  size_t tile_sz[4];
+  // What packing the column added to cpi->max_mv_magnitude and
+  // cpi->interp_filter_selected[0].
+  unsigned int max_mv_magnitude;
+  int interp_filter_selected[SWITCHABLE];
+} VP10TileColBuffer;
+
 void vp10_encode_token_init();
 void vp10_pack_bitstream(VP10_COMP *const cpi, uint8_t *dest, size_t *size);
 
+// Packs the tiles of column 'tile_col' into cpi->tile_col_buf[tile_col] using
+// the block state in 'td'.
+void vp10_pack_tile_col(VP10_COMP *cpi, ThreadData *td, int tile_col);
+
+void vp10_free_tile_col_bufs(VP10_COMP *cpi);
+
 static INLINE int vp10_preserve_existing_gf(VP10_COMP *cpi) {
   return !cpi->multi_arf_allowed && cpi->refresh_golden_frame &&
          cpi->rc.is_src_frame_alt_ref;
@@ -1140,6 +1140,84 @@ void vp10_fdct8x8_quant_c(const int16_t *input, int stride,
   *eob_ptr = eob + 1;
 }
 
+// The remaining sizes pair the transform with the matching quantizer. Both
+// halves go through the run time dispatch, so the builds without a fused
+// kernel still use the SIMD transforms and quantizers. The coefficients are
+// still written out for optimize_b().
+void vp10_fdct4x4_quant_c(const int16_t *input, int stride,
+                          tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                          int skip_block, const int16_t *zbin_ptr,
+                          const int16_t *round_ptr, const int16_t *quant_ptr,
+                          const int16_t *quant_shift_ptr,
+                          tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                          const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                          const int16_t *scan, const int16_t *iscan
+#if CONFIG_AOM_QM
+                          ,
+                          const qm_val_t *qm_ptr, const qm_val_t *iqm_ptr
+#endif
+                          ) {
+  vpx_fdct4x4(input, coeff_ptr, stride);
+  vp10_quantize_fp(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                   quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                   dequant_ptr, eob_ptr, scan,
+#if !CONFIG_AOM_QM
+                   iscan);
+#else
+                   iscan, qm_ptr, iqm_ptr);
+#endif
+}
+
+void vp10_fdct16x16_quant_c(const int16_t *input, int stride,
+                            tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                            int skip_block, const int16_t *zbin_ptr,
+                            const int16_t *round_ptr, const int16_t *quant_ptr,
+                            const int16_t *quant_shift_ptr,
+                            tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                            const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                            const int16_t *scan, const int16_t *iscan
+#if CONFIG_AOM_QM
+                            ,
+                            const qm_val_t *qm_ptr, const qm_val_t *iqm_ptr
+#endif
+                            ) {
+  vpx_fdct16x16(input, coeff_ptr, stride);
+  vp10_quantize_fp(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                   quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                   dequant_ptr, eob_ptr, scan,
+#if !CONFIG_AOM_QM
+                   iscan);
+#else
+                   iscan, qm_ptr, iqm_ptr);
+#endif
+}
+
+void vp10_fdct32x32_rd_quant_c(const int16_t *input, int stride,
+                               tran_low_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *zbin_ptr,
+                               const int16_t *round_ptr,
+                               const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               tran_low_t *qcoeff_ptr,
+                               tran_low_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                               const int16_t *scan, const int16_t *iscan
+#if CONFIG_AOM_QM
+                               ,
+                               const qm_val_t *qm_ptr, const qm_val_t *iqm_ptr
+#endif
+                               ) {
+  vpx_fdct32x32_rd(input, coeff_ptr, stride);
+  vp10_quantize_fp_32x32(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                         quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                         dequant_ptr, eob_ptr, scan,
+#if !CONFIG_AOM_QM
+                         iscan);
+#else
+                         iscan, qm_ptr, iqm_ptr);
+#endif
+}
+
 void vp10_fht8x8_c(const int16_t *input, tran_low_t *output, int stride,
                    int tx_type) {
   if (tx_type == DCT_DCT) {
@@ -132,6 +132,53 @@ unsigned int vp10_high_get_sby_perpixel_variance(VP10_COMP *cpi,
 }
 #endif  // CONFIG_VPX_HIGHBITDEPTH
 
+// Works out the per pixel source variance of the block from the statistics
+// the lookahead gathered for the frame, giving the same result as
+// vp10_get_sby_perpixel_variance(). Returns 0 if there are none for the
+// block, as for blocks smaller than 8x8 or a scaled or filtered source.
+static int get_lookahead_source_variance(const VP10_COMP *cpi,
+                                         const MACROBLOCKD *xd, int mi_row,
+                                         int mi_col, BLOCK_SIZE bsize,
+                                         unsigned int *variance) {
+  const struct lookahead_entry *const entry = cpi->source_entry;
+  const int log2_pels = num_pels_log2_lookup[bsize];
+  int bd = 8, offset, sum32;
+  int64_t sum;
+  uint64_t sumsq, sse;
+  unsigned int var;
+
+  if (entry == NULL || cpi->Source != &entry->img || bsize < BLOCK_8X8 ||
+      !vp10_lookahead_block_sums(entry, mi_row, mi_col,
+                                 num_8x8_blocks_high_lookup[bsize],
+                                 num_8x8_blocks_wide_lookup[bsize], &sum,
+                                 &sumsq))
+    return 0;
+
+#if CONFIG_VPX_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) bd = xd->bd;
+#else
+  (void)xd;
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+
+  // Move the sums to the mid-grey reference the variance is measured
+  // against, then round them the way the variance functions do.
+  offset = 128 << (bd - 8);
+  sse = sumsq + ((uint64_t)offset * offset << log2_pels) - 2 * offset * sum;
+  sum -= (int64_t)offset << log2_pels;
+  if (bd == 10) {
+    sse = ROUND_POWER_OF_TWO(sse, 4);
+    sum = ROUND_POWER_OF_TWO(sum, 2);
+  } else if (bd == 12) {
+    sse = ROUND_POWER_OF_TWO(sse, 8);
+    sum = ROUND_POWER_OF_TWO(sum, 4);
+  }
+  sum32 = (int)sum;
+  var = (unsigned int)sse -
+        (unsigned int)(((int64_t)sum32 * sum32) >> log2_pels);
+  *variance = ROUND_POWER_OF_TWO(var, log2_pels);
+  return 1;
+}
+
 static unsigned int get_sby_perpixel_diff_variance(VP10_COMP *cpi,
                                                    const struct buf_2d *ref,
                                                    int mi_row, int mi_col,
@@ -1085,18 +1132,21 @@ static void rd_pick_sb_modes(VP10_COMP *cpi, TileDataEnc *tile_data,
   // Set to zero to make sure we do not use the previous encoded frame stats
   mbmi->skip = 0;
 
+  if (!get_lookahead_source_variance(cpi, xd, mi_row, mi_col, bsize,
+                                     &x->source_variance)) {
 #if CONFIG_VPX_HIGHBITDEPTH
-  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
-    x->source_variance = vp10_high_get_sby_perpixel_variance(
-        cpi, &x->plane[0].src, bsize, xd->bd);
-  } else {
+    if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+      x->source_variance = vp10_high_get_sby_perpixel_variance(
+          cpi, &x->plane[0].src, bsize, xd->bd);
+    } else {
+      x->source_variance =
+          vp10_get_sby_perpixel_variance(cpi, &x->plane[0].src, bsize);
+    }
+#else
     x->source_variance =
         vp10_get_sby_perpixel_variance(cpi, &x->plane[0].src, bsize);
-  }
-#else
-  x->source_variance =
-      vp10_get_sby_perpixel_variance(cpi, &x->plane[0].src, bsize);
 #endif  // CONFIG_VPX_HIGHBITDEPTH
+  }
 
   // Save rdmult before it might be changed, so it can be restored later.
   orig_rdmult = x->rdmult;
@@ -2324,14 +2374,17 @@ static void rd_pick_partition(VP10_COMP *cpi, ThreadData *td,
   }
 }
 
-static void encode_rd_sb_row(VP10_COMP *cpi, ThreadData *td,
-                             TileDataEnc *tile_data, int mi_row,
-                             TOKENEXTRA **tp) {
+void vp10_encode_sb_row(VP10_COMP *cpi, ThreadData *td, TileDataEnc *tile_data,
+                        int mi_row, TOKENEXTRA **tp,
+                        VP10RowMTSync *const row_mt_sync, int sync_row) {
   VP10_COMMON *const cm = &cpi->common;
   TileInfo *const tile_info = &tile_data->tile_info;
   MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *const xd = &x->e_mbd;
   SPEED_FEATURES *const sf = &cpi->sf;
+  const int sb_cols =
+      mi_cols_aligned_to_sb(tile_info->mi_col_end - tile_info->mi_col_start) >>
+      MI_BLOCK_SIZE_LOG2;
   int mi_col;
 
   // Initialize the left context for the new SB row
@@ -2350,6 +2403,9 @@ static void encode_rd_sb_row(VP10_COMP *cpi, ThreadData *td,
 
     const int idx_str = cm->mi_stride * mi_row + mi_col;
     MODE_INFO **mi = cm->mi_grid_visible + idx_str;
+    const int sb_col = (mi_col - tile_info->mi_col_start) >> MI_BLOCK_SIZE_LOG2;
+
+    if (row_mt_sync) vp10_row_mt_sync_read(row_mt_sync, sync_row, sb_col);
 
     if (sf->adaptive_pred_interp_filter) {
       for (i = 0; i < 64; ++i) td->leaf_tree[i].pred_interp_filter = SWITCHABLE;
@@ -2402,6 +2458,9 @@ static void encode_rd_sb_row(VP10_COMP *cpi, ThreadData *td,
       rd_pick_partition(cpi, td, tile_data, tp, mi_row, mi_col, BLOCK_64X64,
                         &dummy_rdc, INT64_MAX, td->pc_root);
     }
+
+    if (row_mt_sync)
+      vp10_row_mt_sync_write(row_mt_sync, sync_row, sb_col, sb_cols);
   }
 }
 
@@ -2526,7 +2585,7 @@ void vp10_encode_tile(VP10_COMP *cpi, ThreadData *td, int tile_row,
 
   for (mi_row = tile_info->mi_row_start; mi_row < tile_info->mi_row_end;
        mi_row += MI_BLOCK_SIZE) {
-    encode_rd_sb_row(cpi, td, this_tile, mi_row, &tok);
+    vp10_encode_sb_row(cpi, td, this_tile, mi_row, &tok, NULL, 0);
   }
   cpi->tok_count[tile_row][tile_col] =
       (unsigned int)(tok - cpi->tile_tok[tile_row][tile_col]);
@@ -2618,8 +2677,12 @@ static void encode_frame_internal(VP10_COMP *cpi) {
     }
 #endif
 
+    // Row based multi-threading takes the same path with any number of
+    // threads, so that its output does not depend on the thread count.
+    if (cpi->oxcf.row_mt)
+      vp10_encode_tiles_row_mt(cpi);
     // If allowed, encoding tiles in parallel with one thread handling one tile.
-    if (VPXMIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) > 1)
+    else if (VPXMIN(cpi->oxcf.max_threads, 1 << cm->log2_tile_cols) > 1)
       vp10_encode_tiles_mt(cpi);
     else
       encode_tiles(cpi);
@@ -21,6 +21,9 @@ struct macroblock;
 struct yv12_buffer_config;
 struct VP10_COMP;
 struct ThreadData;
+struct TileDataEnc;
+struct VP10RowMTSync;
+struct TOKENEXTRA;
 
 // Constants used in SOURCE_VAR_BASED_PARTITION
 #define VAR_HIST_MAX_BG_VAR 1000
@@ -39,6 +42,13 @@ void vp10_init_tile_data(struct VP10_COMP *cpi);
 void vp10_encode_tile(struct VP10_COMP *cpi, struct ThreadData *td,
                       int tile_row, int tile_col);
 
+// Encodes the superblock row at 'mi_row' of a tile. When 'row_mt_sync' is not
+// NULL, each superblock waits for the row above through row 'sync_row' of it.
+void vp10_encode_sb_row(struct VP10_COMP *cpi, struct ThreadData *td,
+                        struct TileDataEnc *tile_data, int mi_row,
+                        struct TOKENEXTRA **tp,
+                        struct VP10RowMTSync *const row_mt_sync, int sync_row);
+
 void vp10_set_variance_partition_thresholds(struct VP10_COMP *cpi, int q);
 
 #ifdef __cplusplus
@@ -578,7 +578,19 @@ void vp10_xform_quant_fp(MACROBLOCK *x, int plane, int block, int blk_row,
 
   switch (tx_size) {
     case TX_32X32:
-      fdct32x32(x->use_lp32x32fdct, src_diff, coeff, diff_stride);
+      if (x->use_lp32x32fdct) {
+        vp10_fdct32x32_rd_quant(src_diff, diff_stride, coeff, 1024,
+                                x->skip_block, p->zbin, p->round_fp,
+                                p->quant_fp, p->quant_shift, qcoeff, dqcoeff,
+                                pd->dequant, eob, scan_order->scan,
+#if !CONFIG_AOM_QM
+                                scan_order->iscan);
+#else
+                                scan_order->iscan, qmatrix, iqmatrix);
+#endif
+        break;
+      }
+      vpx_fdct32x32(src_diff, coeff, diff_stride);
       vp10_quantize_fp_32x32(coeff, 1024, x->skip_block, p->zbin, p->round_fp,
                              p->quant_fp, p->quant_shift, qcoeff, dqcoeff,
                              pd->dequant, eob, scan_order->scan,
@@ -589,14 +601,13 @@ void vp10_xform_quant_fp(MACROBLOCK *x, int plane, int block, int blk_row,
 #endif
       break;
     case TX_16X16:
-      vpx_fdct16x16(src_diff, coeff, diff_stride);
-      vp10_quantize_fp(coeff, 256, x->skip_block, p->zbin, p->round_fp,
-                       p->quant_fp, p->quant_shift, qcoeff, dqcoeff,
-                       pd->dequant, eob, scan_order->scan,
+      vp10_fdct16x16_quant(src_diff, diff_stride, coeff, 256, x->skip_block,
+                           p->zbin, p->round_fp, p->quant_fp, p->quant_shift,
+                           qcoeff, dqcoeff, pd->dequant, eob, scan_order->scan,
 #if !CONFIG_AOM_QM
-                       scan_order->iscan);
+                           scan_order->iscan);
 #else
-                       scan_order->iscan, qmatrix, iqmatrix);
+                           scan_order->iscan, qmatrix, iqmatrix);
 #endif
       break;
     case TX_8X8:
@@ -610,11 +621,18 @@ void vp10_xform_quant_fp(MACROBLOCK *x, int plane, int block, int blk_row,
 #endif
       break;
     case TX_4X4:
-      if (xd->lossless[xd->mi[0]->mbmi.segment_id]) {
-        vp10_fwht4x4(src_diff, coeff, diff_stride);
-      } else {
-        vpx_fdct4x4(src_diff, coeff, diff_stride);
+      if (!xd->lossless[xd->mi[0]->mbmi.segment_id]) {
+        vp10_fdct4x4_quant(src_diff, diff_stride, coeff, 16, x->skip_block,
+                           p->zbin, p->round_fp, p->quant_fp, p->quant_shift,
+                           qcoeff, dqcoeff, pd->dequant, eob, scan_order->scan,
+#if !CONFIG_AOM_QM
+                           scan_order->iscan);
+#else
+                           scan_order->iscan, qmatrix, iqmatrix);
+#endif
+        break;
       }
+      vp10_fwht4x4(src_diff, coeff, diff_stride);
       vp10_quantize_fp(coeff, 16, x->skip_block, p->zbin, p->round_fp,
                        p->quant_fp, p->quant_shift, qcoeff, dqcoeff,
                        pd->dequant, eob, scan_order->scan,
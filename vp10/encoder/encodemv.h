@@ -22,8 +22,11 @@ void vp10_entropy_mv_init(void);
 void vp10_write_nmv_probs(VP10_COMMON *cm, int usehp, vpx_writer *w,
                           nmv_context_counts *const counts);
 
+// Writes 'mv' relative to 'ref'. The largest component written is tracked in
+// 'max_mv_magnitude' when the speed features ask for it.
 void vp10_encode_mv(VP10_COMP *cpi, vpx_writer *w, const MV *mv, const MV *ref,
-                    const nmv_context *mvctx, int usehp);
+                    const nmv_context *mvctx, int usehp,
+                    unsigned int *const max_mv_magnitude);
 
 void vp10_build_nmv_cost_table(int *mvjoint, int *mvcost[2],
                                const nmv_context *mvctx, int usehp);
@@ -38,6 +38,9 @@
 #include "vp10/encoder/ethread.h"
 #include "vp10/encoder/firstpass.h"
 #include "vp10/encoder/mbgraph.h"
+#if CONFIG_DERING
+#include "vp10/encoder/pickdering.h"
+#endif  // CONFIG_DERING
 #include "vp10/encoder/picklpf.h"
 #include "vp10/encoder/ratectrl.h"
 #include "vp10/encoder/rd.h"
@@ -381,6 +384,13 @@ static void dealloc_compressor_data(VP10_COMP *cpi) {
   vpx_free(cpi->tile_tok[0][0]);
   cpi->tile_tok[0][0] = 0;
 
+  vp10_free_tile_col_bufs(cpi);
+
+  vpx_free(cpi->twopass.row_stats);
+  cpi->twopass.row_stats = NULL;
+  vpx_free(cpi->twopass.mb_factors);
+  cpi->twopass.mb_factors = NULL;
+
   vp10_free_pc_tree(&cpi->td);
 
   if (cpi->source_diff_var != NULL) {
@@ -599,7 +609,9 @@ static void alloc_raw_frame_buffers(VP10_COMP *cpi) {
 #if CONFIG_VPX_HIGHBITDEPTH
                                          cm->use_highbitdepth,
 #endif
-                                         oxcf->lag_in_frames);
+                                         oxcf->lag_in_frames,
+                                         oxcf->max_threads > 1 &&
+                                             oxcf->lag_in_frames > 0);
   if (!cpi->lookahead)
     vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                        "Failed to allocate lag buffers");
@@ -669,11 +681,22 @@ void vp10_alloc_compressor_data(VP10_COMP *cpi) {
   vpx_free(cpi->tile_tok[0][0]);
 
   {
-    unsigned int tokens = get_token_alloc(cm->mb_rows, cm->mb_cols);
+    // Whole superblock rows, see allocated_tokens().
+    unsigned int tokens =
+        get_token_alloc(mi_cols_aligned_to_sb(cm->mi_rows) >> 1, cm->mb_cols);
     CHECK_MEM_ERROR(cm, cpi->tile_tok[0][0],
                     vpx_calloc(tokens, sizeof(*cpi->tile_tok[0][0])));
   }
 
+  if (cpi->oxcf.pass == 1) {
+    vpx_free(cpi->twopass.row_stats);
+    CHECK_MEM_ERROR(cm, cpi->twopass.row_stats,
+                    vpx_calloc(cm->mb_rows, sizeof(*cpi->twopass.row_stats)));
+    vpx_free(cpi->twopass.mb_factors);
+    CHECK_MEM_ERROR(cm, cpi->twopass.mb_factors,
+                    vpx_calloc(cm->MBs, sizeof(*cpi->twopass.mb_factors)));
+  }
+
   vp10_setup_pc_tree(&cpi->common, &cpi->td);
 }
 
@@ -1722,13 +1745,10 @@ void vp10_remove_compressor(VP10_COMP *cpi) {
 #endif
   }
 
+  vpx_thread_pool_release(cpi->thread_pool);
   for (t = 0; t < cpi->num_workers; ++t) {
-    VPxWorker *const worker = &cpi->workers[t];
     EncWorkerData *const thread_data = &cpi->tile_thr_data[t];
 
-    // Deallocate allocated threads.
-    vpx_get_worker_interface()->end(worker);
-
     // Deallocate allocated thread data.
     if (t < cpi->num_workers - 1) {
       vpx_free(thread_data->td->counts);
@@ -1737,9 +1757,12 @@ void vp10_remove_compressor(VP10_COMP *cpi) {
     }
   }
   vpx_free(cpi->tile_thr_data);
-  vpx_free(cpi->workers);
 
   if (cpi->num_workers > 1) vp10_loop_filter_dealloc(&cpi->lf_row_sync);
+  vp10_row_mt_sync_dealloc(&cpi->row_mt_sync);
+#if CONFIG_DERING
+  if (cpi->num_workers > 1) vp10_dering_dealloc(&cpi->dering_sync);
+#endif
 
   dealloc_compressor_data(cpi);
 
@@ -2428,7 +2451,7 @@ static void loopfilter_frame(VP10_COMP *cpi, VP10_COMMON *cm) {
   if (lf->filter_level > 0) {
     if (cpi->num_workers > 1)
       vp10_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
-                                lf->filter_level, 0, 0, cpi->workers,
+                                lf->filter_level, 0, 0, cpi->thread_pool,
                                 cpi->num_workers, &cpi->lf_row_sync);
     else
       vp10_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
@@ -2438,9 +2461,14 @@ static void loopfilter_frame(VP10_COMP *cpi, VP10_COMMON *cm) {
   if (is_lossless_requested(&cpi->oxcf)) {
     cm->dering_level = 0;
   } else {
-    cm->dering_level = vp10_dering_search(cm->frame_to_show, cpi->Source, cm,
-                                          xd);
-    vp10_dering_frame(cm->frame_to_show, cm, xd, cm->dering_level);
+    cm->dering_level = vp10_dering_search(cm->frame_to_show, cpi->Source, cpi,
+                                          cpi->sf.dering_search);
+    if (cpi->num_workers > 1)
+      vp10_dering_frame_mt(cm->frame_to_show, cm, xd, cm->dering_level,
+                           cpi->thread_pool, cpi->num_workers,
+                           &cpi->dering_sync);
+    else
+      vp10_dering_frame(cm->frame_to_show, cm, xd, cm->dering_level);
   }
 #endif  // CONFIG_DERING
 
@@ -2469,7 +2497,12 @@ static void loopfilter_frame(VP10_COMP *cpi, VP10_COMMON *cm) {
           get_sse(cpi->Source->v_buffer, cpi->Source->uv_stride,
                   cm->frame_to_show->v_buffer, cm->frame_to_show->uv_stride,
                   cpi->Source->uv_crop_width, cpi->Source->uv_crop_height);
-      vp10_clpf_frame(cm->frame_to_show, cm, xd);
+      if (cpi->num_workers > 1)
+        vp10_clpf_frame_mt(cm->frame_to_show, cm, xd->plane,
+                           cpi->thread_pool, cpi->num_workers,
+                           &cpi->lf_row_sync);
+      else
+        vp10_clpf_frame(cm->frame_to_show, cm, xd);
       after = get_sse(cpi->Source->y_buffer, cpi->Source->y_stride,
                       cm->frame_to_show->y_buffer, cm->frame_to_show->y_stride,
                       cpi->Source->y_crop_width, cpi->Source->y_crop_height) +
@@ -2484,7 +2517,12 @@ static void loopfilter_frame(VP10_COMP *cpi, VP10_COMMON *cm) {
       before = get_sse(cpi->Source->y_buffer, cpi->Source->y_stride,
                        cm->frame_to_show->y_buffer, cm->frame_to_show->y_stride,
                        cpi->Source->y_crop_width, cpi->Source->y_crop_height);
-      vp10_clpf_frame(cm->frame_to_show, cm, xd);
+      if (cpi->num_workers > 1)
+        vp10_clpf_frame_mt(cm->frame_to_show, cm, xd->plane,
+                           cpi->thread_pool, cpi->num_workers,
+                           &cpi->lf_row_sync);
+      else
+        vp10_clpf_frame(cm->frame_to_show, cm, xd);
       after = get_sse(cpi->Source->y_buffer, cpi->Source->y_stride,
                       cm->frame_to_show->y_buffer, cm->frame_to_show->y_stride,
                       cpi->Source->y_crop_width, cpi->Source->y_crop_height);
@@ -3774,6 +3812,7 @@ int vp10_get_compressed_data(VP10_COMP *cpi, unsigned int *frame_flags,
   if (source) {
     cpi->un_scaled_source = cpi->Source =
         force_src_buffer ? force_src_buffer : &source->img;
+    cpi->source_entry = force_src_buffer ? NULL : source;
 
     cpi->unscaled_last_source = last_source != NULL ? &last_source->img : NULL;
 
@@ -4091,6 +4130,16 @@ int64_t vp10_get_y_sse(const YV12_BUFFER_CONFIG *a,
                  a->y_crop_width, a->y_crop_height);
 }
 
+int64_t vp10_get_y_sse_rows(const YV12_BUFFER_CONFIG *a,
+                            const YV12_BUFFER_CONFIG *b, int row, int rows) {
+  assert(a->y_crop_width == b->y_crop_width);
+  assert(row >= 0 && row + rows <= a->y_crop_height);
+
+  return get_sse(a->y_buffer + row * a->y_stride, a->y_stride,
+                 b->y_buffer + row * b->y_stride, b->y_stride, a->y_crop_width,
+                 rows);
+}
+
 #if CONFIG_VPX_HIGHBITDEPTH
 int64_t vp10_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
                               const YV12_BUFFER_CONFIG *b) {
@@ -4102,6 +4151,19 @@ int64_t vp10_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
   return highbd_get_sse(a->y_buffer, a->y_stride, b->y_buffer, b->y_stride,
                         a->y_crop_width, a->y_crop_height);
 }
+
+int64_t vp10_highbd_get_y_sse_rows(const YV12_BUFFER_CONFIG *a,
+                                   const YV12_BUFFER_CONFIG *b, int row,
+                                   int rows) {
+  assert(a->y_crop_width == b->y_crop_width);
+  assert(row >= 0 && row + rows <= a->y_crop_height);
+  assert((a->flags & YV12_FLAG_HIGHBITDEPTH) != 0);
+  assert((b->flags & YV12_FLAG_HIGHBITDEPTH) != 0);
+
+  return highbd_get_sse(a->y_buffer + row * a->y_stride, a->y_stride,
+                        b->y_buffer + row * b->y_stride, b->y_stride,
+                        a->y_crop_width, rows);
+}
 #endif  // CONFIG_VPX_HIGHBITDEPTH
 
 int vp10_get_quantizer(VP10_COMP *cpi) { return cpi->common.base_qindex; }
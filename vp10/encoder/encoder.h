@@ -20,10 +20,14 @@
 #include "vp10/common/entropymode.h"
 #include "vp10/common/thread_common.h"
 #include "vp10/common/onyxc_int.h"
+#if CONFIG_DERING
+#include "vp10/common/dering.h"
+#endif
 
 #include "vp10/encoder/aq_cyclicrefresh.h"
 #include "vp10/encoder/context_tree.h"
 #include "vp10/encoder/encodemb.h"
+#include "vp10/encoder/ethread.h"
 #include "vp10/encoder/firstpass.h"
 #include "vp10/encoder/lookahead.h"
 #include "vp10/encoder/mbgraph.h"
@@ -40,6 +44,7 @@
 #include "vpx_dsp/variance.h"
 #include "vpx/internal/vpx_codec_internal.h"
 #include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -215,6 +220,8 @@ typedef struct VP10EncoderConfig {
   int tile_rows;
 
   int max_threads;
+  // Encode superblock rows within a tile in parallel.
+  int row_mt;
 
   vpx_fixed_buf_t two_pass_stats_in;
   struct vpx_codec_pkt_list *output_pkt_list;
@@ -288,6 +295,8 @@ typedef struct VP10_COMP {
   VP10EncoderConfig oxcf;
   struct lookahead_ctx *lookahead;
   struct lookahead_entry *alt_ref_source;
+  // Lookahead entry holding the unfiltered source of the frame being coded.
+  const struct lookahead_entry *source_entry;
 
   YV12_BUFFER_CONFIG *Source;
   YV12_BUFFER_CONFIG *Last_Source;  // NULL for first frame and alt_ref frames
@@ -323,6 +332,8 @@ typedef struct VP10_COMP {
 
   TOKENEXTRA *tile_tok[4][1 << 6];
   unsigned int tok_count[4][1 << 6];
+  // One buffer per tile column for packing the columns in parallel.
+  struct VP10TileColBuffer *tile_col_buf;
 
   // Ambient reconstruction err target for force key frames
   int64_t ambient_err;
@@ -481,9 +492,13 @@ typedef struct VP10_COMP {
 
   // Multi-threading
   int num_workers;
-  VPxWorker *workers;
+  VPxThreadPool *thread_pool;
   struct EncWorkerData *tile_thr_data;
   VP10LfSync lf_row_sync;
+  VP10RowMTSync row_mt_sync;
+#if CONFIG_DERING
+  VP10DeringSync dering_sync;
+#endif
 } VP10_COMP;
 
 void vp10_initialize_enc(void);
@@ -572,18 +587,34 @@ static INLINE int get_token_alloc(int mb_rows, int mb_cols) {
 
 // Get the allocated token size for a tile. It does the same calculation as in
 // the frame token allocation.
-static INLINE int allocated_tokens(TileInfo tile) {
-  int tile_mb_rows = (tile.mi_row_end - tile.mi_row_start + 1) >> 1;
+// The tokens for one superblock row of a tile.
+static INLINE int allocated_sb_row_tokens(TileInfo tile) {
   int tile_mb_cols = (tile.mi_col_end - tile.mi_col_start + 1) >> 1;
 
-  return get_token_alloc(tile_mb_rows, tile_mb_cols);
+  return get_token_alloc(MI_BLOCK_SIZE >> 1, tile_mb_cols);
+}
+
+// Room is left for whole superblock rows, so that each row can have its own
+// part of the buffer when rows are encoded in parallel.
+static INLINE int allocated_tokens(TileInfo tile) {
+  int tile_sb_rows =
+      mi_cols_aligned_to_sb(tile.mi_row_end - tile.mi_row_start) >>
+      MI_BLOCK_SIZE_LOG2;
+
+  return tile_sb_rows * allocated_sb_row_tokens(tile);
 }
 
 int64_t vp10_get_y_sse(const YV12_BUFFER_CONFIG *a,
                        const YV12_BUFFER_CONFIG *b);
+// As vp10_get_y_sse() over the luma rows [row, row + rows).
+int64_t vp10_get_y_sse_rows(const YV12_BUFFER_CONFIG *a,
+                            const YV12_BUFFER_CONFIG *b, int row, int rows);
 #if CONFIG_VPX_HIGHBITDEPTH
 int64_t vp10_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
                               const YV12_BUFFER_CONFIG *b);
+int64_t vp10_highbd_get_y_sse_rows(const YV12_BUFFER_CONFIG *a,
+                                   const YV12_BUFFER_CONFIG *b, int row,
+                                   int rows);
 #endif  // CONFIG_VPX_HIGHBITDEPTH
 
 void vp10_alloc_compressor_data(VP10_COMP *cpi);
@@ -8,9 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <assert.h>
+
+#include "vp10/encoder/bitstream.h"
 #include "vp10/encoder/encodeframe.h"
 #include "vp10/encoder/encoder.h"
 #include "vp10/encoder/ethread.h"
+#include "vp10/encoder/firstpass.h"
+#include "vp10/encoder/temporal_filter.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
@@ -46,7 +51,7 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   (void)unused;
 
   for (t = thread_data->start; t < tile_rows * tile_cols;
-       t += cpi->num_workers) {
+       t += thread_data->step) {
     int tile_row = t / tile_cols;
     int tile_col = t % tile_cols;
 
@@ -56,71 +61,71 @@ static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   return 0;
 }
 
-void vp10_encode_tiles_mt(VP10_COMP *cpi) {
+// Creates the thread data of the jobs. Without a pool set by the
+// application, takes a reference to the shared thread pool, with a thread for
+// each job besides the one the calling thread runs. The thread data is only
+// created once, so the number of jobs is fixed by the first frame encoded
+// with threads.
+static void create_enc_workers(VP10_COMP *cpi, int num_workers) {
   VP10_COMMON *const cm = &cpi->common;
-  const int tile_cols = 1 << cm->log2_tile_cols;
-  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
-  const int num_workers = VPXMIN(cpi->oxcf.max_threads, tile_cols);
   int i;
 
-  vp10_init_tile_data(cpi);
-
-  // Only run once to create threads and allocate thread data.
-  if (cpi->num_workers == 0) {
-    int allocated_workers = num_workers;
-
-    CHECK_MEM_ERROR(cm, cpi->workers,
-                    vpx_malloc(allocated_workers * sizeof(*cpi->workers)));
-
-    CHECK_MEM_ERROR(cm, cpi->tile_thr_data,
-                    vpx_calloc(allocated_workers, sizeof(*cpi->tile_thr_data)));
-
-    for (i = 0; i < allocated_workers; i++) {
-      VPxWorker *const worker = &cpi->workers[i];
-      EncWorkerData *thread_data = &cpi->tile_thr_data[i];
-
-      ++cpi->num_workers;
-      winterface->init(worker);
-
-      if (i < allocated_workers - 1) {
-        thread_data->cpi = cpi;
-
-        // Allocate thread data.
-        CHECK_MEM_ERROR(cm, thread_data->td,
-                        vpx_memalign(32, sizeof(*thread_data->td)));
-        vp10_zero(*thread_data->td);
-
-        // Set up pc_tree.
-        thread_data->td->leaf_tree = NULL;
-        thread_data->td->pc_tree = NULL;
-        vp10_setup_pc_tree(cm, thread_data->td);
+  if (num_workers > 1 && cpi->thread_pool == NULL) {
+    cpi->thread_pool = vpx_thread_pool_get_shared(num_workers - 1);
+    if (cpi->thread_pool == NULL)
+      vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
+                         "Tile encoder thread creation failed");
+  }
 
-        // Allocate frame counters in thread data.
-        CHECK_MEM_ERROR(cm, thread_data->td->counts,
-                        vpx_calloc(1, sizeof(*thread_data->td->counts)));
+  if (cpi->num_workers) return;
 
-        // Create threads
-        if (!winterface->reset(worker))
-          vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
-                             "Tile encoder thread creation failed");
-      } else {
-        // Main thread acts as a worker and uses the thread data in cpi.
-        thread_data->cpi = cpi;
-        thread_data->td = &cpi->td;
-      }
+  CHECK_MEM_ERROR(cm, cpi->tile_thr_data,
+                  vpx_calloc(num_workers, sizeof(*cpi->tile_thr_data)));
 
-      winterface->sync(worker);
+  for (i = 0; i < num_workers; i++) {
+    EncWorkerData *thread_data = &cpi->tile_thr_data[i];
+
+    ++cpi->num_workers;
+
+    if (i < num_workers - 1) {
+      thread_data->cpi = cpi;
+
+      // Allocate thread data.
+      CHECK_MEM_ERROR(cm, thread_data->td,
+                      vpx_memalign(32, sizeof(*thread_data->td)));
+      vp10_zero(*thread_data->td);
+
+      // Set up pc_tree.
+      thread_data->td->leaf_tree = NULL;
+      thread_data->td->pc_tree = NULL;
+      vp10_setup_pc_tree(cm, thread_data->td);
+
+      // Allocate frame counters in thread data.
+      CHECK_MEM_ERROR(cm, thread_data->td->counts,
+                      vpx_calloc(1, sizeof(*thread_data->td->counts)));
+    } else {
+      // The last job uses the thread data in cpi.
+      thread_data->cpi = cpi;
+      thread_data->td = &cpi->td;
     }
   }
+}
 
-  for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    EncWorkerData *thread_data;
+void vp10_set_thread_pool(VP10_COMP *cpi, VPxThreadPool *pool) {
+  vpx_thread_pool_release(cpi->thread_pool);
+  cpi->thread_pool = vpx_thread_pool_retain(pool);
+}
+
+// Runs 'hook' as 'num_workers' jobs on the thread pool, passing the thread
+// data of each job and 'data' as its arguments.
+static void run_enc_workers(VP10_COMP *cpi, VPxWorkerHook hook, void *data,
+                            int num_workers) {
+  VPxJobGroup group;
+  int queued = 1;
+  int i;
 
-    worker->hook = (VPxWorkerHook)enc_worker_hook;
-    worker->data1 = &cpi->tile_thr_data[i];
-    worker->data2 = NULL;
-    thread_data = (EncWorkerData *)worker->data1;
+  for (i = 0; i < num_workers; i++) {
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
 
     // Before encoding a frame, copy the thread data from cpi.
     if (thread_data->td != &cpi->td) {
@@ -134,28 +139,31 @@ void vp10_encode_tiles_mt(VP10_COMP *cpi) {
   }
 
   // Encode a frame
+  vpx_job_group_init(&group, cpi->thread_pool);
   for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
 
-    // Set the starting tile for each thread.
+    // Set the starting tile for each job.
     thread_data->start = i;
+    thread_data->step = num_workers;
 
-    if (i == cpi->num_workers - 1)
-      winterface->execute(worker);
-    else
-      winterface->launch(worker);
+    queued &= vpx_job_group_submit(&group, hook, thread_data, data);
   }
 
   // Encoding ends.
-  for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    winterface->sync(worker);
-  }
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue encoder jobs");
+}
+
+// Merges the counters of the first 'num_workers' workers into cpi.
+static void accumulate_enc_workers(VP10_COMP *cpi, int num_workers) {
+  VP10_COMMON *const cm = &cpi->common;
+  int i;
 
   for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
 
     // Accumulate counters.
     if (i < cpi->num_workers - 1) {
@@ -164,3 +172,346 @@ void vp10_encode_tiles_mt(VP10_COMP *cpi) {
     }
   }
 }
+
+void vp10_encode_tiles_mt(VP10_COMP *cpi) {
+  VP10_COMMON *const cm = &cpi->common;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  int num_workers = VPXMIN(cpi->oxcf.max_threads, tile_cols);
+
+  vp10_init_tile_data(cpi);
+  create_enc_workers(cpi, num_workers);
+  // The thread data may have been created for fewer jobs.
+  num_workers = VPXMIN(num_workers, cpi->num_workers);
+  run_enc_workers(cpi, (VPxWorkerHook)enc_worker_hook, NULL, num_workers);
+  accumulate_enc_workers(cpi, num_workers);
+}
+
+static void row_mt_sync_alloc(VP10RowMTSync *row_mt_sync, VP10_COMMON *cm,
+                              int rows) {
+#if CONFIG_MULTITHREAD
+  int i;
+
+  pthread_mutex_init(&row_mt_sync->job_mutex, NULL);
+  row_mt_sync->rows = rows;
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->mutex_,
+                  vpx_malloc(sizeof(*row_mt_sync->mutex_) * rows));
+  if (row_mt_sync->mutex_) {
+    for (i = 0; i < rows; ++i) {
+      pthread_mutex_init(&row_mt_sync->mutex_[i], NULL);
+    }
+  }
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->cond_,
+                  vpx_malloc(sizeof(*row_mt_sync->cond_) * rows));
+  if (row_mt_sync->cond_) {
+    for (i = 0; i < rows; ++i) {
+      pthread_cond_init(&row_mt_sync->cond_[i], NULL);
+    }
+  }
+#else
+  row_mt_sync->rows = rows;
+#endif  // CONFIG_MULTITHREAD
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->cur_sb_col,
+                  vpx_malloc(sizeof(*row_mt_sync->cur_sb_col) * rows));
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->row_data,
+                  vpx_malloc(sizeof(*row_mt_sync->row_data) * rows));
+
+  CHECK_MEM_ERROR(cm, row_mt_sync->tok_count,
+                  vpx_malloc(sizeof(*row_mt_sync->tok_count) * rows));
+}
+
+void vp10_row_mt_sync_dealloc(VP10RowMTSync *row_mt_sync) {
+  if (row_mt_sync != NULL) {
+#if CONFIG_MULTITHREAD
+    int i;
+
+    if (row_mt_sync->mutex_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_mutex_destroy(&row_mt_sync->mutex_[i]);
+      }
+      vpx_free(row_mt_sync->mutex_);
+    }
+    if (row_mt_sync->cond_ != NULL) {
+      for (i = 0; i < row_mt_sync->rows; ++i) {
+        pthread_cond_destroy(&row_mt_sync->cond_[i]);
+      }
+      vpx_free(row_mt_sync->cond_);
+    }
+    if (row_mt_sync->rows) pthread_mutex_destroy(&row_mt_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+    vpx_free(row_mt_sync->cur_sb_col);
+    vpx_free(row_mt_sync->row_data);
+    vpx_free(row_mt_sync->tok_count);
+    vp10_zero(*row_mt_sync);
+  }
+}
+
+void vp10_row_mt_sync_read(VP10RowMTSync *const row_mt_sync, int r, int c) {
+#if CONFIG_MULTITHREAD
+  if (r % row_mt_sync->sb_rows) {
+    pthread_mutex_t *const mutex = &row_mt_sync->mutex_[r - 1];
+    pthread_mutex_lock(mutex);
+
+    // Intra prediction and the motion vector candidates reach into the
+    // superblock above and to the right.
+    while (c + 1 > row_mt_sync->cur_sb_col[r - 1]) {
+      pthread_cond_wait(&row_mt_sync->cond_[r - 1], mutex);
+    }
+    pthread_mutex_unlock(mutex);
+  }
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+#endif  // CONFIG_MULTITHREAD
+}
+
+void vp10_row_mt_sync_write(VP10RowMTSync *const row_mt_sync, int r, int c,
+                            int sb_cols) {
+#if CONFIG_MULTITHREAD
+  // The end of the row also releases the last superblock of the row below,
+  // which has nothing to its top right.
+  const int cur = c < sb_cols - 1 ? c : sb_cols;
+
+  pthread_mutex_lock(&row_mt_sync->mutex_[r]);
+  row_mt_sync->cur_sb_col[r] = cur;
+  pthread_cond_signal(&row_mt_sync->cond_[r]);
+  pthread_mutex_unlock(&row_mt_sync->mutex_[r]);
+#else
+  (void)row_mt_sync;
+  (void)r;
+  (void)c;
+  (void)sb_cols;
+#endif  // CONFIG_MULTITHREAD
+}
+
+// Returns the next superblock row to encode, or -1 when all are taken. Rows
+// are handed out in raster order, so the row above a job is always taken
+// before it.
+static int get_next_job(VP10RowMTSync *const row_mt_sync, int num_jobs) {
+  int job = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&row_mt_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  if (row_mt_sync->next_job < num_jobs) job = row_mt_sync->next_job++;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&row_mt_sync->job_mutex);
+#endif  // CONFIG_MULTITHREAD
+  return job;
+}
+
+static int enc_row_worker_hook(EncWorkerData *const thread_data,
+                               void *unused) {
+  VP10_COMP *const cpi = thread_data->cpi;
+  const VP10_COMMON *const cm = &cpi->common;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  ThreadData *const td = thread_data->td;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int sb_rows = row_mt_sync->sb_rows;
+  int job;
+
+  (void)unused;
+
+  // Set up pointers to per thread motion search counters.
+  td->mb.m_search_count_ptr = &td->rd_counts.m_search_count;
+  td->mb.ex_search_count_ptr = &td->rd_counts.ex_search_count;
+
+  while ((job = get_next_job(row_mt_sync, tile_cols * sb_rows)) >= 0) {
+    const int sb_row = job / tile_cols;
+    const int tile_col = job % tile_cols;
+    const int r = tile_col * sb_rows + sb_row;
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    TileDataEnc *const row_data = &row_mt_sync->row_data[r];
+    const TileInfo *const tile_info = &row_data->tile_info;
+    int tile_row = 0;
+    TOKENEXTRA *tok_start, *tok;
+
+    while (mi_row >=
+           cpi->tile_data[tile_row * tile_cols + tile_col].tile_info.mi_row_end)
+      ++tile_row;
+
+    // Each row has its own part of the tile's token buffer.
+    tok_start = cpi->tile_tok[tile_row][tile_col] +
+                ((mi_row - tile_info->mi_row_start) >> MI_BLOCK_SIZE_LOG2) *
+                    allocated_sb_row_tokens(*tile_info);
+    tok = tok_start;
+    vp10_encode_sb_row(cpi, td, row_data, mi_row, &tok, row_mt_sync, r);
+    row_mt_sync->tok_count[r] = (unsigned int)(tok - tok_start);
+    assert(tok - tok_start <= allocated_sb_row_tokens(*tile_info));
+  }
+
+  return 0;
+}
+
+void vp10_encode_tiles_row_mt(VP10_COMP *cpi) {
+  VP10_COMMON *const cm = &cpi->common;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int tile_rows = 1 << cm->log2_tile_rows;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int rows = tile_cols * sb_rows;
+  const int max_threads = VPXMAX(cpi->oxcf.max_threads, 1);
+  int num_workers;
+  int tile_row, tile_col;
+
+  vp10_init_tile_data(cpi);
+  create_enc_workers(cpi, max_threads);
+  // The workers may have been created for tile based threading.
+  num_workers = VPXMIN(max_threads, cpi->num_workers);
+
+  if (rows > row_mt_sync->rows) {
+    vp10_row_mt_sync_dealloc(row_mt_sync);
+    row_mt_sync_alloc(row_mt_sync, cm, rows);
+  }
+  row_mt_sync->sb_rows = sb_rows;
+  row_mt_sync->next_job = 0;
+  memset(row_mt_sync->cur_sb_col, -1, sizeof(*row_mt_sync->cur_sb_col) * rows);
+
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      const TileDataEnc *const this_tile =
+          &cpi->tile_data[tile_row * tile_cols + tile_col];
+      int mi_row;
+
+      for (mi_row = this_tile->tile_info.mi_row_start;
+           mi_row < this_tile->tile_info.mi_row_end; mi_row += MI_BLOCK_SIZE)
+        row_mt_sync->row_data[tile_col * sb_rows +
+                              (mi_row >> MI_BLOCK_SIZE_LOG2)] = *this_tile;
+    }
+  }
+
+  run_enc_workers(cpi, (VPxWorkerHook)enc_row_worker_hook, NULL, num_workers);
+  accumulate_enc_workers(cpi, num_workers);
+
+  // Pack the tokens of each tile's rows together for the bitstream writer,
+  // and carry the RD state of each tile's last row over to the next frame.
+  for (tile_row = 0; tile_row < tile_rows; ++tile_row) {
+    for (tile_col = 0; tile_col < tile_cols; ++tile_col) {
+      TileDataEnc *const this_tile =
+          &cpi->tile_data[tile_row * tile_cols + tile_col];
+      const TileInfo *const tile_info = &this_tile->tile_info;
+      const int row_tokens = allocated_sb_row_tokens(*tile_info);
+      TOKENEXTRA *const tile_tok = cpi->tile_tok[tile_row][tile_col];
+      TOKENEXTRA *tok = tile_tok;
+      const TileDataEnc *last_row = NULL;
+      int mi_row;
+
+      for (mi_row = tile_info->mi_row_start; mi_row < tile_info->mi_row_end;
+           mi_row += MI_BLOCK_SIZE) {
+        const int r = tile_col * sb_rows + (mi_row >> MI_BLOCK_SIZE_LOG2);
+        const unsigned int count = row_mt_sync->tok_count[r];
+        memmove(tok,
+                tile_tok +
+                    ((mi_row - tile_info->mi_row_start) >> MI_BLOCK_SIZE_LOG2) *
+                        row_tokens,
+                count * sizeof(*tok));
+        tok += count;
+        last_row = &row_mt_sync->row_data[r];
+      }
+      cpi->tok_count[tile_row][tile_col] = (unsigned int)(tok - tile_tok);
+
+      if (last_row != NULL) {
+        memcpy(this_tile->thresh_freq_fact, last_row->thresh_freq_fact,
+               sizeof(this_tile->thresh_freq_fact));
+        memcpy(this_tile->mode_map, last_row->mode_map,
+               sizeof(this_tile->mode_map));
+      }
+    }
+  }
+}
+
+static int first_pass_worker_hook(EncWorkerData *const thread_data,
+                                  void *unused) {
+  VP10_COMP *const cpi = thread_data->cpi;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  int mb_row;
+
+  (void)unused;
+
+  while ((mb_row = get_next_job(row_mt_sync, cpi->common.mb_rows)) >= 0)
+    vp10_first_pass_row(cpi, thread_data->td, mb_row, row_mt_sync);
+
+  return 0;
+}
+
+void vp10_first_pass_row_mt(VP10_COMP *cpi) {
+  VP10_COMMON *const cm = &cpi->common;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  const int max_threads = VPXMAX(cpi->oxcf.max_threads, 1);
+  int num_workers;
+
+  create_enc_workers(cpi, max_threads);
+  num_workers = VPXMIN(max_threads, cpi->num_workers);
+
+  // The first pass ignores tiles and works on macroblocks, so the frame is a
+  // single column of macroblock rows.
+  if (cm->mb_rows > row_mt_sync->rows) {
+    vp10_row_mt_sync_dealloc(row_mt_sync);
+    row_mt_sync_alloc(row_mt_sync, cm, cm->mb_rows);
+  }
+  row_mt_sync->sb_rows = cm->mb_rows;
+  row_mt_sync->next_job = 0;
+  memset(row_mt_sync->cur_sb_col, -1,
+         sizeof(*row_mt_sync->cur_sb_col) * cm->mb_rows);
+
+  run_enc_workers(cpi, (VPxWorkerHook)first_pass_worker_hook, NULL,
+                  num_workers);
+}
+
+static int temporal_filter_worker_hook(EncWorkerData *const thread_data,
+                                       ARNRFilterData *const filter_data) {
+  VP10_COMP *const cpi = thread_data->cpi;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  int mb_row;
+
+  while ((mb_row = get_next_job(row_mt_sync, filter_data->mb_rows)) >= 0)
+    vp10_temporal_filter_row(cpi, thread_data->td, filter_data, mb_row);
+
+  return 0;
+}
+
+void vp10_temporal_filter_row_mt(VP10_COMP *cpi,
+                                 ARNRFilterData *const filter_data) {
+  VP10_COMMON *const cm = &cpi->common;
+  VP10RowMTSync *const row_mt_sync = &cpi->row_mt_sync;
+  const int max_threads = VPXMAX(cpi->oxcf.max_threads, 1);
+  int num_workers;
+
+  create_enc_workers(cpi, max_threads);
+  num_workers = VPXMIN(max_threads, cpi->num_workers);
+
+  // Only the job queue is used, the rows do not wait for each other.
+  if (filter_data->mb_rows > row_mt_sync->rows) {
+    vp10_row_mt_sync_dealloc(row_mt_sync);
+    row_mt_sync_alloc(row_mt_sync, cm, filter_data->mb_rows);
+  }
+  row_mt_sync->next_job = 0;
+
+  run_enc_workers(cpi, (VPxWorkerHook)temporal_filter_worker_hook, filter_data,
+                  num_workers);
+}
+
+static int pack_worker_hook(EncWorkerData *const thread_data, void *unused) {
+  VP10_COMP *const cpi = thread_data->cpi;
+  const int tile_cols = 1 << cpi->common.log2_tile_cols;
+  int tile_col;
+
+  (void)unused;
+
+  for (tile_col = thread_data->start; tile_col < tile_cols;
+       tile_col += thread_data->step)
+    vp10_pack_tile_col(cpi, thread_data->td, tile_col);
+
+  return 0;
+}
+
+void vp10_pack_tile_cols_mt(VP10_COMP *cpi) {
+  const int tile_cols = 1 << cpi->common.log2_tile_cols;
+  create_enc_workers(cpi, cpi->oxcf.max_threads);
+  run_enc_workers(
+      cpi, (VPxWorkerHook)pack_worker_hook, NULL,
+      VPXMIN(VPXMIN(cpi->oxcf.max_threads, cpi->num_workers), tile_cols));
+}
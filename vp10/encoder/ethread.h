@@ -11,21 +11,84 @@
 #ifndef VP10_ENCODER_ETHREAD_H_
 #define VP10_ENCODER_ETHREAD_H_
 
+#include "./vpx_config.h"
+#include "vpx_util/vpx_thread.h"
+#include "vpx_util/vpx_thread_pool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 struct VP10_COMP;
 struct ThreadData;
+struct TileDataEnc;
+struct ARNRFilterData;
 
 typedef struct EncWorkerData {
   struct VP10_COMP *cpi;
   struct ThreadData *td;
+  // The first tile of the job and the number of tiles to the next one.
   int start;
+  int step;
 } EncWorkerData;
 
+// Superblock row synchronization for row based multi-threaded encoding. The
+// rows of all tiles are numbered tile column by tile column, so row r - 1 is
+// the row above row r unless r is the first row of its tile column.
+typedef struct VP10RowMTSync {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t *mutex_;
+  pthread_cond_t *cond_;
+  pthread_mutex_t job_mutex;
+#endif
+  // The last encoded superblock column in each row.
+  int *cur_sb_col;
+  // The RD state each row is encoded with. Every row starts from the state of
+  // its tile so that the result does not depend on the order rows run in.
+  struct TileDataEnc *row_data;
+  // The number of tokens written by each row.
+  unsigned int *tok_count;
+  int rows;
+  // The number of superblock rows in the frame, or of macroblock rows in the
+  // first pass.
+  int sb_rows;
+  // The next row to hand out, in raster order across the tile columns.
+  int next_job;
+} VP10RowMTSync;
+
+// Runs the jobs of the encoder on 'pool' from the next frame on, holding a
+// reference to it. A NULL pool goes back to the shared pool.
+void vp10_set_thread_pool(struct VP10_COMP *cpi, VPxThreadPool *pool);
+
 void vp10_encode_tiles_mt(struct VP10_COMP *cpi);
 
+// Encodes the frame one superblock row per job, with each row trailing the
+// one above it by two superblocks. The output does not depend on the number
+// of threads.
+void vp10_encode_tiles_row_mt(struct VP10_COMP *cpi);
+
+// Codes the macroblock rows of a first pass frame in parallel, each row
+// trailing the one above it by two macroblocks. The rows keep their own
+// statistics, see vp10_first_pass_row().
+void vp10_first_pass_row_mt(struct VP10_COMP *cpi);
+
+// Filters the macroblock rows of an alt-ref frame in parallel.
+void vp10_temporal_filter_row_mt(struct VP10_COMP *cpi,
+                                 struct ARNRFilterData *const filter_data);
+
+// Packs the tile columns of the frame in parallel, see vp10_pack_tile_col().
+void vp10_pack_tile_cols_mt(struct VP10_COMP *cpi);
+
+void vp10_row_mt_sync_dealloc(VP10RowMTSync *row_mt_sync);
+
+// Waits until the row above row 'r' has encoded the superblocks that column
+// 'c' predicts from.
+void vp10_row_mt_sync_read(VP10RowMTSync *const row_mt_sync, int r, int c);
+
+// Marks column 'c' of row 'r' as encoded.
+void vp10_row_mt_sync_write(VP10RowMTSync *const row_mt_sync, int r, int c,
+                            int sb_cols);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -11,6 +11,7 @@
 #ifndef VP10_ENCODER_FIRSTPASS_H_
 #define VP10_ENCODER_FIRSTPASS_H_
 
+#include "vp10/common/mv.h"
 #include "vp10/encoder/lookahead.h"
 #include "vp10/encoder/ratectrl.h"
 
@@ -66,6 +67,40 @@ typedef struct {
   double count;
 } FIRSTPASS_STATS;
 
+// The statistics of one macroblock row of the first pass. Rows can be coded
+// by different threads, so they are summed in row order once the whole frame
+// is done.
+typedef struct {
+  int64_t intra_error;
+  int64_t coded_error;
+  int64_t sr_coded_error;
+  int64_t sum_mvrs;
+  int64_t sum_mvcs;
+  int sum_mvr;
+  int sum_mvc;
+  int sum_mvr_abs;
+  int sum_mvc_abs;
+  int mvcount;
+  int intercount;
+  int second_ref_count;
+  int intra_skip_count;
+  int image_data_start_row;
+  // Counted as if the row were the first in the frame.
+  int new_mv_count;
+  int sum_in_vectors;
+  // The first and the last non zero motion vectors of the row.
+  MV first_mv;
+  MV last_mv;
+} FIRSTPASS_ROW_STATS;
+
+// The floating point terms of one macroblock. They are summed in raster
+// order, which rounds them the same way whatever the number of threads.
+typedef struct {
+  double intra_factor;
+  double brightness_factor;
+  double neutral_count;
+} FIRSTPASS_MB_FACTORS;
+
 typedef enum {
   KF_UPDATE = 0,
   LF_UPDATE = 1,
@@ -112,6 +147,10 @@ typedef struct {
   uint8_t *this_frame_mb_stats;
   FIRSTPASS_MB_STATS firstpass_mb_stats;
 #endif
+  // Per row and per macroblock results of the frame in the first pass.
+  FIRSTPASS_ROW_STATS *row_stats;
+  FIRSTPASS_MB_FACTORS *mb_factors;
+
   // An indication of the content type of the current frame
   FRAME_CONTENT_TYPE fr_content_type;
 
@@ -139,11 +178,19 @@ typedef struct {
 } TWO_PASS;
 
 struct VP10_COMP;
+struct ThreadData;
+struct VP10RowMTSync;
 
 void vp10_init_first_pass(struct VP10_COMP *cpi);
 void vp10_rc_get_first_pass_params(struct VP10_COMP *cpi);
 void vp10_first_pass(struct VP10_COMP *cpi,
                      const struct lookahead_entry *source);
+
+// Codes macroblock row 'mb_row' of the frame set up by vp10_first_pass().
+// With a 'row_mt_sync' each macroblock waits for the one above and to its
+// right to be coded.
+void vp10_first_pass_row(struct VP10_COMP *cpi, struct ThreadData *td,
+                         int mb_row, struct VP10RowMTSync *const row_mt_sync);
 void vp10_end_first_pass(struct VP10_COMP *cpi);
 
 void vp10_init_second_pass(struct VP10_COMP *cpi);
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 
 #include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
 
 #include "vp10/common/common.h"
 
@@ -30,12 +31,88 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx,
   return buf;
 }
 
+/* Gather the statistics of an 8x8 block. */
+static void block_sums(const YV12_BUFFER_CONFIG *img, int row, int col,
+                       uint32_t *sum, uint32_t *sumsq) {
+  static const uint8_t zeros[8] = { 0 };
+  const uint8_t *const src = img->y_buffer + 8 * (row * img->y_stride + col);
+  unsigned int sse;
+  int s;
+#if CONFIG_VPX_HIGHBITDEPTH
+  static const uint16_t zeros16[8] = { 0 };
+  if (img->flags & YV12_FLAG_HIGHBITDEPTH)
+    vpx_highbd_8_get8x8var(src, img->y_stride, CONVERT_TO_BYTEPTR(zeros16), 0,
+                           &sse, &s);
+  else
+    vpx_get8x8var(src, img->y_stride, zeros, 0, &sse, &s);
+#else
+  vpx_get8x8var(src, img->y_stride, zeros, 0, &sse, &s);
+#endif
+  *sum = s;
+  *sumsq = sse;
+}
+
+/* Precompute the 8x8 block sums of a newly enqueued buffer, for the source
+ * variance. Runs on the worker thread when there is one, so it must only read
+ * the image and write the statistics.
+ */
+static int compute_block_sums(void *arg1, void *unused) {
+  struct lookahead_entry *const entry = (struct lookahead_entry *)arg1;
+  struct lookahead_stats *const stats = &entry->stats;
+  int r, c;
+  (void)unused;
+
+  for (r = 0; r < stats->rows; r++) {
+    for (c = 0; c < stats->cols; c++) {
+      const int i = r * stats->cols + c;
+      block_sums(&entry->img, r, c, &stats->sum[i], &stats->sumsq[i]);
+    }
+  }
+  stats->valid = 1;
+  return 1;
+}
+
+/* Wait for the block sums of buf, if they are still being computed. */
+static void wait_for_block_sums(struct lookahead_ctx *ctx,
+                              const struct lookahead_entry *buf) {
+  if (ctx->pending && (!buf || buf == ctx->pending)) {
+    vpx_get_worker_interface()->sync(&ctx->worker);
+    ctx->pending = NULL;
+  }
+}
+
+/* Size the statistics of buf for its image. */
+static int alloc_stats(struct lookahead_entry *buf) {
+  struct lookahead_stats *const stats = &buf->stats;
+  const int rows = ((buf->img.y_crop_height + 63) >> 6) << 3;
+  const int cols = ((buf->img.y_crop_width + 63) >> 6) << 3;
+
+  stats->valid = 0;
+  if (rows * cols > stats->alloc_size) {
+    free(stats->sum);
+    free(stats->sumsq);
+    stats->alloc_size = 0;
+    stats->sum = malloc(rows * cols * sizeof(*stats->sum));
+    stats->sumsq = malloc(rows * cols * sizeof(*stats->sumsq));
+    if (!stats->sum || !stats->sumsq) return 1;
+    stats->alloc_size = rows * cols;
+  }
+  stats->rows = rows;
+  stats->cols = cols;
+  return 0;
+}
+
 void vp10_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
+    if (ctx->async) vpx_get_worker_interface()->end(&ctx->worker);
     if (ctx->buf) {
       unsigned int i;
 
-      for (i = 0; i < ctx->max_sz; i++) vpx_free_frame_buffer(&ctx->buf[i].img);
+      for (i = 0; i < ctx->max_sz; i++) {
+        vpx_free_frame_buffer(&ctx->buf[i].img);
+        free(ctx->buf[i].stats.sum);
+        free(ctx->buf[i].stats.sumsq);
+      }
       free(ctx->buf);
     }
     free(ctx);
@@ -49,7 +126,7 @@ struct lookahead_ctx *vp10_lookahead_init(unsigned int width,
 #if CONFIG_VPX_HIGHBITDEPTH
                                           int use_highbitdepth,
 #endif
-                                          unsigned int depth) {
+                                          unsigned int depth, int async) {
   struct lookahead_ctx *ctx = NULL;
 
   // Clamp the lookahead queue depth
@@ -74,6 +151,12 @@ struct lookahead_ctx *vp10_lookahead_init(unsigned int width,
 #endif
               VPX_ENC_BORDER_IN_PIXELS, legacy_byte_alignment))
         goto bail;
+    if (async) {
+      const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+      winterface->init(&ctx->worker);
+      ctx->worker.hook = compute_block_sums;
+      ctx->async = winterface->reset(&ctx->worker);
+    }
   }
   return ctx;
 bail:
@@ -185,6 +268,18 @@ int vp10_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
   buf->flags = flags;
+
+  // The block sums are optional: without them the encoder computes the source
+  // variance from the image.
+  if (alloc_stats(buf)) return 0;
+  wait_for_block_sums(ctx, NULL);
+  if (ctx->async) {
+    ctx->worker.data1 = buf;
+    vpx_get_worker_interface()->launch(&ctx->worker);
+    ctx->pending = buf;
+  } else {
+    compute_block_sums(buf, NULL);
+  }
   return 0;
 }
 
@@ -195,6 +290,7 @@ struct lookahead_entry *vp10_lookahead_pop(struct lookahead_ctx *ctx,
   if (ctx && ctx->sz && (drain || ctx->sz == ctx->max_sz - MAX_PRE_FRAMES)) {
     buf = pop(ctx, &ctx->read_idx);
     ctx->sz--;
+    wait_for_block_sums(ctx, buf);
   }
   return buf;
 }
@@ -219,7 +315,28 @@ struct lookahead_entry *vp10_lookahead_peek(struct lookahead_ctx *ctx,
     }
   }
 
+  if (buf) wait_for_block_sums(ctx, buf);
   return buf;
 }
 
+int vp10_lookahead_block_sums(const struct lookahead_entry *entry, int row,
+                              int col, int rows, int cols, int64_t *sum,
+                              uint64_t *sumsq) {
+  const struct lookahead_stats *const stats = &entry->stats;
+  int r, c;
+
+  if (!stats->valid || row + rows > stats->rows || col + cols > stats->cols)
+    return 0;
+
+  *sum = 0;
+  *sumsq = 0;
+  for (r = row; r < row + rows; r++) {
+    for (c = col; c < col + cols; c++) {
+      *sum += stats->sum[r * stats->cols + c];
+      *sumsq += stats->sumsq[r * stats->cols + c];
+    }
+  }
+  return 1;
+}
+
 unsigned int vp10_lookahead_depth(struct lookahead_ctx *ctx) { return ctx->sz; }
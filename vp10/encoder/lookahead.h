@@ -13,6 +13,7 @@
 
 #include "vpx_scale/yv12config.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_util/vpx_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,28 +21,49 @@ extern "C" {
 
 #define MAX_LAG_BUFFERS 25
 
+// Precomputed source variance inputs: the sum of the luma pixels and the sum
+// of their squares for each 8x8 block of the frame. The grid covers whole
+// 64x64 superblocks, reading into the frame border.
+struct lookahead_stats {
+  int valid;
+  int rows;
+  int cols;
+  int alloc_size;
+  uint32_t *sum;
+  uint32_t *sumsq;
+};
+
 struct lookahead_entry {
   YV12_BUFFER_CONFIG img;
   int64_t ts_start;
   int64_t ts_end;
   unsigned int flags;
+  struct lookahead_stats stats;
 };
 
 // The max of past frames we want to keep in the queue.
 #define MAX_PRE_FRAMES 1
 
 struct lookahead_ctx {
-  unsigned int max_sz;         /* Absolute size of the queue */
-  unsigned int sz;             /* Number of buffers currently in the queue */
-  unsigned int read_idx;       /* Read index */
-  unsigned int write_idx;      /* Write index */
-  struct lookahead_entry *buf; /* Buffer list */
+  unsigned int max_sz;             /* Absolute size of the queue */
+  unsigned int sz;                 /* Number of buffers currently queued */
+  unsigned int read_idx;           /* Read index */
+  unsigned int write_idx;          /* Write index */
+  struct lookahead_entry *buf;     /* Buffer list */
+  int async;                       /* Compute block sums on a worker thread */
+  VPxWorker worker;                /* Block sums thread */
+  struct lookahead_entry *pending; /* Buffer with block sums in flight */
 };
 
 /**\brief Initializes the lookahead stage
  *
- * The lookahead stage is a queue of frame buffers on which some analysis
- * may be done when buffers are enqueued.
+ * The lookahead stage is a queue of frame buffers. The 8x8 block sums used
+ * for the source variance are precomputed when buffers are enqueued.
+ *
+ * \param[in] async   Compute the block sums of enqueued buffers on a
+ *                    background thread, so that they overlap the encoding of
+ *                    the frames ahead of them in the queue. They are computed
+ *                    in place otherwise, or if the thread cannot be started.
  */
 struct lookahead_ctx *vp10_lookahead_init(unsigned int width,
                                           unsigned int height,
@@ -50,7 +72,7 @@ struct lookahead_ctx *vp10_lookahead_init(unsigned int width,
 #if CONFIG_VPX_HIGHBITDEPTH
                                           int use_highbitdepth,
 #endif
-                                          unsigned int depth);
+                                          unsigned int depth, int async);
 
 /**\brief Destroys the lookahead stage
  */
@@ -101,6 +123,22 @@ struct lookahead_entry *vp10_lookahead_pop(struct lookahead_ctx *ctx,
 struct lookahead_entry *vp10_lookahead_peek(struct lookahead_ctx *ctx,
                                             int index);
 
+/**\brief Sum the source statistics over a block
+ *
+ * \param[in]  entry     Entry returned by vp10_lookahead_pop() or peek()
+ * \param[in]  row       Top of the block, in 8x8 units
+ * \param[in]  col       Left of the block, in 8x8 units
+ * \param[in]  rows      Height of the block, in 8x8 units
+ * \param[in]  cols      Width of the block, in 8x8 units
+ * \param[out] sum       Sum of the luma pixels
+ * \param[out] sumsq     Sum of the squares of the luma pixels
+ *
+ * \retval 0, if the entry has no statistics covering the block
+ */
+int vp10_lookahead_block_sums(const struct lookahead_entry *entry, int row,
+                              int col, int rows, int cols, int64_t *sum,
+                              uint64_t *sumsq);
+
 /**\brief Get the number of frames currently in the lookahead queue
  *
  * \param[in] ctx       Pointer to the lookahead context
@@ -8,75 +8,249 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <limits.h>
 #include <string.h>
 
+#include "./vp10_rtcd.h"
 #include "./vpx_scale_rtcd.h"
 #include "vp10/common/dering.h"
 #include "vp10/common/onyxc_int.h"
 #include "vp10/common/reconinter.h"
 #include "vp10/encoder/encoder.h"
+#include "vp10/encoder/pickdering.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_thread_pool.h"
 
-static double compute_dist(int16_t *x, int xstride, int16_t *y, int ystride,
-    int nhb, int nvb, int coeff_shift) {
+// Distance between the levels tried by the first pass of the fast search.
+#define DERING_COARSE_STEP 4
+
+// Number of coarse levels in a row with a distortion above the best one after
+// which the fast search stops trying higher levels.
+#define DERING_COARSE_BREAKOUT 2
+
+typedef struct DeringSearch {
+  const VP10_COMMON *cm;
+  od_dering_opt_vtbl vtbl;
+  DERING_SEARCH_METHOD method;
+  // Luma of the reconstructed and source frames, and the skip flag of each
+  // 8x8 block.
+  od_dering_in *src;
+  int16_t *ref_coeff;
+  unsigned char *bskip;
+  int stride;
+  int nhsb;
+  int nvsb;
+  int coeff_shift;
+  // Distortion of each superblock at each level, and whether it was measured
+  // rather than interpolated by the fast search.
+  int (*mse)[MAX_DERING_LEVEL];
+  uint64_t *exact;
+  // Block directions of each superblock, which do not depend on the level.
+  int (*dir)[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+  int32_t (*var)[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+  // The global level to refine around, or -1 in the first pass.
+  int refine_level;
+  int num_workers;
+} DeringSearch;
+
+typedef struct DeringSearchWorkerData {
+  int start;
+} DeringSearchWorkerData;
+
+uint64_t vp10_dering_sse_c(const int16_t *a, int a_stride, const int16_t *b,
+                           int b_stride, int width, int height) {
+  uint64_t sse = 0;
   int i, j;
-  double sum;
-  sum = 0;
-  for (i = 0; i < nvb << 3; i++) {
-    for (j = 0; j < nhb << 3; j++) {
-      double tmp;
-      tmp = x[i*xstride + j] - y[i*ystride + j];
-      sum += tmp*tmp;
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < width; j++) {
+      const int d = a[i*a_stride + j] - b[i*b_stride + j];
+      sse += d*d;
+    }
+  }
+  return sse;
+}
+
+// Returns the distortion of superblock (sbr, sbc) deringed at 'level'.
+static int compute_dist(const DeringSearch *ds, int sbr, int sbc, int level) {
+  const int nhb = VPXMIN(MI_BLOCK_SIZE, ds->cm->mi_cols - MI_BLOCK_SIZE*sbc);
+  const int nvb = VPXMIN(MI_BLOCK_SIZE, ds->cm->mi_rows - MI_BLOCK_SIZE*sbr);
+  const int sb = ds->nhsb*sbr + sbc;
+  const int offset = (sbr*ds->stride + sbc)*8*MI_BLOCK_SIZE;
+  uint64_t sse;
+  // Deringing with a zero threshold leaves the superblock unchanged.
+  if (level == 0) {
+    sse = vp10_dering_sse(&ds->src[offset], ds->stride, &ds->ref_coeff[offset],
+                          ds->stride, nhb << 3, nvb << 3);
+  } else {
+    DECLARE_ALIGNED(16, int16_t, dst[MI_BLOCK_SIZE*MI_BLOCK_SIZE*8*8]);
+    od_dering_filter(&ds->vtbl, dst, MI_BLOCK_SIZE*8, &ds->src[offset],
+                     ds->stride, nhb, nvb, sbc, sbr, ds->nhsb, ds->nvsb, 0,
+                     ds->dir[sb], ds->var[sb], 0,
+                     &ds->bskip[MI_BLOCK_SIZE*(sbr*ds->cm->mi_cols + sbc)],
+                     ds->cm->mi_cols, level << ds->coeff_shift,
+                     OD_DERING_NO_CHECK_OVERLAP);
+    sse = vp10_dering_sse(dst, MI_BLOCK_SIZE*8, &ds->ref_coeff[offset],
+                          ds->stride, nhb << 3, nvb << 3);
+  }
+  return (int)(sse >> 2*ds->coeff_shift);
+}
+
+static void search_sb(DeringSearch *ds, int sbr, int sbc) {
+  const int sb = ds->nhsb*sbr + sbc;
+  int *const mse = ds->mse[sb];
+  int level;
+  if (sb_all_skip(ds->cm, MI_BLOCK_SIZE*sbr, MI_BLOCK_SIZE*sbc)) {
+    // Every block is left unchanged, whatever the level.
+    mse[0] = compute_dist(ds, sbr, sbc, 0);
+    for (level = 1; level < MAX_DERING_LEVEL; level++) mse[level] = mse[0];
+    ds->exact[sb] = ~(uint64_t)0;
+    return;
+  }
+  od_dering_find_dir(&ds->src[(sbr*ds->stride + sbc)*8*MI_BLOCK_SIZE],
+                     ds->stride,
+                     VPXMIN(MI_BLOCK_SIZE, ds->cm->mi_cols - MI_BLOCK_SIZE*sbc),
+                     VPXMIN(MI_BLOCK_SIZE, ds->cm->mi_rows - MI_BLOCK_SIZE*sbr),
+                     ds->dir[sb], ds->var[sb], ds->coeff_shift);
+  if (ds->method == DERING_FULL_SEARCH) {
+    for (level = 0; level < MAX_DERING_LEVEL; level++) {
+      mse[level] = compute_dist(ds, sbr, sbc, level);
+    }
+    ds->exact[sb] = ~(uint64_t)0;
+  } else {
+    int best_mse = INT_MAX;
+    int worse = 0;
+    int last = 0;
+    ds->exact[sb] = 0;
+    for (level = 0; level < MAX_DERING_LEVEL && worse < DERING_COARSE_BREAKOUT;
+         level += DERING_COARSE_STEP) {
+      mse[level] = compute_dist(ds, sbr, sbc, level);
+      ds->exact[sb] |= (uint64_t)1 << level;
+      if (level > 0) {
+        // Interpolate the levels skipped since the previous one.
+        int l;
+        for (l = last + 1; l < level; l++) {
+          mse[l] = mse[last] +
+              (int)((int64_t)(mse[level] - mse[last])*(l - last)/
+                    (level - last));
+        }
+      }
+      if (mse[level] < best_mse) {
+        best_mse = mse[level];
+        worse = 0;
+      } else {
+        worse++;
+      }
+      last = level;
+    }
+    // The levels past the last one tried are assumed to be no better.
+    for (level = last + 1; level < MAX_DERING_LEVEL; level++) {
+      mse[level] = mse[last];
+    }
+  }
+}
+
+// Measure the levels the per superblock refinement can pick for the chosen
+// global level, where the first pass of the fast search only estimated them.
+static void refine_sb(DeringSearch *ds, int sbr, int sbc) {
+  const int sb = ds->nhsb*sbr + sbc;
+  int gi;
+  for (gi = 0; gi < DERING_REFINEMENT_LEVELS; gi++) {
+    const int level = compute_level_from_index(ds->refine_level, gi);
+    if (!(ds->exact[sb] & ((uint64_t)1 << level))) {
+      ds->mse[sb][level] = compute_dist(ds, sbr, sbc, level);
+      ds->exact[sb] |= (uint64_t)1 << level;
+    }
+  }
+}
+
+static int dering_search_worker(DeringSearch *const ds,
+                                DeringSearchWorkerData *const data) {
+  int sbr, sbc;
+  for (sbr = data->start; sbr < ds->nvsb; sbr += ds->num_workers) {
+    for (sbc = 0; sbc < ds->nhsb; sbc++) {
+      if (ds->refine_level < 0)
+        search_sb(ds, sbr, sbc);
+      else
+        refine_sb(ds, sbr, sbc);
     }
   }
-  return sum/(double)(1 << 2*coeff_shift);
+  return 1;
+}
+
+// Run the current pass of the search on all superblocks, one superblock row
+// per job at a time.
+static void search_rows(DeringSearch *ds, VP10_COMP *cpi,
+                        DeringSearchWorkerData *worker_data) {
+  VPxJobGroup group;
+  int queued = 1;
+  int i;
+  vpx_job_group_init(&group, ds->num_workers > 1 ? cpi->thread_pool : NULL);
+  for (i = 0; i < ds->num_workers; ++i) {
+    worker_data[i].start = i;
+    queued &= vpx_job_group_submit(
+        &group, (VPxWorkerHook)dering_search_worker, ds, &worker_data[i]);
+  }
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue dering search jobs");
 }
 
 int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
-                       VP10_COMMON *cm,
-                       MACROBLOCKD *xd) {
+                       VP10_COMP *cpi, DERING_SEARCH_METHOD method) {
+  VP10_COMMON *const cm = &cpi->common;
+  DeringSearch ds;
+  DeringSearchWorkerData *worker_data;
   int r, c;
   int sbr, sbc;
   int nhsb, nvsb;
-  od_dering_in *src;
-  int16_t *ref_coeff;
-  unsigned char *bskip;
-  int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS] = {{0}};
   int stride;
-  int bsize[3];
-  int dec[3];
-  int pli;
-  int (*mse)[MAX_DERING_LEVEL];
-  int best_count[MAX_DERING_LEVEL] = {0};
-  double tot_mse[MAX_DERING_LEVEL] = {0};
   int level;
   int best_level;
+#if DERING_REFINEMENT
   int global_level;
   double best_tot_mse = 1e15;
-  int coeff_shift = VPXMAX(cm->bit_depth - 8, 0);
-  src = vpx_malloc(sizeof(*src)*cm->mi_rows*cm->mi_cols*64);
-  ref_coeff = vpx_malloc(sizeof(*ref_coeff)*cm->mi_rows*cm->mi_cols*64);
-  bskip = vpx_malloc(sizeof(*bskip)*cm->mi_rows*cm->mi_cols);
-  vp10_setup_dst_planes(xd->plane, frame, 0, 0);
-  for (pli = 0; pli < 3; pli++) {
-    dec[pli] = xd->plane[pli].subsampling_x;
-    bsize[pli] = 8 >> dec[pli];
-  }
-  stride = bsize[0]*cm->mi_cols;
-  for (r = 0; r < bsize[0]*cm->mi_rows; ++r) {
-    for (c = 0; c < bsize[0]*cm->mi_cols; ++c) {
+#else
+  double tot_mse[MAX_DERING_LEVEL] = {0};
+#endif
+  memset(&ds, 0, sizeof(ds));
+  ds.cm = cm;
+  ds.method = method;
+  ds.coeff_shift = VPXMAX(cm->bit_depth - 8, 0);
+  ds.refine_level = -1;
+  vp10_dering_init_vtbl(&ds.vtbl);
+  nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
+  nhsb = (cm->mi_cols + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
+  ds.nvsb = nvsb;
+  ds.nhsb = nhsb;
+  ds.num_workers = VPXMAX(VPXMIN(cpi->num_workers, nvsb), 1);
+  stride = ds.stride = 8*cm->mi_cols;
+  CHECK_MEM_ERROR(cm, ds.src,
+                  vpx_malloc(sizeof(*ds.src)*cm->mi_rows*cm->mi_cols*64));
+  CHECK_MEM_ERROR(cm, ds.ref_coeff,
+                  vpx_malloc(sizeof(*ds.ref_coeff)*cm->mi_rows*cm->mi_cols*
+                             64));
+  CHECK_MEM_ERROR(cm, ds.bskip,
+                  vpx_malloc(sizeof(*ds.bskip)*cm->mi_rows*cm->mi_cols));
+  CHECK_MEM_ERROR(cm, ds.mse, vpx_malloc(nvsb*nhsb*sizeof(*ds.mse)));
+  CHECK_MEM_ERROR(cm, ds.exact, vpx_malloc(nvsb*nhsb*sizeof(*ds.exact)));
+  CHECK_MEM_ERROR(cm, ds.dir, vpx_malloc(nvsb*nhsb*sizeof(*ds.dir)));
+  CHECK_MEM_ERROR(cm, ds.var, vpx_malloc(nvsb*nhsb*sizeof(*ds.var)));
+  CHECK_MEM_ERROR(cm, worker_data,
+                  vpx_malloc(ds.num_workers*sizeof(*worker_data)));
+  for (r = 0; r < 8*cm->mi_rows; ++r) {
+    for (c = 0; c < 8*cm->mi_cols; ++c) {
 #if CONFIG_VPX_HIGHBITDEPTH
       if (cm->use_highbitdepth) {
-        src[r * stride + c] =
-            CONVERT_TO_SHORTPTR(xd->plane[0].dst.buf)
-            [r*xd->plane[0].dst.stride + c];
-        ref_coeff[r * stride + c] =
+        ds.src[r * stride + c] =
+            CONVERT_TO_SHORTPTR(frame->y_buffer)[r*frame->y_stride + c];
+        ds.ref_coeff[r * stride + c] =
             CONVERT_TO_SHORTPTR(ref->y_buffer)[r * ref->y_stride + c];
       } else {
 #endif
-        src[r * stride + c] =
-            xd->plane[0].dst.buf[r*xd->plane[0].dst.stride + c];
-        ref_coeff[r * stride + c] = ref->y_buffer[r * ref->y_stride + c];
+        ds.src[r * stride + c] = frame->y_buffer[r*frame->y_stride + c];
+        ds.ref_coeff[r * stride + c] = ref->y_buffer[r * ref->y_stride + c];
 #if CONFIG_VPX_HIGHBITDEPTH
       }
 #endif
@@ -86,46 +260,10 @@ int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
     for (c = 0; c < cm->mi_cols; ++c) {
       const MB_MODE_INFO *mbmi =
           &cm->mi_grid_visible[r * cm->mi_stride + c]->mbmi;
-      bskip[r * cm->mi_cols + c] = mbmi->skip;
-    }
-  }
-  nvsb = (cm->mi_rows + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
-  nhsb = (cm->mi_cols + MI_BLOCK_SIZE - 1)/MI_BLOCK_SIZE;
-  mse = vpx_malloc(nvsb*nhsb*sizeof(*mse));
-  for (sbr = 0; sbr < nvsb; sbr++) {
-    for (sbc = 0; sbc < nhsb; sbc++) {
-      int best_mse = 1000000000;
-      int nvb, nhb;
-      int16_t dst[MI_BLOCK_SIZE*MI_BLOCK_SIZE*8*8];
-      best_level = 0;
-      nhb = VPXMIN(MI_BLOCK_SIZE, cm->mi_cols - MI_BLOCK_SIZE*sbc);
-      nvb = VPXMIN(MI_BLOCK_SIZE, cm->mi_rows - MI_BLOCK_SIZE*sbr);
-      for (level = 0; level < 64; level++) {
-        int threshold;
-        threshold = level << coeff_shift;
-        od_dering(
-            &OD_DERING_VTBL_C,
-            dst,
-            MI_BLOCK_SIZE*bsize[0],
-            &src[sbr*stride*bsize[0]*MI_BLOCK_SIZE +
-            sbc*bsize[0]*MI_BLOCK_SIZE],
-            cm->mi_cols*bsize[0], nhb, nvb, sbc, sbr, nhsb, nvsb, 0, dir, 0,
-            &bskip[MI_BLOCK_SIZE*sbr*cm->mi_cols + MI_BLOCK_SIZE*sbc],
-            cm->mi_cols, threshold, OD_DERING_NO_CHECK_OVERLAP, coeff_shift);
-        mse[nhsb*sbr+sbc][level] = compute_dist(
-            dst, MI_BLOCK_SIZE*bsize[0],
-            &ref_coeff[sbr*stride*bsize[0]*MI_BLOCK_SIZE +
-            sbc*bsize[0]*MI_BLOCK_SIZE],
-            stride, nhb, nvb, coeff_shift);
-        tot_mse[level] += mse[nhsb*sbr+sbc][level];
-        if (mse[nhsb*sbr+sbc][level] < best_mse) {
-          best_mse = mse[nhsb*sbr+sbc][level];
-          best_level = level;
-        }
-      }
-      best_count[best_level]++;
+      ds.bskip[r * cm->mi_cols + c] = mbmi->skip;
     }
   }
+  search_rows(&ds, cpi, worker_data);
 #if DERING_REFINEMENT
   best_level = 0;
   /* Search for the best global level one value at a time. */
@@ -134,11 +272,11 @@ int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
     for (sbr = 0; sbr < nvsb; sbr++) {
       for (sbc = 0; sbc < nhsb; sbc++) {
         int gi;
-        int best_mse = mse[nhsb*sbr+sbc][0];
+        int best_mse = ds.mse[nhsb*sbr+sbc][0];
         for (gi = 1; gi < 4; gi++) {
           level = compute_level_from_index(global_level, gi);
-          if (mse[nhsb*sbr+sbc][level] < best_mse) {
-            best_mse = mse[nhsb*sbr+sbc][level];
+          if (ds.mse[nhsb*sbr+sbc][level] < best_mse) {
+            best_mse = ds.mse[nhsb*sbr+sbc][level];
           }
         }
         tot_mse += best_mse;
@@ -149,17 +287,21 @@ int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
       best_tot_mse = tot_mse;
     }
   }
+  if (method != DERING_FULL_SEARCH) {
+    ds.refine_level = best_level;
+    search_rows(&ds, cpi, worker_data);
+  }
   for (sbr = 0; sbr < nvsb; sbr++) {
     for (sbc = 0; sbc < nhsb; sbc++) {
       int gi;
       int best_gi;
-      int best_mse = mse[nhsb*sbr+sbc][0];
+      int best_mse = ds.mse[nhsb*sbr+sbc][0];
       best_gi = 0;
       for (gi = 1; gi < DERING_REFINEMENT_LEVELS; gi++) {
         level = compute_level_from_index(best_level, gi);
-        if (mse[nhsb*sbr+sbc][level] < best_mse) {
+        if (ds.mse[nhsb*sbr+sbc][level] < best_mse) {
           best_gi = gi;
-          best_mse = mse[nhsb*sbr+sbc][level];
+          best_mse = ds.mse[nhsb*sbr+sbc][level];
         }
       }
       cm->mi_grid_visible[MI_BLOCK_SIZE*sbr*cm->mi_stride + MI_BLOCK_SIZE*sbc]->
@@ -167,14 +309,25 @@ int vp10_dering_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
     }
   }
 #else
+  for (sbr = 0; sbr < nvsb; sbr++) {
+    for (sbc = 0; sbc < nhsb; sbc++) {
+      for (level = 0; level < MAX_DERING_LEVEL; level++) {
+        tot_mse[level] += ds.mse[nhsb*sbr+sbc][level];
+      }
+    }
+  }
   best_level = 0;
   for (level = 0; level < MAX_DERING_LEVEL; level++) {
     if (tot_mse[level] < tot_mse[best_level]) best_level = level;
   }
 #endif
-  vpx_free(src);
-  vpx_free(ref_coeff);
-  vpx_free(bskip);
-  vpx_free(mse);
+  vpx_free(ds.src);
+  vpx_free(ds.ref_coeff);
+  vpx_free(ds.bskip);
+  vpx_free(ds.mse);
+  vpx_free(ds.exact);
+  vpx_free(ds.dir);
+  vpx_free(ds.var);
+  vpx_free(worker_data);
   return best_level;
 }
@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VP10_ENCODER_PICKDERING_H_
+#define VP10_ENCODER_PICKDERING_H_
+
+#include "vp10/encoder/encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct yv12_buffer_config;
+struct VP10_COMP;
+
+// Returns the global deringing level for 'frame' and stores the per
+// superblock refinement in its mode info. The superblock rows are searched
+// in parallel when the encoder has more than one worker.
+int vp10_dering_search(struct yv12_buffer_config *frame,
+                       const struct yv12_buffer_config *ref,
+                       struct VP10_COMP *cpi, DERING_SEARCH_METHOD method);
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VP10_ENCODER_PICKDERING_H_
@@ -34,39 +34,159 @@ static int get_max_filter_level(const VP10_COMP *cpi) {
   }
 }
 
+// The subimage search filters every LPF_SAMPLE_STEP-th superblock row. The
+// rows are far enough apart that filtering one does not touch the pixels of
+// another, so each can be filtered, measured and restored on its own.
+#define LPF_SAMPLE_STEP 4
+
+// The superblock rows one worker filters and measures for a filter level.
+typedef struct LFPickWorkerData {
+  VP10_COMP *cpi;
+  const YV12_BUFFER_CONFIG *sd;
+  struct macroblockd_plane planes[MAX_MB_PLANE];
+  // Loop filter each row before measuring it, for the sampled rows only.
+  int filter;
+  // Measure the lines above each row that the filter changes as well.
+  int sampled;
+  int start;
+  int step;
+  int64_t sse;
+} LFPickWorkerData;
+
+static void copy_y_rows(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst,
+                        int row, int rows) {
+  int r;
+#if CONFIG_VPX_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+    const uint16_t *src16 =
+        CONVERT_TO_SHORTPTR(src->y_buffer) + row * src->y_stride;
+    uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst->y_buffer) + row * dst->y_stride;
+    for (r = 0; r < rows; ++r) {
+      memcpy(dst16, src16, src->y_width * sizeof(uint16_t));
+      src16 += src->y_stride;
+      dst16 += dst->y_stride;
+    }
+    return;
+  }
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+  {
+    const uint8_t *src8 = src->y_buffer + row * src->y_stride;
+    uint8_t *dst8 = dst->y_buffer + row * dst->y_stride;
+    for (r = 0; r < rows; ++r) {
+      memcpy(dst8, src8, src->y_width);
+      src8 += src->y_stride;
+      dst8 += dst->y_stride;
+    }
+  }
+}
+
+// Filters (if asked to) the superblock rows of 'data', adds up their error
+// against the source and then puts back the unfiltered pixels.
+static int pick_rows_worker(LFPickWorkerData *const data, void *unused) {
+  VP10_COMP *const cpi = data->cpi;
+  VP10_COMMON *const cm = &cpi->common;
+  YV12_BUFFER_CONFIG *const frame = cm->frame_to_show;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  int sb_row;
+
+  (void)unused;
+  data->sse = 0;
+
+  for (sb_row = data->start; sb_row < sb_rows; sb_row += data->step) {
+    const int mi_row = sb_row << MI_BLOCK_SIZE_LOG2;
+    // Filtering the top edge of a row changes up to 8 lines of the row above.
+    const int top = data->sampled ? VPXMAX(mi_row * MI_SIZE - 8, 0)
+                                  : mi_row * MI_SIZE;
+    const int bottom =
+        VPXMIN((mi_row + MI_BLOCK_SIZE) * MI_SIZE, frame->y_height);
+
+    if (data->filter)
+      vp10_loop_filter_rows(frame, cm, data->planes, mi_row,
+                            mi_row + MI_BLOCK_SIZE, 1);
+
+#if CONFIG_VPX_HIGHBITDEPTH
+    if (cm->use_highbitdepth) {
+      data->sse += vp10_highbd_get_y_sse_rows(
+          data->sd, frame, top, VPXMIN(bottom, frame->y_crop_height) - top);
+    } else {
+      data->sse += vp10_get_y_sse_rows(
+          data->sd, frame, top, VPXMIN(bottom, frame->y_crop_height) - top);
+    }
+#else
+    data->sse += vp10_get_y_sse_rows(
+        data->sd, frame, top, VPXMIN(bottom, frame->y_crop_height) - top);
+#endif  // CONFIG_VPX_HIGHBITDEPTH
+
+    // Re-instate the unfiltered rows
+    copy_y_rows(&cpi->last_frame_uf, frame, top, bottom - top);
+  }
+  return 1;
+}
+
+// Runs pick_rows_worker() over every 'step'-th superblock row from 'start',
+// sharing the rows between the encoder jobs, and returns the total error.
+static int64_t pick_rows(const YV12_BUFFER_CONFIG *sd, VP10_COMP *const cpi,
+                         LFPickWorkerData *const pick_data, int filter,
+                         int sampled, int start, int step) {
+  const VP10_COMMON *const cm = &cpi->common;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+  const int jobs = (sb_rows - start + step - 1) / step;
+  const int num_workers = VPXMAX(VPXMIN(cpi->num_workers, jobs), 1);
+  VPxJobGroup group;
+  int64_t sse = 0;
+  int queued = 1;
+  int i;
+
+  vpx_job_group_init(&group, num_workers > 1 ? cpi->thread_pool : NULL);
+  for (i = 0; i < num_workers; ++i) {
+    LFPickWorkerData *const data = &pick_data[i];
+    data->cpi = cpi;
+    data->sd = sd;
+    memcpy(data->planes, cpi->td.mb.e_mbd.plane, sizeof(data->planes));
+    data->filter = filter;
+    data->sampled = sampled;
+    data->start = start + i * step;
+    data->step = num_workers * step;
+    queued &= vpx_job_group_submit(&group, (VPxWorkerHook)pick_rows_worker,
+                                   data, NULL);
+  }
+  vpx_job_group_wait(&group);
+  if (!queued)
+    vpx_internal_error(&cpi->common.error, VPX_CODEC_MEM_ERROR,
+                       "Failed to queue loop filter search jobs");
+
+  for (i = 0; i < num_workers; ++i) sse += pick_data[i].sse;
+  return sse;
+}
+
 static int64_t try_filter_frame(const YV12_BUFFER_CONFIG *sd,
                                 VP10_COMP *const cpi, int filt_level,
-                                int partial_frame) {
+                                int partial_frame,
+                                LFPickWorkerData *const pick_data) {
   VP10_COMMON *const cm = &cpi->common;
-  int64_t filt_err;
+
+  if (partial_frame) {
+    if (filt_level) vp10_loop_filter_frame_init(cm, filt_level);
+    return pick_rows(sd, cpi, pick_data, filt_level != 0, 1,
+                     LPF_SAMPLE_STEP / 2, LPF_SAMPLE_STEP);
+  }
 
   if (cpi->num_workers > 1)
     vp10_loop_filter_frame_mt(cm->frame_to_show, cm, cpi->td.mb.e_mbd.plane,
-                              filt_level, 1, partial_frame, cpi->workers,
+                              filt_level, 1, 0, cpi->thread_pool,
                               cpi->num_workers, &cpi->lf_row_sync);
   else
     vp10_loop_filter_frame(cm->frame_to_show, cm, &cpi->td.mb.e_mbd, filt_level,
-                           1, partial_frame);
+                           1, 0);
 
-#if CONFIG_VPX_HIGHBITDEPTH
-  if (cm->use_highbitdepth) {
-    filt_err = vp10_highbd_get_y_sse(sd, cm->frame_to_show);
-  } else {
-    filt_err = vp10_get_y_sse(sd, cm->frame_to_show);
-  }
-#else
-  filt_err = vp10_get_y_sse(sd, cm->frame_to_show);
-#endif  // CONFIG_VPX_HIGHBITDEPTH
-
-  // Re-instate the unfiltered frame
-  vpx_yv12_copy_y(&cpi->last_frame_uf, cm->frame_to_show);
-
-  return filt_err;
+  // The error and the restore of the whole frame are split by superblock
+  // row between the workers too.
+  return pick_rows(sd, cpi, pick_data, 0, 0, 0, 1);
 }
 
 static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
                                int partial_frame) {
-  const VP10_COMMON *const cm = &cpi->common;
+  VP10_COMMON *const cm = &cpi->common;
   const struct loopfilter *const lf = &cm->lf;
   const int min_filter_level = 0;
   const int max_filter_level = get_max_filter_level(cpi);
@@ -80,6 +200,14 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
   int filter_step = filt_mid < 16 ? 4 : filt_mid / 4;
   // Sum squared error at each filter level
   int64_t ss_err[MAX_LOOP_FILTER + 1];
+  LFPickWorkerData *pick_data;
+  const int sb_rows = mi_cols_aligned_to_sb(cm->mi_rows) >> MI_BLOCK_SIZE_LOG2;
+
+  // Too few rows to sample from, search with the full image.
+  if (sb_rows < 2 * LPF_SAMPLE_STEP) partial_frame = 0;
+
+  CHECK_MEM_ERROR(cm, pick_data,
+                  vpx_malloc(VPXMAX(cpi->num_workers, 1) * sizeof(*pick_data)));
 
   // Set each entry to -1
   memset(ss_err, 0xFF, sizeof(ss_err));
@@ -87,7 +215,7 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
   //  Make a copy of the unfiltered / processed recon buffer
   vpx_yv12_copy_y(cm->frame_to_show, &cpi->last_frame_uf);
 
-  best_err = try_filter_frame(sd, cpi, filt_mid, partial_frame);
+  best_err = try_filter_frame(sd, cpi, filt_mid, partial_frame, pick_data);
   filt_best = filt_mid;
   ss_err[filt_mid] = best_err;
 
@@ -107,7 +235,8 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
     if (filt_direction <= 0 && filt_low != filt_mid) {
       // Get Low filter error score
       if (ss_err[filt_low] < 0) {
-        ss_err[filt_low] = try_filter_frame(sd, cpi, filt_low, partial_frame);
+        ss_err[filt_low] =
+            try_filter_frame(sd, cpi, filt_low, partial_frame, pick_data);
       }
       // If value is close to the best so far then bias towards a lower loop
       // filter value.
@@ -122,7 +251,8 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
     // Now look at filt_high
     if (filt_direction >= 0 && filt_high != filt_mid) {
       if (ss_err[filt_high] < 0) {
-        ss_err[filt_high] = try_filter_frame(sd, cpi, filt_high, partial_frame);
+        ss_err[filt_high] =
+            try_filter_frame(sd, cpi, filt_high, partial_frame, pick_data);
       }
       // Was it better than the previous best?
       if (ss_err[filt_high] < (best_err - bias)) {
@@ -141,6 +271,7 @@ static int search_filter_level(const YV12_BUFFER_CONFIG *sd, VP10_COMP *cpi,
     }
   }
 
+  vpx_free(pick_data);
   return filt_best;
 }
 
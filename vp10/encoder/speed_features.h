@@ -99,7 +99,8 @@ typedef enum {
 typedef enum {
   // Try the full image with different values.
   LPF_PICK_FROM_FULL_IMAGE,
-  // Try a small portion of the image with different values.
+  // Try a sample of superblock rows spread over the image with different
+  // values.
   LPF_PICK_FROM_SUBIMAGE,
   // Estimate the level based on quantizer and frame type
   LPF_PICK_FROM_Q,
@@ -107,6 +108,14 @@ typedef enum {
   LPF_PICK_MINIMAL_LPF
 } LPF_PICK_METHOD;
 
+typedef enum {
+  // Try every deringing level on every superblock.
+  DERING_FULL_SEARCH,
+  // Try a coarse subset of the levels, stopping once the distortion keeps
+  // increasing, and refine around the best global level.
+  DERING_FAST_SEARCH
+} DERING_SEARCH_METHOD;
+
 typedef enum {
   // Terminate search early based on distortion so far compared to
   // qp step, distortion in the neighborhood of the frame, etc.
@@ -360,6 +369,9 @@ typedef struct SPEED_FEATURES {
   // This feature controls how the loop filter level is determined.
   LPF_PICK_METHOD lpf_pick;
 
+  // This feature controls how the deringing level is determined.
+  DERING_SEARCH_METHOD dering_search;
+
   // This feature limits the number of coefficients updates we actually do
   // by only looking at counts from 1/2 the bands.
   FAST_COEFF_UPDATE use_fast_coef_updates;
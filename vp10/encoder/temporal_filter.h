@@ -11,12 +11,33 @@
 #ifndef VP10_ENCODER_TEMPORAL_FILTER_H_
 #define VP10_ENCODER_TEMPORAL_FILTER_H_
 
+#include "vpx_scale/yv12config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct scale_factors;
+struct ThreadData;
+
+// The frames and the parameters an alt-ref frame is filtered with.
+typedef struct ARNRFilterData {
+  YV12_BUFFER_CONFIG **frames;
+  int frame_count;
+  int alt_ref_index;
+  int strength;
+  struct scale_factors *scale;
+  int mb_rows;
+  int mb_cols;
+} ARNRFilterData;
+
 void vp10_temporal_filter(VP10_COMP *cpi, int distance);
 
+// Filters macroblock row 'mb_row' of the alt-ref frame into
+// cpi->alt_ref_buffer. The rows do not depend on each other.
+void vp10_temporal_filter_row(VP10_COMP *cpi, struct ThreadData *td,
+                              const ARNRFilterData *filter_data, int mb_row);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
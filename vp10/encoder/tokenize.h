@@ -33,7 +33,7 @@ typedef struct {
   EXTRABIT extra;
 } TOKENVALUE;
 
-typedef struct {
+typedef struct TOKENEXTRA {
   const vpx_prob *context_tree;
   EXTRABIT extra;
   uint8_t token;
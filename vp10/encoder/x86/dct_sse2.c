@@ -2041,3 +2041,156 @@ void vp10_fht16x16_sse2(const int16_t *input, tran_low_t *output, int stride,
     default: assert(0); break;
   }
 }
+
+#if !CONFIG_VPX_HIGHBITDEPTH
+// The fused 32x32 kernel reuses the transform of
+// vp10/common/x86/vp10_fwd_dct32x32_impl_sse2.h, which hands every register
+// of final coefficients to quantize_and_store_output(). The coefficients are
+// still written out for optimize_b().
+typedef struct {
+  const int16_t *coeff_ptr;
+  int16_t *qcoeff_ptr;
+  int16_t *dqcoeff_ptr;
+  const int16_t *iscan_ptr;
+  __m128i round, quant, dequant;
+  __m128i eob;
+} fdct_quantizer;
+
+// Only the AC quantizer is kept in registers, fdct_quantizer_finish() redoes
+// the DC coefficient.
+static INLINE void fdct_quantizer_init(fdct_quantizer *quantizer,
+                                       int16_t *coeff_ptr, int skip_block,
+                                       const int16_t *round_ptr,
+                                       const int16_t *quant_ptr,
+                                       int16_t *qcoeff_ptr,
+                                       int16_t *dqcoeff_ptr,
+                                       const int16_t *dequant_ptr,
+                                       const int16_t *iscan_ptr) {
+  const __m128i zero = _mm_setzero_si128();
+
+  quantizer->coeff_ptr = coeff_ptr;
+  quantizer->qcoeff_ptr = qcoeff_ptr;
+  quantizer->dqcoeff_ptr = dqcoeff_ptr;
+  quantizer->iscan_ptr = iscan_ptr;
+  quantizer->eob = zero;
+  if (skip_block) {
+    // A zero quantizer zeroes every coefficient.
+    quantizer->round = zero;
+    quantizer->quant = zero;
+    quantizer->dequant = zero;
+  } else {
+    quantizer->round = _mm_set1_epi16(ROUND_POWER_OF_TWO(round_ptr[1], 1));
+    quantizer->quant = _mm_set1_epi16(quant_ptr[1]);
+    quantizer->dequant = _mm_set1_epi16(dequant_ptr[1]);
+  }
+}
+
+// Stores the 8 coefficients of *poutput at dst_ptr, and quantizes them as
+// vp10_quantize_fp_32x32_c() does.
+static INLINE void quantize_and_store_output(fdct_quantizer *quantizer,
+                                             const __m128i *poutput,
+                                             int16_t *dst_ptr) {
+  const intptr_t i = dst_ptr - quantizer->coeff_ptr;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i round = quantizer->round;
+  const __m128i quant = quantizer->quant;
+  const __m128i dequant = quantizer->dequant;
+  const __m128i coeff = *poutput;
+  const __m128i sign = _mm_srai_epi16(coeff, 15);
+  const __m128i abs_coeff = _mm_sub_epi16(_mm_xor_si128(coeff, sign), sign);
+  const __m128i tmp = _mm_adds_epi16(abs_coeff, round);
+  // (tmp * quant) >> 15 and (qcoeff * dequant) >> 1 from the 32-bit
+  // products, for the coefficients at least a quarter of dequant.
+  const __m128i skip = _mm_cmplt_epi16(abs_coeff, _mm_srai_epi16(dequant, 2));
+  __m128i qcoeff, dqcoeff, nzero, iscan;
+
+  _mm_storeu_si128((__m128i *)dst_ptr, coeff);
+
+  qcoeff = _mm_or_si128(_mm_slli_epi16(_mm_mulhi_epi16(tmp, quant), 1),
+                        _mm_srli_epi16(_mm_mullo_epi16(tmp, quant), 15));
+  qcoeff = _mm_andnot_si128(skip, qcoeff);
+  dqcoeff = _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(qcoeff, dequant), 1),
+                         _mm_slli_epi16(_mm_mulhi_epi16(qcoeff, dequant), 15));
+
+  // Reinsert signs
+  qcoeff = _mm_sub_epi16(_mm_xor_si128(qcoeff, sign), sign);
+  dqcoeff = _mm_sub_epi16(_mm_xor_si128(dqcoeff, sign), sign);
+  _mm_store_si128((__m128i *)(quantizer->qcoeff_ptr + i), qcoeff);
+  _mm_store_si128((__m128i *)(quantizer->dqcoeff_ptr + i), dqcoeff);
+
+  // Scan for eob, adding one to convert from indices to counts
+  nzero = _mm_cmpeq_epi16(_mm_cmpeq_epi16(qcoeff, zero), zero);
+  iscan = _mm_load_si128((const __m128i *)(quantizer->iscan_ptr + i));
+  iscan = _mm_sub_epi16(iscan, nzero);
+  quantizer->eob = _mm_max_epi16(quantizer->eob, _mm_and_si128(iscan, nzero));
+}
+
+static INLINE uint16_t fdct_quantizer_eob(const fdct_quantizer *quantizer) {
+  __m128i eob = quantizer->eob;
+  __m128i eob_shuffled;
+  eob_shuffled = _mm_shuffle_epi32(eob, 0xe);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  eob_shuffled = _mm_shufflelo_epi16(eob, 0xe);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  eob_shuffled = _mm_shufflelo_epi16(eob, 0x1);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  return _mm_extract_epi16(eob, 1);
+}
+
+// Quantizes the DC coefficient with its own quantizer and returns the eob.
+static INLINE uint16_t fdct_quantizer_finish(const fdct_quantizer *quantizer,
+                                             int skip_block,
+                                             const int16_t *round_ptr,
+                                             const int16_t *quant_ptr,
+                                             const int16_t *dequant_ptr) {
+  const int coeff = quantizer->coeff_ptr[0];
+  const int coeff_sign = coeff >> 31;
+  const int abs_coeff = (coeff ^ coeff_sign) - coeff_sign;
+  int tmp = 0, qcoeff, eob;
+
+  if (!skip_block && abs_coeff >= (dequant_ptr[0] >> 2)) {
+    tmp = clamp(abs_coeff + ROUND_POWER_OF_TWO(round_ptr[0], 1), INT16_MIN,
+                INT16_MAX);
+    tmp = (tmp * quant_ptr[0]) >> 15;
+  }
+  qcoeff = (tmp ^ coeff_sign) - coeff_sign;
+  quantizer->qcoeff_ptr[0] = qcoeff;
+  quantizer->dqcoeff_ptr[0] = (qcoeff * dequant_ptr[0]) / 2;
+
+  // The DC coefficient is first in every scan, so it decides the eob alone
+  // when no AC coefficient is left.
+  eob = fdct_quantizer_eob(quantizer);
+  return eob > 1 ? eob : tmp != 0;
+}
+
+static void fdct32x32_rd_quant(const int16_t *input, int16_t *output,
+                               int stride, fdct_quantizer *quantizer);
+
+#define FDCT_QUANTIZER fdct_quantizer
+#define DCT_HIGH_BIT_DEPTH 0
+#define FDCT32x32_2D fdct32x32_rd_quant
+#define FDCT32x32_HIGH_PRECISION 0
+#include "vp10/common/x86/vp10_fwd_dct32x32_impl_sse2.h"
+#undef FDCT32x32_2D
+#undef FDCT32x32_HIGH_PRECISION
+#undef DCT_HIGH_BIT_DEPTH
+#undef FDCT_QUANTIZER
+
+void vp10_fdct32x32_rd_quant_sse2(
+    const int16_t *input, int stride, int16_t *coeff_ptr, intptr_t n_coeffs,
+    int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr,
+    const int16_t *quant_ptr, const int16_t *quant_shift_ptr,
+    int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+    uint16_t *eob_ptr, const int16_t *scan_ptr, const int16_t *iscan_ptr) {
+  fdct_quantizer quantizer;
+  (void)n_coeffs;
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+  fdct_quantizer_init(&quantizer, coeff_ptr, skip_block, round_ptr, quant_ptr,
+                      qcoeff_ptr, dqcoeff_ptr, dequant_ptr, iscan_ptr);
+  fdct32x32_rd_quant(input, coeff_ptr, stride, &quantizer);
+  *eob_ptr = fdct_quantizer_finish(&quantizer, skip_block, round_ptr,
+                                   quant_ptr, dequant_ptr);
+}
+#endif  // !CONFIG_VPX_HIGHBITDEPTH
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Returns the 32-bit modifiers 3 * d * d, rounded and shifted, for eight
+// differences held in 32 bits as (d, 0) pairs.
+static INLINE __m256i modifier_epi32(__m256i d, __m128i shift,
+                                     __m256i rounding) {
+  const __m256i sq = _mm256_madd_epi16(d, d);
+  const __m256i m = _mm256_add_epi32(_mm256_add_epi32(sq, sq), sq);
+  return _mm256_srl_epi32(_mm256_add_epi32(m, rounding), shift);
+}
+
+// Filters sixteen pixels, working out the modifier in 32 bits as the SSE4.1
+// version does. The unpacks and the pack both work within 128-bit lanes, so m
+// comes back in pixel order. pred, accumulator and count are contiguous, so
+// an 8 wide block is done two rows at a time.
+static INLINE void highbd_apply_16(__m256i f, const uint16_t *pred,
+                                   __m128i shift, __m256i rounding,
+                                   __m256i weight, unsigned int *accumulator,
+                                   uint16_t *count) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  const __m256i p = _mm256_loadu_si256((const __m256i *)pred);
+  const __m256i d = _mm256_sub_epi16(f, p);
+  __m256i m_lo =
+      modifier_epi32(_mm256_unpacklo_epi16(d, zero), shift, rounding);
+  __m256i m_hi =
+      modifier_epi32(_mm256_unpackhi_epi16(d, zero), shift, rounding);
+  __m256i m, c, a_lo, a_hi, mp_lo, mp_hi;
+
+  m_lo = _mm256_sub_epi32(sixteen, _mm256_min_epu32(m_lo, sixteen));
+  m_hi = _mm256_sub_epi32(sixteen, _mm256_min_epu32(m_hi, sixteen));
+  m = _mm256_mullo_epi16(_mm256_packus_epi32(m_lo, m_hi), weight);
+
+  c = _mm256_loadu_si256((const __m256i *)count);
+  _mm256_storeu_si256((__m256i *)count, _mm256_add_epi16(c, m));
+
+  // The products are interleaved within each lane: mp_lo holds pixels 0-3
+  // and 8-11, mp_hi pixels 4-7 and 12-15.
+  mp_lo = _mm256_unpacklo_epi16(_mm256_mullo_epi16(m, p),
+                                _mm256_mulhi_epu16(m, p));
+  mp_hi = _mm256_unpackhi_epi16(_mm256_mullo_epi16(m, p),
+                                _mm256_mulhi_epu16(m, p));
+  a_lo = _mm256_loadu_si256((const __m256i *)accumulator);
+  a_hi = _mm256_loadu_si256((const __m256i *)(accumulator + 8));
+  a_lo = _mm256_add_epi32(a_lo,
+                          _mm256_permute2x128_si256(mp_lo, mp_hi, 0x20));
+  a_hi = _mm256_add_epi32(a_hi,
+                          _mm256_permute2x128_si256(mp_lo, mp_hi, 0x31));
+  _mm256_storeu_si256((__m256i *)accumulator, a_lo);
+  _mm256_storeu_si256((__m256i *)(accumulator + 8), a_hi);
+}
+
+static void highbd_apply_plane(const uint16_t *frame1, unsigned int stride,
+                               const uint16_t *pred, unsigned int block_width,
+                               unsigned int block_height, __m128i shift,
+                               __m256i rounding, __m256i weight,
+                               unsigned int *accumulator, uint16_t *count) {
+  unsigned int i;
+
+  if (block_width == 16) {
+    for (i = 0; i < block_height; ++i) {
+      highbd_apply_16(_mm256_loadu_si256((const __m256i *)frame1), pred, shift,
+                      rounding, weight, accumulator, count);
+      frame1 += stride;
+      pred += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  } else {
+    for (i = 0; i < block_height; i += 2) {
+      const __m256i f = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)frame1)),
+          _mm_loadu_si128((const __m128i *)(frame1 + stride)), 1);
+      highbd_apply_16(f, pred, shift, rounding, weight, accumulator, count);
+      frame1 += 2 * stride;
+      pred += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  }
+}
+
+void vp10_highbd_temporal_filter_apply_avx2(
+    const uint8_t *y_frame1, const uint8_t *u_frame1, const uint8_t *v_frame1,
+    unsigned int y_stride, unsigned int uv_stride, const uint8_t *pred,
+    unsigned int uv_block_width, unsigned int uv_block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  const uint16_t *const pred16 = CONVERT_TO_SHORTPTR(pred);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i weight = _mm256_set1_epi16(filter_weight);
+
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(y_frame1), y_stride, pred16, 16, 16,
+                     shift, rounding, weight, accumulator, count);
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(u_frame1), uv_stride, pred16 + 256,
+                     uv_block_width, uv_block_height, shift, rounding, weight,
+                     accumulator + 256, count + 256);
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(v_frame1), uv_stride, pred16 + 512,
+                     uv_block_width, uv_block_height, shift, rounding, weight,
+                     accumulator + 512, count + 512);
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Returns the 32-bit modifiers 3 * d * d, rounded and shifted, for four
+// differences held in 32 bits as (d, 0) pairs.
+static INLINE __m128i modifier_epi32(__m128i d, __m128i shift,
+                                     __m128i rounding) {
+  const __m128i sq = _mm_madd_epi16(d, d);
+  const __m128i m = _mm_add_epi32(_mm_add_epi32(sq, sq), sq);
+  return _mm_srl_epi32(_mm_add_epi32(m, rounding), shift);
+}
+
+// Filters eight pixels. The difference of two 12-bit pixels fits in 16 bits
+// but its square does not, so the modifier is worked out in 32 bits and
+// narrowed once it is clamped. pred, accumulator and count are contiguous.
+static INLINE void highbd_apply_8(const uint16_t *frame1, const uint16_t *pred,
+                                  __m128i shift, __m128i rounding,
+                                  __m128i weight, unsigned int *accumulator,
+                                  uint16_t *count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i sixteen = _mm_set1_epi32(16);
+  const __m128i f = _mm_loadu_si128((const __m128i *)frame1);
+  const __m128i p = _mm_loadu_si128((const __m128i *)pred);
+  const __m128i d = _mm_sub_epi16(f, p);
+  __m128i m_lo = modifier_epi32(_mm_unpacklo_epi16(d, zero), shift, rounding);
+  __m128i m_hi = modifier_epi32(_mm_unpackhi_epi16(d, zero), shift, rounding);
+  __m128i m, c, a_lo, a_hi, mp_lo, mp_hi;
+
+  m_lo = _mm_sub_epi32(sixteen, _mm_min_epu32(m_lo, sixteen));
+  m_hi = _mm_sub_epi32(sixteen, _mm_min_epu32(m_hi, sixteen));
+  m = _mm_mullo_epi16(_mm_packus_epi32(m_lo, m_hi), weight);
+
+  c = _mm_loadu_si128((const __m128i *)count);
+  _mm_storeu_si128((__m128i *)count, _mm_add_epi16(c, m));
+
+  mp_lo = _mm_mullo_epi16(m, p);
+  mp_hi = _mm_mulhi_epu16(m, p);
+  a_lo = _mm_loadu_si128((const __m128i *)accumulator);
+  a_hi = _mm_loadu_si128((const __m128i *)(accumulator + 4));
+  a_lo = _mm_add_epi32(a_lo, _mm_unpacklo_epi16(mp_lo, mp_hi));
+  a_hi = _mm_add_epi32(a_hi, _mm_unpackhi_epi16(mp_lo, mp_hi));
+  _mm_storeu_si128((__m128i *)accumulator, a_lo);
+  _mm_storeu_si128((__m128i *)(accumulator + 4), a_hi);
+}
+
+static void highbd_apply_plane(const uint16_t *frame1, unsigned int stride,
+                               const uint16_t *pred, unsigned int block_width,
+                               unsigned int block_height, __m128i shift,
+                               __m128i rounding, __m128i weight,
+                               unsigned int *accumulator, uint16_t *count) {
+  unsigned int i, j;
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      highbd_apply_8(frame1 + j, pred, shift, rounding, weight, accumulator,
+                     count);
+      pred += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride;
+  }
+}
+
+void vp10_highbd_temporal_filter_apply_sse4_1(
+    const uint8_t *y_frame1, const uint8_t *u_frame1, const uint8_t *v_frame1,
+    unsigned int y_stride, unsigned int uv_stride, const uint8_t *pred,
+    unsigned int uv_block_width, unsigned int uv_block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  const uint16_t *const pred16 = CONVERT_TO_SHORTPTR(pred);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m128i rounding =
+      _mm_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m128i weight = _mm_set1_epi16(filter_weight);
+
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(y_frame1), y_stride, pred16, 16, 16,
+                     shift, rounding, weight, accumulator, count);
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(u_frame1), uv_stride, pred16 + 256,
+                     uv_block_width, uv_block_height, shift, rounding, weight,
+                     accumulator + 256, count + 256);
+  highbd_apply_plane(CONVERT_TO_SHORTPTR(v_frame1), uv_stride, pred16 + 512,
+                     uv_block_width, uv_block_height, shift, rounding, weight,
+                     accumulator + 512, count + 512);
+}
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+uint64_t vp10_dering_sse_avx2(const int16_t *a, int a_stride,
+                              const int16_t *b, int b_stride, int width,
+                              int height) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sse = _mm256_setzero_si256();
+  __m128i sum;
+  uint64_t result;
+  int i, j;
+
+  if (width & 7)
+    return vp10_dering_sse_c(a, a_stride, b, b_stride, width, height);
+
+  for (i = 0; i < height; ++i) {
+    // See vp10_dering_sse_sse2().
+    __m256i row = _mm256_setzero_si256();
+    for (j = 0; j + 16 <= width; j += 16) {
+      const __m256i d =
+          _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(a + j)),
+                           _mm256_loadu_si256((const __m256i *)(b + j)));
+      row = _mm256_add_epi32(row, _mm256_madd_epi16(d, d));
+    }
+    if (j < width) {
+      const __m128i d =
+          _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(a + j)),
+                        _mm_loadu_si128((const __m128i *)(b + j)));
+      row = _mm256_add_epi32(
+          row, _mm256_castsi128_si256(_mm_madd_epi16(d, d)));
+    }
+    sse = _mm256_add_epi64(sse, _mm256_unpacklo_epi32(row, zero));
+    sse = _mm256_add_epi64(sse, _mm256_unpackhi_epi32(row, zero));
+    a += a_stride;
+    b += b_stride;
+  }
+  sum = _mm_add_epi64(_mm256_castsi256_si128(sse),
+                      _mm256_extracti128_si256(sse, 1));
+  sum = _mm_add_epi64(sum, _mm_srli_si128(sum, 8));
+  _mm_storel_epi64((__m128i *)&result, sum);
+  return result;
+}
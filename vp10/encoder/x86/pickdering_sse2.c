@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+uint64_t vp10_dering_sse_sse2(const int16_t *a, int a_stride,
+                              const int16_t *b, int b_stride, int width,
+                              int height) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sse = _mm_setzero_si128();
+  uint64_t result;
+  int i, j;
+
+  if (width & 7)
+    return vp10_dering_sse_c(a, a_stride, b, b_stride, width, height);
+
+  for (i = 0; i < height; ++i) {
+    // The squared differences of a row fit in 32 bits for any bit depth, so
+    // they are only widened to 64 bits once per row.
+    __m128i row = _mm_setzero_si128();
+    for (j = 0; j < width; j += 8) {
+      const __m128i d =
+          _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(a + j)),
+                        _mm_loadu_si128((const __m128i *)(b + j)));
+      row = _mm_add_epi32(row, _mm_madd_epi16(d, d));
+    }
+    sse = _mm_add_epi64(sse, _mm_unpacklo_epi32(row, zero));
+    sse = _mm_add_epi64(sse, _mm_unpackhi_epi32(row, zero));
+    a += a_stride;
+    b += b_stride;
+  }
+  sse = _mm_add_epi64(sse, _mm_srli_si128(sse, 8));
+  _mm_storel_epi64((__m128i *)&result, sse);
+  return result;
+}
@@ -13,7 +13,130 @@
 
 #include "./vp10_rtcd.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/quantize_sse2.h"
 
+#if CONFIG_AOM_QM
+// Quantizes as vp10_quantize_fp_c() does, or as vp10_quantize_fp_32x32_c()
+// when log_scale is 1.
+static INLINE void quantize_fp_qm(const int16_t* coeff_ptr, intptr_t n_coeffs,
+                                  int skip_block, const int16_t* round_ptr,
+                                  const int16_t* quant_ptr, int16_t* qcoeff_ptr,
+                                  int16_t* dqcoeff_ptr,
+                                  const int16_t* dequant_ptr, uint16_t* eob_ptr,
+                                  const int16_t* iscan_ptr,
+                                  const qm_val_t* qm_ptr,
+                                  const qm_val_t* iqm_ptr, int log_scale) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i round, quant, dequant, eob;
+  intptr_t i;
+
+  if (skip_block) {
+    for (i = 0; i < n_coeffs; i += 8) {
+      _mm_store_si128((__m128i*)(qcoeff_ptr + i), zero);
+      _mm_store_si128((__m128i*)(dqcoeff_ptr + i), zero);
+    }
+    *eob_ptr = 0;
+    return;
+  }
+
+  // The first register holds the DC values, the AC ones follow.
+  round = _mm_load_si128((const __m128i*)round_ptr);
+  quant = _mm_load_si128((const __m128i*)quant_ptr);
+  dequant = _mm_load_si128((const __m128i*)dequant_ptr);
+  if (log_scale)
+    round = _mm_srai_epi16(_mm_add_epi16(round, _mm_set1_epi16(1)), 1);
+  eob = zero;
+
+  for (i = 0; i < n_coeffs; i += 8) {
+    const __m128i coeff = _mm_load_si128((const __m128i*)(coeff_ptr + i));
+    const __m128i wt = _mm_loadu_si128((const __m128i*)(qm_ptr + i));
+    const __m128i iwt = _mm_loadu_si128((const __m128i*)(iqm_ptr + i));
+    const __m128i sign = _mm_srai_epi16(coeff, 15);
+    const __m128i abs_coeff = _mm_sub_epi16(_mm_xor_si128(coeff, sign), sign);
+    const __m128i tmp = _mm_adds_epi16(abs_coeff, round);
+    const __m128i xl = _mm_mullo_epi16(tmp, wt);
+    const __m128i xh = _mm_mulhi_epu16(tmp, wt);
+    __m128i lo, hi, skip0, skip1, qcoeff, nzero, iscan;
+
+    if (log_scale) {
+      // Coefficients with abs_coeff * wt below dequant << (AOM_QM_BITS - 2)
+      // are zeroed. The C code keeps only the low 32 bits of tmp * wt *
+      // quant before the shift, and so does this.
+      mul_epu16_epi32(abs_coeff, wt, &lo, &hi);
+      extend_epi16_epi32(dequant, &skip0, &skip1);
+      skip0 = _mm_cmplt_epi32(lo, _mm_slli_epi32(skip0, AOM_QM_BITS - 2));
+      skip1 = _mm_cmplt_epi32(hi, _mm_slli_epi32(skip1, AOM_QM_BITS - 2));
+      mullo_epi32_epi16(xl, xh, quant, &lo, &hi);
+      lo = _mm_andnot_si128(skip0, _mm_srai_epi32(lo, AOM_QM_BITS + 15));
+      hi = _mm_andnot_si128(skip1, _mm_srai_epi32(hi, AOM_QM_BITS + 15));
+    } else {
+      // (tmp * wt * quant) >> (16 + AOM_QM_BITS)
+      mulhi_epi32_epi16(xl, xh, quant, &lo, &hi);
+      lo = _mm_srai_epi32(lo, AOM_QM_BITS);
+      hi = _mm_srai_epi32(hi, AOM_QM_BITS);
+    }
+    nzero = _mm_packs_epi32(_mm_cmpeq_epi32(lo, zero),
+                            _mm_cmpeq_epi32(hi, zero));
+    nzero = _mm_cmpeq_epi16(nzero, zero);
+
+    // Reinsert signs
+    qcoeff = truncate_epi32_epi16(lo, hi);
+    qcoeff = _mm_sub_epi16(_mm_xor_si128(qcoeff, sign), sign);
+    _mm_store_si128((__m128i*)(qcoeff_ptr + i), qcoeff);
+
+    // dqcoeff = qcoeff * ((dequant * iwt + 32) >> AOM_QM_BITS), halved for
+    // 32x32.
+    qm_dequant_epi32(dequant, iwt, &lo, &hi);
+    mullo_epi32_epi16(qcoeff, _mm_srai_epi16(qcoeff, 15),
+                      truncate_epi32_epi16(lo, hi), &lo, &hi);
+    if (log_scale) half_epi32(&lo, &hi);
+    _mm_store_si128((__m128i*)(dqcoeff_ptr + i), truncate_epi32_epi16(lo, hi));
+
+    // Add one to convert from indices to counts
+    iscan = _mm_load_si128((const __m128i*)(iscan_ptr + i));
+    iscan = _mm_sub_epi16(iscan, nzero);
+    eob = _mm_max_epi16(eob, _mm_and_si128(iscan, nzero));
+
+    if (i == 0) {
+      round = _mm_unpackhi_epi64(round, round);
+      quant = _mm_unpackhi_epi64(quant, quant);
+      dequant = _mm_unpackhi_epi64(dequant, dequant);
+    }
+  }
+  *eob_ptr = accumulate_eob(eob);
+}
+
+void vp10_quantize_fp_sse2(const int16_t* coeff_ptr, intptr_t n_coeffs,
+                           int skip_block, const int16_t* zbin_ptr,
+                           const int16_t* round_ptr, const int16_t* quant_ptr,
+                           const int16_t* quant_shift_ptr, int16_t* qcoeff_ptr,
+                           int16_t* dqcoeff_ptr, const int16_t* dequant_ptr,
+                           uint16_t* eob_ptr, const int16_t* scan_ptr,
+                           const int16_t* iscan_ptr, const qm_val_t* qm_ptr,
+                           const qm_val_t* iqm_ptr) {
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+  quantize_fp_qm(coeff_ptr, n_coeffs, skip_block, round_ptr, quant_ptr,
+                 qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan_ptr,
+                 qm_ptr, iqm_ptr, 0);
+}
+
+void vp10_quantize_fp_32x32_sse2(
+    const int16_t* coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t* zbin_ptr, const int16_t* round_ptr, const int16_t* quant_ptr,
+    const int16_t* quant_shift_ptr, int16_t* qcoeff_ptr, int16_t* dqcoeff_ptr,
+    const int16_t* dequant_ptr, uint16_t* eob_ptr, const int16_t* scan_ptr,
+    const int16_t* iscan_ptr, const qm_val_t* qm_ptr,
+    const qm_val_t* iqm_ptr) {
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+  quantize_fp_qm(coeff_ptr, n_coeffs, skip_block, round_ptr, quant_ptr,
+                 qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan_ptr,
+                 qm_ptr, iqm_ptr, 1);
+}
+#else
 void vp10_quantize_fp_sse2(const int16_t* coeff_ptr, intptr_t n_coeffs,
                            int skip_block, const int16_t* zbin_ptr,
                            const int16_t* round_ptr, const int16_t* quant_ptr,
@@ -208,3 +331,4 @@ void vp10_quantize_fp_sse2(const int16_t* coeff_ptr, intptr_t n_coeffs,
     *eob_ptr = 0;
   }
 }
+#endif  // CONFIG_AOM_QM
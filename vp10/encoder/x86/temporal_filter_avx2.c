@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Filters sixteen pixels. As in the SSE2 version 3 * d * d saturates at
+// 65535, which still clamps to 16 for the strengths the encoder uses. pred,
+// accumulator and count are contiguous, so an 8 wide block is done two rows
+// at a time.
+static INLINE void apply_16(__m128i frame1, const uint8_t *pred, __m128i shift,
+                            __m256i rounding, __m256i weight,
+                            unsigned int *accumulator, uint16_t *count) {
+  const __m256i sixteen = _mm256_set1_epi16(16);
+  const __m256i f = _mm256_cvtepu8_epi16(frame1);
+  const __m256i p =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)pred));
+  const __m256i d = _mm256_sub_epi16(f, p);
+  const __m256i sq = _mm256_mullo_epi16(d, d);
+  __m256i m = _mm256_adds_epu16(_mm256_adds_epu16(sq, sq), sq);
+  __m256i c, a_lo, a_hi, mp;
+
+  m = _mm256_srl_epi16(_mm256_adds_epu16(m, rounding), shift);
+  m = _mm256_mullo_epi16(_mm256_subs_epu16(sixteen, m), weight);
+
+  c = _mm256_loadu_si256((const __m256i *)count);
+  _mm256_storeu_si256((__m256i *)count, _mm256_add_epi16(c, m));
+
+  mp = _mm256_mullo_epi16(m, p);
+  a_lo = _mm256_loadu_si256((const __m256i *)accumulator);
+  a_hi = _mm256_loadu_si256((const __m256i *)(accumulator + 8));
+  a_lo = _mm256_add_epi32(
+      a_lo, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(mp)));
+  a_hi = _mm256_add_epi32(
+      a_hi, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(mp, 1)));
+  _mm256_storeu_si256((__m256i *)accumulator, a_lo);
+  _mm256_storeu_si256((__m256i *)(accumulator + 8), a_hi);
+}
+
+static void apply_plane(const uint8_t *frame1, unsigned int stride,
+                        const uint8_t *pred, unsigned int block_width,
+                        unsigned int block_height, __m128i shift,
+                        __m256i rounding, __m256i weight,
+                        unsigned int *accumulator, uint16_t *count) {
+  unsigned int i;
+
+  if (block_width == 16) {
+    for (i = 0; i < block_height; ++i) {
+      apply_16(_mm_loadu_si128((const __m128i *)frame1), pred, shift, rounding,
+               weight, accumulator, count);
+      frame1 += stride;
+      pred += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  } else {
+    for (i = 0; i < block_height; i += 2) {
+      const __m128i f = _mm_unpacklo_epi64(
+          _mm_loadl_epi64((const __m128i *)frame1),
+          _mm_loadl_epi64((const __m128i *)(frame1 + stride)));
+      apply_16(f, pred, shift, rounding, weight, accumulator, count);
+      frame1 += 2 * stride;
+      pred += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  }
+}
+
+void vp10_temporal_filter_apply_avx2(
+    const uint8_t *y_frame1, const uint8_t *u_frame1, const uint8_t *v_frame1,
+    unsigned int y_stride, unsigned int uv_stride, const uint8_t *pred,
+    unsigned int uv_block_width, unsigned int uv_block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi16(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i weight = _mm256_set1_epi16(filter_weight);
+
+  apply_plane(y_frame1, y_stride, pred, 16, 16, shift, rounding, weight,
+              accumulator, count);
+  apply_plane(u_frame1, uv_stride, pred + 256, uv_block_width, uv_block_height,
+              shift, rounding, weight, accumulator + 256, count + 256);
+  apply_plane(v_frame1, uv_stride, pred + 512, uv_block_width, uv_block_height,
+              shift, rounding, weight, accumulator + 512, count + 512);
+}
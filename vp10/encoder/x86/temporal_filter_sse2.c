@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp10_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Filters eight pixels held in the low half of frame1. The modifier is
+// worked out in 16 bits: 3 * d * d saturates at 65535, which still clamps to
+// 16 for the strengths the encoder uses (at most 6). pred, accumulator and
+// count are contiguous.
+static INLINE void apply_8(__m128i frame1, const uint8_t *pred, __m128i shift,
+                           __m128i rounding, __m128i weight,
+                           unsigned int *accumulator, uint16_t *count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i sixteen = _mm_set1_epi16(16);
+  const __m128i f = _mm_unpacklo_epi8(frame1, zero);
+  const __m128i p =
+      _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)pred), zero);
+  const __m128i d = _mm_sub_epi16(f, p);
+  const __m128i sq = _mm_mullo_epi16(d, d);
+  __m128i m = _mm_adds_epu16(_mm_adds_epu16(sq, sq), sq);
+  __m128i c, a_lo, a_hi, mp;
+
+  m = _mm_srl_epi16(_mm_adds_epu16(m, rounding), shift);
+  m = _mm_mullo_epi16(_mm_subs_epu16(sixteen, m), weight);
+
+  c = _mm_loadu_si128((const __m128i *)count);
+  _mm_storeu_si128((__m128i *)count, _mm_add_epi16(c, m));
+
+  mp = _mm_mullo_epi16(m, p);
+  a_lo = _mm_loadu_si128((const __m128i *)accumulator);
+  a_hi = _mm_loadu_si128((const __m128i *)(accumulator + 4));
+  a_lo = _mm_add_epi32(a_lo, _mm_unpacklo_epi16(mp, zero));
+  a_hi = _mm_add_epi32(a_hi, _mm_unpackhi_epi16(mp, zero));
+  _mm_storeu_si128((__m128i *)accumulator, a_lo);
+  _mm_storeu_si128((__m128i *)(accumulator + 4), a_hi);
+}
+
+static void apply_plane(const uint8_t *frame1, unsigned int stride,
+                        const uint8_t *pred, unsigned int block_width,
+                        unsigned int block_height, __m128i shift,
+                        __m128i rounding, __m128i weight,
+                        unsigned int *accumulator, uint16_t *count) {
+  unsigned int i, j;
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      apply_8(_mm_loadl_epi64((const __m128i *)(frame1 + j)), pred, shift,
+              rounding, weight, accumulator, count);
+      pred += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride;
+  }
+}
+
+void vp10_temporal_filter_apply_sse2(
+    const uint8_t *y_frame1, const uint8_t *u_frame1, const uint8_t *v_frame1,
+    unsigned int y_stride, unsigned int uv_stride, const uint8_t *pred,
+    unsigned int uv_block_width, unsigned int uv_block_height, int strength,
+    int filter_weight, unsigned int *accumulator, uint16_t *count) {
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m128i rounding =
+      _mm_set1_epi16(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m128i weight = _mm_set1_epi16(filter_weight);
+
+  apply_plane(y_frame1, y_stride, pred, 16, 16, shift, rounding, weight,
+              accumulator, count);
+  apply_plane(u_frame1, uv_stride, pred + 256, uv_block_width, uv_block_height,
+              shift, rounding, weight, accumulator + 256, count + 256);
+  apply_plane(v_frame1, uv_stride, pred + 512, uv_block_width, uv_block_height,
+              shift, rounding, weight, accumulator + 512, count + 512);
+}
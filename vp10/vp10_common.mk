@@ -60,13 +60,22 @@ VP10_COMMON_SRCS-yes += common/scan.c
 VP10_COMMON_SRCS-yes += common/scan.h
 VP10_COMMON_SRCS-yes += common/vp10_fwd_txfm.h
 VP10_COMMON_SRCS-yes += common/vp10_fwd_txfm.c
+ifeq ($(CONFIG_CLPF),yes)
 VP10_COMMON_SRCS-yes += common/clpf.c
 VP10_COMMON_SRCS-yes += common/clpf.h
+VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/clpf_sse2.c
+VP10_COMMON_SRCS-$(HAVE_AVX2) += common/x86/clpf_avx2.c
+endif
 ifeq ($(CONFIG_DERING),yes)
 VP10_COMMON_SRCS-yes += common/od_dering.c
 VP10_COMMON_SRCS-yes += common/od_dering.h
 VP10_COMMON_SRCS-yes += common/dering.c
 VP10_COMMON_SRCS-yes += common/dering.h
+VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/od_dering_impl_sse2.h
+VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/od_dering_sse2.c
+VP10_COMMON_SRCS-$(HAVE_SSSE3) += common/x86/od_dering_ssse3.c
+VP10_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/od_dering_sse4.c
+VP10_COMMON_SRCS-$(HAVE_AVX2) += common/x86/od_dering_avx2.c
 endif
 VP10_COMMON_SRCS-yes += common/odintrin.c
 VP10_COMMON_SRCS-yes += common/odintrin.h
@@ -86,6 +95,13 @@ VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/idct_intrin_sse2.c
 VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp10_fwd_txfm_sse2.c
 VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp10_fwd_dct32x32_impl_sse2.h
 VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp10_fwd_txfm_impl_sse2.h
+VP10_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp10_txfm_common_avx2.h
+
+ifneq ($(CONFIG_VPX_HIGHBITDEPTH),yes)
+ifneq ($(CONFIG_EMULATE_HARDWARE),yes)
+VP10_COMMON_SRCS-$(HAVE_AVX2) += common/x86/idct_intrin_avx2.c
+endif
+endif
 
 ifneq ($(CONFIG_VPX_HIGHBITDEPTH),yes)
 VP10_COMMON_SRCS-$(HAVE_NEON) += common/arm/neon/iht4x4_add_neon.c
@@ -95,4 +111,12 @@ endif
 VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp10_inv_txfm_sse2.c
 VP10_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp10_inv_txfm_sse2.h
 
+ifeq ($(CONFIG_VPX_HIGHBITDEPTH),yes)
+ifneq ($(CONFIG_EMULATE_HARDWARE),yes)
+VP10_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/vp10_highbd_inv_txfm_impl.h
+VP10_COMMON_SRCS-$(HAVE_SSE4_1) += common/x86/vp10_highbd_inv_txfm_sse4.c
+VP10_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp10_highbd_inv_txfm_avx2.c
+endif
+endif
+
 $(eval $(call rtcd_h_template,vp10_rtcd,vp10/common/vp10_rtcd_defs.pl))
@@ -35,6 +35,10 @@ typedef vpx_codec_stream_info_t vp10_stream_info_t;
 // TODO(hkuang): Remove this limit after implementing ondemand framebuffers.
 #define FRAME_CACHE_SIZE 6  // Cache maximum 6 decoded frames.
 
+// Each frame worker holds a frame buffer, which limits the number of frames
+// decoded in parallel.
+#define MAX_FRAME_WORKERS 8
+
 typedef struct cache_frame {
   int fb_idx;
   vpx_image_t img;
@@ -55,6 +59,9 @@ struct vpx_codec_alg_priv {
   int last_show_frame;  // Index of last output frame.
   int byte_alignment;
   int skip_loop_filter;
+  int parse_ahead;
+  // The thread pool set by the application, if any.
+  VPxThreadPool *thread_pool;
 
   // Frame parallel related.
   int frame_parallel_decode;  // frame-based threading.
@@ -138,6 +145,7 @@ static vpx_codec_err_t decoder_destroy(vpx_codec_alg_priv_t *ctx) {
 
   vpx_free(ctx->frame_workers);
   vpx_free(ctx->buffer_pool);
+  vpx_thread_pool_release(ctx->thread_pool);
   vpx_free(ctx);
   return VPX_CODEC_OK;
 }
@@ -347,8 +355,8 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   ctx->need_resync = 1;
   ctx->num_frame_workers =
       (ctx->frame_parallel_decode == 1) ? ctx->cfg.threads : 1;
-  if (ctx->num_frame_workers > MAX_DECODE_THREADS)
-    ctx->num_frame_workers = MAX_DECODE_THREADS;
+  if (ctx->num_frame_workers > MAX_FRAME_WORKERS)
+    ctx->num_frame_workers = MAX_FRAME_WORKERS;
   ctx->available_threads = ctx->num_frame_workers;
   ctx->flushed = 0;
 
@@ -406,7 +414,9 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
     frame_worker_data->pbi->max_threads =
         (ctx->frame_parallel_decode == 0) ? ctx->cfg.threads : 0;
 
+    vp10_decoder_set_thread_pool(frame_worker_data->pbi, ctx->thread_pool);
     frame_worker_data->pbi->inv_tile_order = ctx->invert_tile_order;
+    frame_worker_data->pbi->parse_ahead = ctx->parse_ahead;
     frame_worker_data->pbi->common.frame_parallel_decode =
         ctx->frame_parallel_decode;
     worker->hook = (VPxWorkerHook)frame_worker_hook;
@@ -1015,6 +1025,42 @@ static vpx_codec_err_t ctrl_set_skip_loop_filter(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_parse_ahead(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  int i;
+  ctx->parse_ahead = va_arg(args, int);
+
+  for (i = 0; i < ctx->num_frame_workers; ++i) {
+    VPxWorker *const worker = &ctx->frame_workers[i];
+    FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
+    frame_worker_data->pbi->parse_ahead = ctx->parse_ahead;
+  }
+
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_thread_pool(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  vpx_codec_thread_pool_t *const pool =
+      va_arg(args, vpx_codec_thread_pool_t *);
+  vpx_thread_pool_release(ctx->thread_pool);
+  ctx->thread_pool = vpx_thread_pool_retain((VPxThreadPool *)pool);
+
+  // Decoders that were already created switch pools between frames.
+  if (ctx->frame_workers != NULL) {
+    const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+    int i;
+    for (i = 0; i < ctx->num_frame_workers; ++i) {
+      VPxWorker *const worker = &ctx->frame_workers[i];
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)worker->data1;
+      winterface->sync(worker);
+      vp10_decoder_set_thread_pool(frame_worker_data->pbi, ctx->thread_pool);
+    }
+  }
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP8_COPY_REFERENCE, ctrl_copy_reference },
 
@@ -1029,6 +1075,8 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VPXD_SET_DECRYPTOR, ctrl_set_decryptor },
   { VP9_SET_BYTE_ALIGNMENT, ctrl_set_byte_alignment },
   { VP9_SET_SKIP_LOOP_FILTER, ctrl_set_skip_loop_filter },
+  { VP10D_SET_PARSE_AHEAD, ctrl_set_parse_ahead },
+  { VP10_SET_THREAD_POOL, ctrl_set_thread_pool },
 
   // Getters
   { VP8D_GET_LAST_REF_UPDATES, ctrl_get_last_ref_updates },
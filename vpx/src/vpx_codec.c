@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include "vpx/vpx_integer.h"
 #include "vpx/internal/vpx_codec_internal.h"
+#include "vpx_util/vpx_thread_pool.h"
 #include "vpx_version.h"
 
 #define SAVE_STATUS(ctx, var) (ctx ? (ctx->err = var) : var)
@@ -85,6 +86,25 @@ vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface) {
   return (iface) ? iface->caps : 0;
 }
 
+vpx_codec_thread_pool_t *vpx_codec_thread_pool_create(
+    unsigned int num_threads) {
+  if (num_threads > VPX_THREAD_POOL_MAX_THREADS)
+    num_threads = VPX_THREAD_POOL_MAX_THREADS;
+  return (vpx_codec_thread_pool_t *)vpx_thread_pool_create((int)num_threads);
+}
+
+vpx_codec_err_t vpx_codec_thread_pool_set_affinity(
+    vpx_codec_thread_pool_t *pool, vpx_codec_thread_affinity_t affinity) {
+  if (pool == NULL || affinity < VPX_THREAD_AFFINITY_NONE ||
+      affinity > VPX_THREAD_AFFINITY_NODE)
+    return VPX_CODEC_INVALID_PARAM;
+  return vpx_thread_pool_set_affinity((VPxThreadPool *)pool, affinity);
+}
+
+void vpx_codec_thread_pool_destroy(vpx_codec_thread_pool_t *pool) {
+  vpx_thread_pool_release((VPxThreadPool *)pool);
+}
+
 vpx_codec_err_t vpx_codec_control_(vpx_codec_ctx_t *ctx, int ctrl_id, ...) {
   vpx_codec_err_t res;
 
@@ -58,6 +58,10 @@ enum vp8_com_control_id {
    * VP8_DECODER_CTRL_ID_START range next time we're ready to break the ABI.
    */
   VP9_GET_REFERENCE = 128, /**< get a pointer to a reference frame */
+  VP10_SET_THREAD_POOL =
+      129, /**< run the encoder or decoder on a shared thread pool, see
+              #vpx_codec_thread_pool_create(). NULL goes back to the
+              process wide pool. */
   VP8_COMMON_CTRL_ID_MAX,
   VP8_DECODER_CTRL_ID_START = 256
 };
@@ -142,6 +146,8 @@ VPX_CTRL_USE_TYPE(VP8_SET_DBG_DISPLAY_MV, int)
 #define VPX_CTRL_VP8_SET_DBG_DISPLAY_MV
 VPX_CTRL_USE_TYPE(VP9_GET_REFERENCE, vp9_ref_frame_t *)
 #define VPX_CTRL_VP9_GET_REFERENCE
+VPX_CTRL_USE_TYPE(VP10_SET_THREAD_POOL, vpx_codec_thread_pool_t *)
+#define VPX_CTRL_VP10_SET_THREAD_POOL
 
 /*!\endcond */
 /*! @} - end defgroup vp8 */
@@ -570,6 +570,18 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP9
    */
   VP9E_SET_RENDER_SIZE,
+
+  /*!\brief Codec control function to encode superblock rows in parallel.
+   *
+   * Rows within a tile are encoded by all threads in wavefront order, which
+   * allows more threads to be used than there are tile columns. The output
+   * does not depend on the number of threads.
+   *                          0 = encode tiles in parallel (default)
+   *                          1 = encode superblock rows in parallel
+   *
+   * Supported in codecs: VP10
+   */
+  VP9E_SET_ROW_MT,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -834,6 +846,9 @@ VPX_CTRL_USE_TYPE(VP9E_SET_SVC_REF_FRAME_CONFIG, vpx_svc_ref_frame_config_t *)
 VPX_CTRL_USE_TYPE(VP9E_SET_RENDER_SIZE, int *)
 #define VPX_CTRL_VP9E_SET_RENDER_SIZE
 
+VPX_CTRL_USE_TYPE(VP9E_SET_ROW_MT, unsigned int)
+#define VPX_CTRL_VP9E_SET_ROW_MT
+
 /*!\endcond */
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
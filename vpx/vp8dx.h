@@ -102,6 +102,14 @@ enum vp8_dec_control_id {
    */
   VP9_SET_SKIP_LOOP_FILTER,
 
+  /** control function to make the VP10 decoder parse the modes and the
+   * coefficients of a whole superblock row of a tile before reconstructing
+   * it, instead of reconstructing each block as it is parsed. It applies when
+   * the superblock rows are not reconstructed on other threads. Valid values
+   * are integers, nonzero enables it. The default value is 0.
+   */
+  VP10D_SET_PARSE_AHEAD,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -153,6 +161,8 @@ VPX_CTRL_USE_TYPE(VP9D_GET_FRAME_SIZE, int *)
 #define VPX_CTRL_VP9D_GET_FRAME_SIZE
 VPX_CTRL_USE_TYPE(VP9_INVERT_TILE_DECODE_ORDER, int)
 #define VPX_CTRL_VP9_INVERT_TILE_DECODE_ORDER
+VPX_CTRL_USE_TYPE(VP10D_SET_PARSE_AHEAD, int)
+#define VPX_CTRL_VP10D_SET_PARSE_AHEAD
 
 /*!\endcond */
 /*! @} - end defgroup vp8_decoder */
@@ -352,6 +352,75 @@ vpx_codec_err_t vpx_codec_destroy(vpx_codec_ctx_t *ctx);
  */
 vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface);
 
+/*!\brief Thread pool handle
+ *
+ * A pool of worker threads that any number of encoder and decoder instances
+ * can run their work on, see #vpx_codec_thread_pool_create(). The threads
+ * serve the instances that use the pool in turn.
+ */
+typedef struct vpx_codec_thread_pool vpx_codec_thread_pool_t;
+
+/*!\brief Create a thread pool
+ *
+ * Creates a pool of worker threads, which is attached to codec instances
+ * with the VP10_SET_THREAD_POOL control. The instances attached to one pool
+ * share its threads instead of each starting threads of its own. The number
+ * of threads each instance is configured with still sets how many parts its
+ * work is split into. Pools are only supported by VP10.
+ *
+ * \param[in] num_threads   Number of threads of the pool. A pool without
+ *                          threads runs the work on the calling thread.
+ *
+ * \return The new pool, or NULL on failure.
+ */
+vpx_codec_thread_pool_t *vpx_codec_thread_pool_create(unsigned int num_threads);
+
+/*!\brief Thread pool CPU affinity
+ *
+ * How the threads of a pool are pinned to CPUs, see
+ * #vpx_codec_thread_pool_set_affinity(). The threads are placed node by
+ * node, so that a pool with no more threads than a NUMA node has CPUs stays
+ * on that node.
+ */
+typedef enum vpx_codec_thread_affinity {
+  /*!\brief The threads run on any CPU the pool was created on (default) */
+  VPX_THREAD_AFFINITY_NONE,
+  /*!\brief Each thread runs on a CPU of its own */
+  VPX_THREAD_AFFINITY_CPU,
+  /*!\brief Each thread runs on the CPUs of one NUMA node */
+  VPX_THREAD_AFFINITY_NODE
+} vpx_codec_thread_affinity_t;
+
+/*!\brief Pin the threads of a thread pool
+ *
+ * Pins the threads of the pool to CPUs, including threads the pool starts
+ * later. The CPUs are those the calling thread could run on when the pool
+ * was created. Memory that the codec jobs allocate and first write is then
+ * placed on the node of the thread that runs them by the operating system.
+ *
+ * \param[in] pool       The pool to pin.
+ * \param[in] affinity   How to pin the threads.
+ *
+ * \retval #VPX_CODEC_OK
+ *     The threads were pinned.
+ * \retval #VPX_CODEC_INCAPABLE
+ *     The platform does not support pinning threads.
+ * \retval #VPX_CODEC_INVALID_PARAM
+ *     The pool or the affinity was not valid.
+ */
+vpx_codec_err_t vpx_codec_thread_pool_set_affinity(
+    vpx_codec_thread_pool_t *pool, vpx_codec_thread_affinity_t affinity);
+
+/*!\brief Destroy a thread pool
+ *
+ * Releases the application's hold on the pool. Codec instances still
+ * attached to it keep using it, and the threads are stopped once the last
+ * of them is destroyed.
+ *
+ * \param[in] pool   The pool to destroy. May be NULL.
+ */
+void vpx_codec_thread_pool_destroy(vpx_codec_thread_pool_t *pool);
+
 /*!\brief Control algorithm
  *
  * This function is used to exchange algorithm specific data with the codec
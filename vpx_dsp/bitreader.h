@@ -13,12 +13,14 @@
 
 #include <stddef.h>
 #include <limits.h>
+#include <string.h>
 
 #include "./vpx_config.h"
 #include "vpx_ports/mem.h"
 #include "vpx/vp8dx.h"
 #include "vpx/vpx_integer.h"
 #include "vpx_dsp/prob.h"
+#include "vpx_util/endian_inl.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +72,29 @@ static INLINE int vpx_reader_has_error(vpx_reader *r) {
   return r->count > BD_VALUE_SIZE && r->count < LOTS_OF_BITS;
 }
 
+// Refills 'value' with a single load of a BD_VALUE while the buffer holds
+// more than one, which is what vpx_reader_fill() does away from the end of
+// the buffer, and leaves the end of the buffer and the decryption to it.
+static INLINE void vpx_reader_refill(vpx_reader *r) {
+  if (r->decrypt_cb == NULL &&
+      (size_t)(r->buffer_end - r->buffer) > sizeof(BD_VALUE)) {
+    const int shift = BD_VALUE_SIZE - CHAR_BIT - (r->count + CHAR_BIT);
+    const int bits = (shift & 0xfffffff8) + CHAR_BIT;
+    BD_VALUE big_endian_values;
+    memcpy(&big_endian_values, r->buffer, sizeof(BD_VALUE));
+#if SIZE_MAX == 0xffffffffffffffffULL
+    big_endian_values = HToBE64(big_endian_values);
+#else
+    big_endian_values = HToBE32(big_endian_values);
+#endif
+    r->value |= (big_endian_values >> (BD_VALUE_SIZE - bits)) << (shift & 0x7);
+    r->count += bits;
+    r->buffer += bits >> 3;
+  } else {
+    vpx_reader_fill(r);
+  }
+}
+
 static INLINE int vpx_read(vpx_reader *r, int prob) {
   unsigned int bit = 0;
   BD_VALUE value;
@@ -78,7 +103,7 @@ static INLINE int vpx_read(vpx_reader *r, int prob) {
   unsigned int range;
   unsigned int split = (r->range * prob + (256 - prob)) >> CHAR_BIT;
 
-  if (r->count < 0) vpx_reader_fill(r);
+  if (r->count < 0) vpx_reader_refill(r);
 
   value = r->value;
   count = r->count;
@@ -110,10 +135,43 @@ static INLINE int vpx_read_bit(vpx_reader *r) {
   return vpx_read(r, 128);  // vpx_prob_half
 }
 
+// Reads the bits of the literal as vpx_read_bit() does, refilling once for
+// as many bits as 'value' holds. As the range is at least 128 before each
+// bit, the split of a half probability is (range + 1) / 2 and leaves a range
+// of at least 64, so each bit shifts in at most one more bit.
 static INLINE int vpx_read_literal(vpx_reader *r, int bits) {
-  int literal = 0, bit;
-
-  for (bit = bits - 1; bit >= 0; bit--) literal |= vpx_read_bit(r) << bit;
+  int literal = 0;
+
+  while (bits > 0) {
+    BD_VALUE value;
+    unsigned int range;
+    int count, n;
+
+    if (r->count < 0) vpx_reader_refill(r);
+    value = r->value;
+    range = r->range;
+    count = r->count;
+    n = bits < count + 1 ? bits : count + 1;
+    bits -= n;
+
+    for (; n > 0; --n) {
+      const unsigned int split = (range + 1) >> 1;
+      const BD_VALUE bigsplit = (BD_VALUE)split << (BD_VALUE_SIZE - CHAR_BIT);
+      const int bit = value >= bigsplit;
+      int shift;
+      range = bit ? range - split : split;
+      value = bit ? value - bigsplit : value;
+      shift = 1 - (int)(range >> 7);
+      range <<= shift;
+      value <<= shift;
+      count -= shift;
+      literal = (literal << 1) | bit;
+    }
+
+    r->value = value;
+    r->range = range;
+    r->count = count;
+  }
 
   return literal;
 }
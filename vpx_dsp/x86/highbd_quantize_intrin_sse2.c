@@ -10,11 +10,125 @@
 
 #include <emmintrin.h>
 
+#include "./vpx_dsp_rtcd.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
 
 #if CONFIG_VPX_HIGHBITDEPTH
+#if CONFIG_AOM_QM
+// Returns abs_coeff * wt for four coefficients, with the weights widened from
+// 16 bits.
+static INLINE __m128i weight_coefficients(__m128i abs_coeff,
+                                          const qm_val_t *qm_ptr) {
+  const __m128i wt = _mm_unpacklo_epi16(
+      _mm_loadl_epi64((const __m128i *)qm_ptr), _mm_setzero_si128());
+  const __m128i p02 = _mm_mul_epu32(abs_coeff, wt);
+  const __m128i p13 =
+      _mm_mul_epu32(_mm_srli_epi64(abs_coeff, 32), _mm_srli_epi64(wt, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(p02, 0x08),
+                            _mm_shuffle_epi32(p13, 0x08));
+}
+
+// Quantizes as vpx_highbd_quantize_b_c() does, or as
+// vpx_highbd_quantize_b_32x32_c() when log_scale is 1. The weighted zbin test
+// runs four coefficients at a time; the few coefficients that pass it are
+// quantized in 64 bits like the C code.
+static INLINE void highbd_quantize_b_qm(
+    const tran_low_t *coeff_ptr, intptr_t count, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *iscan, const qm_val_t *qm_ptr, const qm_val_t *iqm_ptr,
+    int log_scale) {
+  int i, j, eob_i = -1;
+  // ROUND_POWER_OF_TWO() is not defined for a shift of 0.
+  const int zbin0_tmp =
+      (log_scale ? ROUND_POWER_OF_TWO(zbin_ptr[0], 1) : zbin_ptr[0])
+      << AOM_QM_BITS;
+  const int zbin1_tmp =
+      (log_scale ? ROUND_POWER_OF_TWO(zbin_ptr[1], 1) : zbin_ptr[1])
+      << AOM_QM_BITS;
+  const int rounds[2] = {
+    log_scale ? ROUND_POWER_OF_TWO(round_ptr[0], 1) : round_ptr[0],
+    log_scale ? ROUND_POWER_OF_TWO(round_ptr[1], 1) : round_ptr[1]
+  };
+  __m128i zbins[2];
+
+  zbins[0] = _mm_set_epi32(zbin1_tmp, zbin1_tmp, zbin1_tmp, zbin0_tmp);
+  zbins[1] = _mm_set1_epi32(zbin1_tmp);
+
+  memset(qcoeff_ptr, 0, count * sizeof(*qcoeff_ptr));
+  memset(dqcoeff_ptr, 0, count * sizeof(*dqcoeff_ptr));
+
+  if (!skip_block) {
+    for (i = 0; i < (int)count / 4; i++) {
+      __m128i coeffs, coeffs_sign, tmp1, tmp2;
+      int test;
+      int abs_coeff[4];
+      int coeff_sign[4];
+
+      coeffs = _mm_load_si128((const __m128i *)(coeff_ptr + i * 4));
+      coeffs_sign = _mm_srai_epi32(coeffs, 31);
+      coeffs = _mm_sub_epi32(_mm_xor_si128(coeffs, coeffs_sign), coeffs_sign);
+      tmp2 = weight_coefficients(coeffs, qm_ptr + i * 4);
+      tmp1 = _mm_cmpgt_epi32(tmp2, zbins[i != 0]);
+      tmp2 = _mm_cmpeq_epi32(tmp2, zbins[i != 0]);
+      tmp1 = _mm_or_si128(tmp1, tmp2);
+      test = _mm_movemask_epi8(tmp1);
+      if (!test) continue;
+      _mm_storeu_si128((__m128i *)abs_coeff, coeffs);
+      _mm_storeu_si128((__m128i *)coeff_sign, coeffs_sign);
+
+      for (j = 0; j < 4; j++) {
+        if (test & (1 << (4 * j))) {
+          const int k = 4 * i + j;
+          const int64_t tmpw = (int64_t)(abs_coeff[j] + rounds[k != 0]) *
+                               qm_ptr[k];
+          const int64_t tmp = ((tmpw * quant_ptr[k != 0]) >> 16) + tmpw;
+          const uint32_t abs_qcoeff =
+              (uint32_t)((tmp * quant_shift_ptr[k != 0]) >>
+                         (16 - log_scale + AOM_QM_BITS));
+          const int dequant =
+              (dequant_ptr[k != 0] * iqm_ptr[k] + (1 << (AOM_QM_BITS - 1))) >>
+              AOM_QM_BITS;
+          const int qcoeff = (int)(abs_qcoeff ^ coeff_sign[j]) - coeff_sign[j];
+          qcoeff_ptr[k] = qcoeff;
+          dqcoeff_ptr[k] = log_scale ? qcoeff * dequant / 2 : qcoeff * dequant;
+          if (abs_qcoeff) eob_i = iscan[k] > eob_i ? iscan[k] : eob_i;
+        }
+      }
+    }
+  }
+  *eob_ptr = eob_i + 1;
+}
+
+void vpx_highbd_quantize_b_sse2(
+    const tran_low_t *coeff_ptr, intptr_t count, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan, const qm_val_t *qm_ptr,
+    const qm_val_t *iqm_ptr) {
+  (void)scan;
+  highbd_quantize_b_qm(coeff_ptr, count, skip_block, zbin_ptr, round_ptr,
+                       quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                       dequant_ptr, eob_ptr, iscan, qm_ptr, iqm_ptr, 0);
+}
+
+void vpx_highbd_quantize_b_32x32_sse2(
+    const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan, const qm_val_t *qm_ptr,
+    const qm_val_t *iqm_ptr) {
+  (void)scan;
+  highbd_quantize_b_qm(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                       quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                       dequant_ptr, eob_ptr, iscan, qm_ptr, iqm_ptr, 1);
+}
+#else
 void vpx_highbd_quantize_b_sse2(const tran_low_t *coeff_ptr, intptr_t count,
                                 int skip_block, const int16_t *zbin_ptr,
                                 const int16_t *round_ptr,
@@ -151,4 +265,5 @@ void vpx_highbd_quantize_b_32x32_sse2(
   }
   *eob_ptr = eob + 1;
 }
+#endif  // CONFIG_AOM_QM
 #endif
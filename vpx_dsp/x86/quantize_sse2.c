@@ -13,6 +13,7 @@
 
 #include "./vpx_dsp_rtcd.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/quantize_sse2.h"
 
 static INLINE __m128i load_coefficients(const tran_low_t* coeff_ptr) {
 #if CONFIG_VPX_HIGHBITDEPTH
@@ -40,6 +41,142 @@ static INLINE void store_coefficients(__m128i coeff_vals,
 #endif
 }
 
+#if CONFIG_AOM_QM
+static INLINE void store_coefficients_epi32(__m128i lo, __m128i hi,
+                                            tran_low_t* coeff_ptr) {
+#if CONFIG_VPX_HIGHBITDEPTH
+  _mm_store_si128((__m128i*)(coeff_ptr), lo);
+  _mm_store_si128((__m128i*)(coeff_ptr + 4), hi);
+#else
+  _mm_store_si128((__m128i*)(coeff_ptr), truncate_epi32_epi16(lo, hi));
+#endif
+}
+
+// Quantizes as vpx_quantize_b_c() does, or as vpx_quantize_b_32x32_c() when
+// log_scale is 1. The pre-scan of the C code only skips coefficients that
+// fail the zbin test, so here every coefficient is tested instead and the
+// eob comes from iscan.
+static INLINE void quantize_b_qm(
+    const tran_low_t* coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t* zbin_ptr, const int16_t* round_ptr, const int16_t* quant_ptr,
+    const int16_t* quant_shift_ptr, tran_low_t* qcoeff_ptr,
+    tran_low_t* dqcoeff_ptr, const int16_t* dequant_ptr, uint16_t* eob_ptr,
+    const int16_t* iscan_ptr, const qm_val_t* qm_ptr, const qm_val_t* iqm_ptr,
+    int log_scale) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i zbin, round, quant, shift, dequant, eob;
+  intptr_t i;
+
+  if (skip_block) {
+    for (i = 0; i < n_coeffs; i += 8) {
+      store_coefficients(zero, qcoeff_ptr + i);
+      store_coefficients(zero, dqcoeff_ptr + i);
+    }
+    *eob_ptr = 0;
+    return;
+  }
+
+  // The first register holds the DC values, the AC ones follow.
+  zbin = _mm_load_si128((const __m128i*)zbin_ptr);
+  round = _mm_load_si128((const __m128i*)round_ptr);
+  quant = _mm_load_si128((const __m128i*)quant_ptr);
+  shift = _mm_load_si128((const __m128i*)quant_shift_ptr);
+  dequant = _mm_load_si128((const __m128i*)dequant_ptr);
+  if (log_scale) {
+    const __m128i one = _mm_set1_epi16(1);
+    zbin = _mm_srai_epi16(_mm_add_epi16(zbin, one), 1);
+    round = _mm_srai_epi16(_mm_add_epi16(round, one), 1);
+  }
+  eob = zero;
+
+  for (i = 0; i < n_coeffs; i += 8) {
+    const __m128i coeff = load_coefficients(coeff_ptr + i);
+    const __m128i wt = _mm_loadu_si128((const __m128i*)(qm_ptr + i));
+    const __m128i iwt = _mm_loadu_si128((const __m128i*)(iqm_ptr + i));
+    const __m128i sign = _mm_srai_epi16(coeff, 15);
+    const __m128i abs_coeff = _mm_sub_epi16(_mm_xor_si128(coeff, sign), sign);
+    const __m128i tmp = _mm_adds_epi16(abs_coeff, round);
+    __m128i skip0, skip1, xl, xh, lo, hi, q0, q1, s0, s1, nzero, iscan;
+
+    // Coefficients with abs_coeff * wt below zbin << AOM_QM_BITS are zeroed.
+    mul_epu16_epi32(abs_coeff, wt, &lo, &hi);
+    extend_epi16_epi32(zbin, &s0, &s1);
+    skip0 = _mm_cmplt_epi32(lo, _mm_slli_epi32(s0, AOM_QM_BITS));
+    skip1 = _mm_cmplt_epi32(hi, _mm_slli_epi32(s1, AOM_QM_BITS));
+
+    // tmp = (abs_coeff + round) * wt
+    // qcoeff = ((((tmp * quant) >> 16) + tmp) * shift) >>
+    //          (16 + AOM_QM_BITS - log_scale)
+    xl = _mm_mullo_epi16(tmp, wt);
+    xh = _mm_mulhi_epu16(tmp, wt);
+    mulhi_epi32_epi16(xl, xh, quant, &lo, &hi);
+    lo = _mm_add_epi32(lo, _mm_unpacklo_epi16(xl, xh));
+    hi = _mm_add_epi32(hi, _mm_unpackhi_epi16(xl, xh));
+    split_epi32(lo, hi, &xl, &xh);
+    mulhi_epi32_epi16(xl, xh, shift, &q0, &q1);
+    q0 = _mm_andnot_si128(skip0, _mm_srai_epi32(q0, AOM_QM_BITS - log_scale));
+    q1 = _mm_andnot_si128(skip1, _mm_srai_epi32(q1, AOM_QM_BITS - log_scale));
+    nzero = _mm_packs_epi32(_mm_cmpeq_epi32(q0, zero),
+                            _mm_cmpeq_epi32(q1, zero));
+    nzero = _mm_cmpeq_epi16(nzero, zero);
+
+    // Reinsert signs
+    extend_epi16_epi32(sign, &s0, &s1);
+    q0 = _mm_sub_epi32(_mm_xor_si128(q0, s0), s0);
+    q1 = _mm_sub_epi32(_mm_xor_si128(q1, s1), s1);
+    store_coefficients_epi32(q0, q1, qcoeff_ptr + i);
+
+    // dqcoeff = qcoeff * ((dequant * iwt + 32) >> AOM_QM_BITS), halved for
+    // 32x32. The weighted 8-bit dequantizer still fits in 16 bits.
+    qm_dequant_epi32(dequant, iwt, &lo, &hi);
+    split_epi32(q0, q1, &xl, &xh);
+    mullo_epi32_epi16(xl, xh, truncate_epi32_epi16(lo, hi), &lo, &hi);
+    if (log_scale) half_epi32(&lo, &hi);
+    store_coefficients_epi32(lo, hi, dqcoeff_ptr + i);
+
+    // Add one to convert from indices to counts
+    iscan = _mm_load_si128((const __m128i*)(iscan_ptr + i));
+    iscan = _mm_sub_epi16(iscan, nzero);
+    eob = _mm_max_epi16(eob, _mm_and_si128(iscan, nzero));
+
+    if (i == 0) {
+      zbin = _mm_unpackhi_epi64(zbin, zbin);  // Switch DC to AC
+      round = _mm_unpackhi_epi64(round, round);
+      quant = _mm_unpackhi_epi64(quant, quant);
+      shift = _mm_unpackhi_epi64(shift, shift);
+      dequant = _mm_unpackhi_epi64(dequant, dequant);
+    }
+  }
+  *eob_ptr = accumulate_eob(eob);
+}
+
+void vpx_quantize_b_sse2(const tran_low_t* coeff_ptr, intptr_t n_coeffs,
+                         int skip_block, const int16_t* zbin_ptr,
+                         const int16_t* round_ptr, const int16_t* quant_ptr,
+                         const int16_t* quant_shift_ptr, tran_low_t* qcoeff_ptr,
+                         tran_low_t* dqcoeff_ptr, const int16_t* dequant_ptr,
+                         uint16_t* eob_ptr, const int16_t* scan_ptr,
+                         const int16_t* iscan_ptr, const qm_val_t* qm_ptr,
+                         const qm_val_t* iqm_ptr) {
+  (void)scan_ptr;
+  quantize_b_qm(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                dequant_ptr, eob_ptr, iscan_ptr, qm_ptr, iqm_ptr, 0);
+}
+
+void vpx_quantize_b_32x32_sse2(
+    const tran_low_t* coeff_ptr, intptr_t n_coeffs, int skip_block,
+    const int16_t* zbin_ptr, const int16_t* round_ptr, const int16_t* quant_ptr,
+    const int16_t* quant_shift_ptr, tran_low_t* qcoeff_ptr,
+    tran_low_t* dqcoeff_ptr, const int16_t* dequant_ptr, uint16_t* eob_ptr,
+    const int16_t* scan_ptr, const int16_t* iscan_ptr, const qm_val_t* qm_ptr,
+    const qm_val_t* iqm_ptr) {
+  (void)scan_ptr;
+  quantize_b_qm(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                dequant_ptr, eob_ptr, iscan_ptr, qm_ptr, iqm_ptr, 1);
+}
+#else
 void vpx_quantize_b_sse2(const tran_low_t* coeff_ptr, intptr_t n_coeffs,
                          int skip_block, const int16_t* zbin_ptr,
                          const int16_t* round_ptr, const int16_t* quant_ptr,
@@ -246,3 +383,4 @@ void vpx_quantize_b_sse2(const tran_low_t* coeff_ptr, intptr_t n_coeffs,
     *eob_ptr = 0;
   }
 }
+#endif  // CONFIG_AOM_QM
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_DSP_X86_QUANTIZE_SSE2_H_
+#define VPX_DSP_X86_QUANTIZE_SSE2_H_
+
+#include <emmintrin.h>
+
+#include "vpx_dsp/vpx_dsp_common.h"
+
+// Helpers for the quantizers that apply the quantization matrices. The
+// weights take the products past 16 bits, so eight values are carried in
+// 32 bits as a pair of registers: lo holds the first four, hi the rest.
+
+// Sign-extends eight 16-bit values to 32 bits.
+static INLINE void extend_epi16_epi32(__m128i a, __m128i *lo, __m128i *hi) {
+  *lo = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+  *hi = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+}
+
+// Returns the 32-bit products of eight pairs of unsigned 16-bit values.
+static INLINE void mul_epu16_epi32(__m128i a, __m128i b, __m128i *lo,
+                                   __m128i *hi) {
+  const __m128i l = _mm_mullo_epi16(a, b);
+  const __m128i h = _mm_mulhi_epu16(a, b);
+  *lo = _mm_unpacklo_epi16(l, h);
+  *hi = _mm_unpackhi_epi16(l, h);
+}
+
+// Splits eight 32-bit values into their low (unsigned) and high (signed)
+// 16-bit halves.
+static INLINE void split_epi32(__m128i lo, __m128i hi, __m128i *xl,
+                               __m128i *xh) {
+  *xl = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                        _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+  *xh = _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+}
+
+// Narrows eight 32-bit values to 16 bits, wrapping like a C assignment.
+static INLINE __m128i truncate_epi32_epi16(__m128i lo, __m128i hi) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+}
+
+// Returns (xl * q) >> 16 for unsigned xl and signed q. It always fits in 16
+// bits. _mm_mulhi_epu16() reads a negative q as q + 65536, which adds xl to
+// the result, so that is taken off again.
+static INLINE __m128i mulhi_epu16_epi16(__m128i xl, __m128i q) {
+  return _mm_sub_epi16(_mm_mulhi_epu16(xl, q),
+                       _mm_and_si128(xl, _mm_srai_epi16(q, 15)));
+}
+
+// Returns the low 32 bits of x * q, for eight 32-bit values x given as
+// halves from split_epi32() and signed 16-bit q.
+static INLINE void mullo_epi32_epi16(__m128i xl, __m128i xh, __m128i q,
+                                     __m128i *lo, __m128i *hi) {
+  const __m128i l = _mm_mullo_epi16(xl, q);
+  const __m128i h =
+      _mm_add_epi16(mulhi_epu16_epi16(xl, q), _mm_mullo_epi16(xh, q));
+  *lo = _mm_unpacklo_epi16(l, h);
+  *hi = _mm_unpackhi_epi16(l, h);
+}
+
+// Returns (x * q) >> 16, for eight non-negative 32-bit values x below 2^31
+// given as halves from split_epi32() and signed 16-bit q. Unlike the 16-bit
+// _mm_mulhi_epi16() there is no overflow: x * q needs up to 47 bits.
+static INLINE void mulhi_epi32_epi16(__m128i xl, __m128i xh, __m128i q,
+                                     __m128i *lo, __m128i *hi) {
+  const __m128i pl = _mm_mullo_epi16(xh, q);
+  const __m128i ph = _mm_mulhi_epi16(xh, q);
+  __m128i l, h;
+  extend_epi16_epi32(mulhi_epu16_epi16(xl, q), &l, &h);
+  *lo = _mm_add_epi32(_mm_unpacklo_epi16(pl, ph), l);
+  *hi = _mm_add_epi32(_mm_unpackhi_epi16(pl, ph), h);
+}
+
+#if CONFIG_AOM_QM
+// Returns the weighted dequantizer
+// (dequant * iwt + (1 << (AOM_QM_BITS - 1))) >> AOM_QM_BITS.
+static INLINE void qm_dequant_epi32(__m128i dequant, __m128i iwt, __m128i *lo,
+                                    __m128i *hi) {
+  const __m128i rounding = _mm_set1_epi32(1 << (AOM_QM_BITS - 1));
+  mul_epu16_epi32(dequant, iwt, lo, hi);
+  *lo = _mm_srai_epi32(_mm_add_epi32(*lo, rounding), AOM_QM_BITS);
+  *hi = _mm_srai_epi32(_mm_add_epi32(*hi, rounding), AOM_QM_BITS);
+}
+#endif  // CONFIG_AOM_QM
+
+// Halves eight 32-bit values, rounding towards zero like C division.
+static INLINE void half_epi32(__m128i *lo, __m128i *hi) {
+  *lo = _mm_srai_epi32(_mm_add_epi32(*lo, _mm_srli_epi32(*lo, 31)), 1);
+  *hi = _mm_srai_epi32(_mm_add_epi32(*hi, _mm_srli_epi32(*hi, 31)), 1);
+}
+
+// Returns the eob from the largest iscan + 1 accumulated in eob.
+static INLINE uint16_t accumulate_eob(__m128i eob) {
+  __m128i eob_shuffled;
+  eob_shuffled = _mm_shuffle_epi32(eob, 0xe);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  eob_shuffled = _mm_shufflelo_epi16(eob, 0xe);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  eob_shuffled = _mm_shufflelo_epi16(eob, 0x1);
+  eob = _mm_max_epi16(eob, eob_shuffled);
+  return _mm_extract_epi16(eob, 1);
+}
+
+#endif  // VPX_DSP_X86_QUANTIZE_SSE2_H_
@@ -0,0 +1,467 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // For the CPU affinity functions.
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#if CONFIG_MULTITHREAD && defined(__linux__)
+#include <sched.h>
+#include <stdio.h>
+#define HAVE_THREAD_AFFINITY 1
+#else
+#define HAVE_THREAD_AFFINITY 0
+#endif
+
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#if CONFIG_MULTITHREAD
+#include "vpx_ports/vpx_once.h"
+#endif
+#include "vpx_util/vpx_thread_pool.h"
+
+// The most NUMA nodes looked up for VPX_THREAD_AFFINITY_NODE.
+#define MAX_NODES 64
+
+struct VPxThreadPool {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+  // Signalled when a group gets queued jobs, or when the pool shuts down.
+  pthread_cond_t work;
+  pthread_t threads[VPX_THREAD_POOL_MAX_THREADS];
+#endif
+#if HAVE_THREAD_AFFINITY
+  vpx_codec_thread_affinity_t affinity;
+  // The CPUs the pool was created on, and the part of them on each NUMA node.
+  cpu_set_t cpus;
+  cpu_set_t *node_cpus;
+  int num_nodes;
+#endif
+  int num_threads;
+  int shutdown;
+  int refs;
+  // The groups with queued jobs, in the order the threads serve them.
+  VPxJobGroup *first;
+  VPxJobGroup *last;
+};
+
+static int run_job(const VPxJob *job) {
+  return job->hook == NULL || job->hook(job->data1, job->data2);
+}
+
+#if CONFIG_MULTITHREAD
+// The shared pool and the lock on its reference count.
+static VPxThreadPool *shared_pool;
+static pthread_mutex_t shared_pool_mutex;
+
+static void init_shared_pool_mutex(void) {
+  pthread_mutex_init(&shared_pool_mutex, NULL);
+}
+
+#if HAVE_THREAD_AFFINITY
+// Reads the CPUs of NUMA node 'node' from sysfs. Returns 0 if there is no
+// such node.
+static int read_node_cpus(int node, cpu_set_t *set) {
+  char path[64];
+  FILE *file;
+  int first, last, c;
+
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  file = fopen(path, "r");
+  if (file == NULL) return 0;
+  CPU_ZERO(set);
+  // The list looks like "0-15,32-47".
+  while (fscanf(file, "%d", &first) == 1) {
+    last = first;
+    c = fgetc(file);
+    if (c == '-') {
+      if (fscanf(file, "%d", &last) != 1) break;
+      c = fgetc(file);
+    }
+    for (; first <= last && first < CPU_SETSIZE; ++first) CPU_SET(first, set);
+    if (c != ',') break;
+  }
+  fclose(file);
+  return 1;
+}
+
+// Splits the CPUs of 'pool' by NUMA node. CPUs outside of any node, which is
+// all of them without NUMA, count as one more node.
+static int find_nodes(VPxThreadPool *pool) {
+  cpu_set_t rest = pool->cpus;
+  cpu_set_t set;
+  int node;
+
+  pool->node_cpus =
+      (cpu_set_t *)vpx_malloc((MAX_NODES + 1) * sizeof(*pool->node_cpus));
+  if (pool->node_cpus == NULL) return 0;
+  pool->num_nodes = 0;
+  for (node = 0; node < MAX_NODES; ++node) {
+    cpu_set_t *const node_cpus = &pool->node_cpus[pool->num_nodes];
+    if (!read_node_cpus(node, &set)) continue;
+    CPU_AND(node_cpus, &set, &pool->cpus);
+    if (CPU_COUNT(node_cpus) == 0) continue;
+    CPU_XOR(&rest, &rest, node_cpus);
+    ++pool->num_nodes;
+  }
+  if (CPU_COUNT(&rest) > 0) pool->node_cpus[pool->num_nodes++] = rest;
+  return 1;
+}
+
+// Pins thread 'index' of 'pool'. The threads fill the nodes in turn, so that
+// a pool with fewer threads than a node has CPUs stays on that node. The pool
+// mutex must be held.
+static int pin_thread(VPxThreadPool *pool, int index) {
+  cpu_set_t set = pool->cpus;
+
+  if (pool->affinity != VPX_THREAD_AFFINITY_NONE) {
+    int n = index % CPU_COUNT(&pool->cpus);
+    const cpu_set_t *node_cpus = pool->node_cpus;
+    int cpu;
+
+    while (n >= CPU_COUNT(node_cpus)) {
+      n -= CPU_COUNT(node_cpus);
+      ++node_cpus;
+    }
+    if (pool->affinity == VPX_THREAD_AFFINITY_NODE) {
+      set = *node_cpus;
+    } else {
+      // The n-th CPU of the node.
+      for (cpu = 0;; ++cpu) {
+        if (CPU_ISSET(cpu, node_cpus) && n-- == 0) break;
+      }
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+    }
+  }
+  return !pthread_setaffinity_np(pool->threads[index], sizeof(set), &set);
+}
+#endif  // HAVE_THREAD_AFFINITY
+
+// Takes the first queued job of 'group'. The pool mutex must be held.
+static VPxJob take_job(VPxThreadPool *pool, VPxJobGroup *group) {
+  const VPxJob job = group->jobs[group->head++];
+  VPxJobGroup *prev = NULL;
+  VPxJobGroup *g = pool->first;
+  if (group->head < group->tail) return job;
+
+  // The group has no queued jobs left, remove it from the pool.
+  while (g != group) {
+    prev = g;
+    g = g->next;
+  }
+  if (prev != NULL)
+    prev->next = group->next;
+  else
+    pool->first = group->next;
+  if (pool->last == group) pool->last = prev;
+  group->next = NULL;
+  return job;
+}
+
+// Doubles the queue of 'group'. The pool mutex must be held.
+static int grow_jobs(VPxJobGroup *group) {
+  const int size = 2 * group->size;
+  VPxJob *const jobs = (VPxJob *)vpx_malloc(size * sizeof(*jobs));
+  if (jobs == NULL) return 0;
+  memcpy(jobs, group->jobs, group->tail * sizeof(*jobs));
+  if (group->jobs != group->local_jobs) vpx_free(group->jobs);
+  group->jobs = jobs;
+  group->size = size;
+  return 1;
+}
+
+// Records the end of a job of 'group'. The pool mutex must be held.
+static void finish_job(VPxJobGroup *group, int ok) {
+  group->had_error |= !ok;
+  if (--group->pending == 0) pthread_cond_signal(&group->done);
+}
+
+static THREADFN thread_loop(void *ptr) {
+  VPxThreadPool *const pool = (VPxThreadPool *)ptr;
+  pthread_mutex_lock(&pool->mutex);
+  while (1) {
+    VPxJobGroup *group;
+    VPxJob job;
+    int ok;
+
+    while (pool->first == NULL && !pool->shutdown)
+      pthread_cond_wait(&pool->work, &pool->mutex);
+    if (pool->first == NULL) break;
+
+    // Serve the groups in turn: move the group to the back of the queue.
+    group = pool->first;
+    if (group->next != NULL) {
+      pool->first = group->next;
+      pool->last->next = group;
+      pool->last = group;
+      group->next = NULL;
+    }
+    job = take_job(pool, group);
+
+    pthread_mutex_unlock(&pool->mutex);
+    ok = run_job(&job);
+    pthread_mutex_lock(&pool->mutex);
+    finish_job(group, ok);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  return THREAD_RETURN(NULL);
+}
+#endif  // CONFIG_MULTITHREAD
+
+VPxThreadPool *vpx_thread_pool_create(int num_threads) {
+  VPxThreadPool *const pool = (VPxThreadPool *)vpx_calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+  pool->refs = 1;
+#if CONFIG_MULTITHREAD
+  if (pthread_mutex_init(&pool->mutex, NULL)) {
+    vpx_free(pool);
+    return NULL;
+  }
+  if (pthread_cond_init(&pool->work, NULL)) {
+    pthread_mutex_destroy(&pool->mutex);
+    vpx_free(pool);
+    return NULL;
+  }
+#endif  // CONFIG_MULTITHREAD
+#if HAVE_THREAD_AFFINITY
+  if (sched_getaffinity(0, sizeof(pool->cpus), &pool->cpus))
+    CPU_ZERO(&pool->cpus);
+#endif  // HAVE_THREAD_AFFINITY
+  vpx_thread_pool_reserve(pool, num_threads);
+  return pool;
+}
+
+static void destroy_pool(VPxThreadPool *pool) {
+#if CONFIG_MULTITHREAD
+  int i;
+  pthread_mutex_lock(&pool->mutex);
+  assert(pool->first == NULL);
+  pool->shutdown = 1;
+  for (i = 0; i < pool->num_threads; ++i) pthread_cond_signal(&pool->work);
+  pthread_mutex_unlock(&pool->mutex);
+  for (i = 0; i < pool->num_threads; ++i) pthread_join(pool->threads[i], NULL);
+  pthread_cond_destroy(&pool->work);
+  pthread_mutex_destroy(&pool->mutex);
+#endif  // CONFIG_MULTITHREAD
+#if HAVE_THREAD_AFFINITY
+  vpx_free(pool->node_cpus);
+#endif
+  vpx_free(pool);
+}
+
+VPxThreadPool *vpx_thread_pool_get_shared(int num_threads) {
+#if CONFIG_MULTITHREAD
+  VPxThreadPool *pool;
+  once(init_shared_pool_mutex);
+  pthread_mutex_lock(&shared_pool_mutex);
+  if (shared_pool == NULL) {
+    shared_pool = vpx_thread_pool_create(num_threads);
+  } else {
+    ++shared_pool->refs;
+    vpx_thread_pool_reserve(shared_pool, num_threads);
+  }
+  pool = shared_pool;
+  pthread_mutex_unlock(&shared_pool_mutex);
+  return pool;
+#else
+  return vpx_thread_pool_create(num_threads);
+#endif  // CONFIG_MULTITHREAD
+}
+
+VPxThreadPool *vpx_thread_pool_retain(VPxThreadPool *pool) {
+  if (pool == NULL) return NULL;
+#if CONFIG_MULTITHREAD
+  once(init_shared_pool_mutex);
+  pthread_mutex_lock(&shared_pool_mutex);
+  ++pool->refs;
+  pthread_mutex_unlock(&shared_pool_mutex);
+#else
+  ++pool->refs;
+#endif  // CONFIG_MULTITHREAD
+  return pool;
+}
+
+void vpx_thread_pool_release(VPxThreadPool *pool) {
+  int refs;
+  if (pool == NULL) return;
+#if CONFIG_MULTITHREAD
+  // The shared pool lock also guards the counts of the other pools, so that
+  // vpx_thread_pool_get_shared() never hands out a pool being destroyed.
+  once(init_shared_pool_mutex);
+  pthread_mutex_lock(&shared_pool_mutex);
+  refs = --pool->refs;
+  if (refs == 0 && pool == shared_pool) shared_pool = NULL;
+  pthread_mutex_unlock(&shared_pool_mutex);
+#else
+  refs = --pool->refs;
+#endif  // CONFIG_MULTITHREAD
+  if (refs == 0) destroy_pool(pool);
+}
+
+int vpx_thread_pool_reserve(VPxThreadPool *pool, int num_threads) {
+  int threads;
+#if CONFIG_MULTITHREAD
+  if (num_threads > VPX_THREAD_POOL_MAX_THREADS)
+    num_threads = VPX_THREAD_POOL_MAX_THREADS;
+  pthread_mutex_lock(&pool->mutex);
+  while (pool->num_threads < num_threads) {
+    if (pthread_create(&pool->threads[pool->num_threads], NULL, thread_loop,
+                       pool))
+      break;
+#if HAVE_THREAD_AFFINITY
+    if (pool->affinity != VPX_THREAD_AFFINITY_NONE)
+      pin_thread(pool, pool->num_threads);
+#endif
+    ++pool->num_threads;
+  }
+  threads = pool->num_threads;
+  pthread_mutex_unlock(&pool->mutex);
+#else
+  (void)pool;
+  (void)num_threads;
+  threads = 0;
+#endif  // CONFIG_MULTITHREAD
+  return threads;
+}
+
+int vpx_thread_pool_num_threads(VPxThreadPool *pool) {
+  int threads;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->mutex);
+  threads = pool->num_threads;
+  pthread_mutex_unlock(&pool->mutex);
+#else
+  threads = pool->num_threads;
+#endif  // CONFIG_MULTITHREAD
+  return threads;
+}
+
+vpx_codec_err_t vpx_thread_pool_set_affinity(
+    VPxThreadPool *pool, vpx_codec_thread_affinity_t affinity) {
+#if HAVE_THREAD_AFFINITY
+  vpx_codec_err_t res = VPX_CODEC_OK;
+  int i;
+
+  if (CPU_COUNT(&pool->cpus) == 0) return VPX_CODEC_INCAPABLE;
+  pthread_mutex_lock(&pool->mutex);
+  if (pool->node_cpus == NULL && !find_nodes(pool)) {
+    pthread_mutex_unlock(&pool->mutex);
+    return VPX_CODEC_MEM_ERROR;
+  }
+  pool->affinity = affinity;
+  for (i = 0; i < pool->num_threads; ++i)
+    if (!pin_thread(pool, i)) res = VPX_CODEC_ERROR;
+  pthread_mutex_unlock(&pool->mutex);
+  return res;
+#else
+  (void)pool;
+  return affinity == VPX_THREAD_AFFINITY_NONE ? VPX_CODEC_OK
+                                              : VPX_CODEC_INCAPABLE;
+#endif  // HAVE_THREAD_AFFINITY
+}
+
+void vpx_job_group_init(VPxJobGroup *group, VPxThreadPool *pool) {
+  group->pool = pool != NULL && vpx_thread_pool_num_threads(pool) ? pool : NULL;
+  group->jobs = group->local_jobs;
+  group->size = VPX_JOB_GROUP_SIZE;
+  group->head = 0;
+  group->tail = 0;
+  group->pending = 0;
+  group->had_error = 0;
+  group->next_index = 0;
+  group->next = NULL;
+  group->active = 1;
+#if CONFIG_MULTITHREAD
+  if (group->pool != NULL && pthread_cond_init(&group->done, NULL))
+    group->pool = NULL;
+#endif  // CONFIG_MULTITHREAD
+}
+
+int vpx_job_group_submit(VPxJobGroup *group, VPxWorkerHook hook, void *data1,
+                         void *data2) {
+  VPxJob job;
+  assert(group->active);
+  job.hook = hook;
+  job.data1 = data1;
+  job.data2 = data2;
+#if CONFIG_MULTITHREAD
+  if (group->pool != NULL) {
+    VPxThreadPool *const pool = group->pool;
+    pthread_mutex_lock(&pool->mutex);
+    if (group->tail == group->size && !grow_jobs(group)) {
+      group->had_error = 1;
+      pthread_mutex_unlock(&pool->mutex);
+      return 0;
+    }
+    group->jobs[group->tail++] = job;
+    ++group->pending;
+    if (group->head + 1 == group->tail) {
+      // The group had no queued jobs, put it at the back of the pool.
+      if (pool->last != NULL)
+        pool->last->next = group;
+      else
+        pool->first = group;
+      pool->last = group;
+    }
+    pthread_cond_signal(&pool->work);
+    pthread_mutex_unlock(&pool->mutex);
+    return 1;
+  }
+#endif  // CONFIG_MULTITHREAD
+  group->had_error |= !run_job(&job);
+  return 1;
+}
+
+int vpx_job_group_next_index(VPxJobGroup *group) {
+  int index;
+#if CONFIG_MULTITHREAD
+  if (group->pool != NULL) {
+    pthread_mutex_lock(&group->pool->mutex);
+    index = group->next_index++;
+    pthread_mutex_unlock(&group->pool->mutex);
+    return index;
+  }
+#endif  // CONFIG_MULTITHREAD
+  index = group->next_index++;
+  return index;
+}
+
+int vpx_job_group_wait(VPxJobGroup *group) {
+  if (!group->active) return !group->had_error;
+#if CONFIG_MULTITHREAD
+  if (group->pool != NULL) {
+    VPxThreadPool *const pool = group->pool;
+    pthread_mutex_lock(&pool->mutex);
+    while (group->pending) {
+      if (group->head < group->tail) {
+        const VPxJob job = take_job(pool, group);
+        int ok;
+        pthread_mutex_unlock(&pool->mutex);
+        ok = run_job(&job);
+        pthread_mutex_lock(&pool->mutex);
+        finish_job(group, ok);
+      } else {
+        pthread_cond_wait(&group->done, &pool->mutex);
+      }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_cond_destroy(&group->done);
+    if (group->jobs != group->local_jobs) vpx_free(group->jobs);
+  }
+#endif  // CONFIG_MULTITHREAD
+  group->active = 0;
+  return !group->had_error;
+}
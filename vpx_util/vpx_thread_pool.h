@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Pool of worker threads that runs jobs for any number of codec instances.
+//
+// A job is a VPxWorkerHook with its two arguments. Jobs are submitted to a
+// job group, whose owner later waits for all of them to finish. Each group
+// keeps its queued jobs in submission order. A single mutex per pool guards
+// all of the queues, and idle pool threads take one job at a time from the
+// groups with queued jobs in turn, so that instances sharing a pool share its
+// threads fairly. There are no per-thread queues and no work stealing. The
+// waiting owner runs the jobs at the front of its own group's queue that no
+// pool thread has taken yet. A group's owner never sleeps while its group has
+// queued jobs, so the jobs of a group may wait for each other as long as they
+// only wait for work that was handed out (in order) to jobs that have already
+// started.
+
+#ifndef VPX_UTIL_VPX_THREAD_POOL_H_
+#define VPX_UTIL_VPX_THREAD_POOL_H_
+
+#include "./vpx_config.h"
+#include "vpx/vpx_codec.h"
+#include "vpx_util/vpx_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The most threads a pool runs.
+#define VPX_THREAD_POOL_MAX_THREADS MAX_NUM_THREADS
+
+// The number of queued jobs a group holds without allocating memory. Its queue
+// is grown past that.
+#define VPX_JOB_GROUP_SIZE 64
+
+typedef struct VPxThreadPool VPxThreadPool;
+
+typedef struct VPxJob {
+  VPxWorkerHook hook;
+  void *data1;
+  void *data2;
+} VPxJob;
+
+// The jobs submitted by one owner, see vpx_job_group_init().
+typedef struct VPxJobGroup {
+  VPxThreadPool *pool;
+  // The queued jobs are jobs[head] to jobs[tail - 1], out of 'size'. 'jobs'
+  // points to 'local_jobs' until the queue is grown.
+  VPxJob *jobs;
+  int size;
+  int head;
+  int tail;
+  // Jobs submitted and not finished yet.
+  int pending;
+  int had_error;
+  // The next index handed out by vpx_job_group_next_index().
+  int next_index;
+  int active;
+#if CONFIG_MULTITHREAD
+  pthread_cond_t done;
+#endif
+  // The next group with queued jobs in the pool.
+  struct VPxJobGroup *next;
+  VPxJob local_jobs[VPX_JOB_GROUP_SIZE];
+} VPxJobGroup;
+
+// Creates a pool of 'num_threads' threads, holding one reference to it.
+// Returns NULL on failure.
+VPxThreadPool *vpx_thread_pool_create(int num_threads);
+
+// Returns the pool shared by the whole process, holding a reference to it,
+// after growing it to at least 'num_threads' threads. Returns NULL on failure.
+VPxThreadPool *vpx_thread_pool_get_shared(int num_threads);
+
+// Takes another reference to 'pool', which may be NULL. Returns 'pool'.
+VPxThreadPool *vpx_thread_pool_retain(VPxThreadPool *pool);
+
+// Drops a reference to 'pool'. The pool is destroyed, and its threads are
+// joined, with the last reference. 'pool' may be NULL.
+void vpx_thread_pool_release(VPxThreadPool *pool);
+
+// Grows 'pool' to at least 'num_threads' threads, up to
+// VPX_THREAD_POOL_MAX_THREADS. Returns the number of threads of the pool.
+int vpx_thread_pool_reserve(VPxThreadPool *pool, int num_threads);
+
+int vpx_thread_pool_num_threads(VPxThreadPool *pool);
+
+// Pins the threads of 'pool', including those it starts later. Returns
+// VPX_CODEC_INCAPABLE if the platform cannot pin threads.
+vpx_codec_err_t vpx_thread_pool_set_affinity(
+    VPxThreadPool *pool, vpx_codec_thread_affinity_t affinity);
+
+// Prepares 'group' to run jobs on 'pool'. With a NULL pool, or one without
+// threads, jobs run as they are submitted. vpx_job_group_wait() must be
+// called before 'group' is initialized again.
+void vpx_job_group_init(VPxJobGroup *group, VPxThreadPool *pool);
+
+// Queues hook(data1, data2) to run on 'group'. Returns 0 if the queue could
+// not be grown: the job is not run then, and the group fails.
+// vpx_job_group_wait() must still be called for the jobs queued before.
+int vpx_job_group_submit(VPxJobGroup *group, VPxWorkerHook hook, void *data1,
+                         void *data2);
+
+// Returns the indices 0, 1, 2... in turn to the jobs of 'group', for jobs
+// that share out a list of work items between themselves.
+int vpx_job_group_next_index(VPxJobGroup *group);
+
+// Runs or waits for the jobs of 'group' until all are finished. Returns 0 if
+// a hook or a submission failed. Does nothing if 'group' has already been
+// waited for.
+int vpx_job_group_wait(VPxJobGroup *group);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_UTIL_VPX_THREAD_POOL_H_
@@ -12,3 +12,5 @@ UTIL_SRCS-yes += vpx_util.mk
 UTIL_SRCS-yes += vpx_thread.c
 UTIL_SRCS-yes += vpx_thread.h
 UTIL_SRCS-yes += endian_inl.h
+UTIL_SRCS-yes += vpx_thread_pool.c
+UTIL_SRCS-yes += vpx_thread_pool.h
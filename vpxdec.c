@@ -76,6 +76,8 @@ static const arg_def_t threadsarg =
     ARG_DEF("t", "threads", 1, "Max threads to use");
 static const arg_def_t frameparallelarg =
     ARG_DEF(NULL, "frame-parallel", 0, "Frame parallel decode");
+static const arg_def_t parseaheadarg = ARG_DEF(
+    NULL, "parse-ahead", 0, "Parse superblock rows before reconstructing");
 static const arg_def_t verbosearg =
     ARG_DEF("v", "verbose", 0, "Show version string");
 static const arg_def_t error_concealment =
@@ -97,8 +99,8 @@ static const arg_def_t outbitdeptharg =
 static const arg_def_t *all_args[] = {
   &codecarg, &use_yv12, &use_i420, &flipuvarg, &rawvideo, &noblitarg,
   &progressarg, &limitarg, &skiparg, &postprocarg, &summaryarg, &outputfile,
-  &threadsarg, &frameparallelarg, &verbosearg, &scalearg, &fb_arg,
-  &md5arg, &error_concealment, &continuearg,
+  &threadsarg, &frameparallelarg, &parseaheadarg, &verbosearg, &scalearg,
+  &fb_arg, &md5arg, &error_concealment, &continuearg,
 #if CONFIG_VPX_HIGHBITDEPTH
   &outbitdeptharg,
 #endif
@@ -470,7 +472,7 @@ static int main_loop(int argc, const char **argv_) {
   size_t bytes_in_buffer = 0, buffer_size = 0;
   FILE *infile;
   int frame_in = 0, frame_out = 0, flipuv = 0, noblit = 0;
-  int do_md5 = 0, progress = 0, frame_parallel = 0;
+  int do_md5 = 0, progress = 0, frame_parallel = 0, parse_ahead = 0;
   int stop_after = 0, postproc = 0, summary = 0, quiet = 1;
   int arg_skip = 0;
   int ec_enabled = 0;
@@ -563,6 +565,8 @@ static int main_loop(int argc, const char **argv_) {
 #if CONFIG_VP10_DECODER
     else if (arg_match(&arg, &frameparallelarg, argi))
       frame_parallel = 1;
+    else if (arg_match(&arg, &parseaheadarg, argi))
+      parse_ahead = 1;
 #endif
     else if (arg_match(&arg, &verbosearg, argi))
       quiet = 0;
@@ -677,6 +681,15 @@ static int main_loop(int argc, const char **argv_) {
 
   if (!quiet) fprintf(stderr, "%s\n", decoder.name);
 
+#if CONFIG_VP10_DECODER
+  if (parse_ahead &&
+      vpx_codec_control(&decoder, VP10D_SET_PARSE_AHEAD, parse_ahead)) {
+    fprintf(stderr, "Failed to set parse ahead: %s\n",
+            vpx_codec_error(&decoder));
+    return EXIT_FAILURE;
+  }
+#endif
+
   if (arg_skip) fprintf(stderr, "Skipping first %d frames.\n", arg_skip);
   while (arg_skip) {
     if (read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) break;
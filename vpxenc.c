@@ -363,6 +363,9 @@ static const arg_def_t tile_cols =
     ARG_DEF(NULL, "tile-columns", 1, "Number of tile columns to use, log2");
 static const arg_def_t tile_rows =
     ARG_DEF(NULL, "tile-rows", 1, "Number of tile rows to use, log2");
+static const arg_def_t row_mt = ARG_DEF(
+    NULL, "row-mt", 1,
+    "Encode superblock rows in parallel (0: false (default), 1: true)");
 static const arg_def_t lossless =
     ARG_DEF(NULL, "lossless", 1, "Lossless mode (0: false (default), 1: true)");
 #if CONFIG_AOM_QM
@@ -446,7 +449,8 @@ static const arg_def_t *vp10_args[] = {
 #endif
   &frame_parallel_decoding, &aq_mode,          &frame_periodic_boost,
   &noise_sens,              &tune_content,     &input_color_space,
-  &min_gf_interval,         &max_gf_interval,  NULL
+  &min_gf_interval,         &max_gf_interval,  &row_mt,
+  NULL
 };
 static const int vp10_arg_ctrl_map[] = {
   VP8E_SET_CPUUSED,                 VP8E_SET_ENABLEAUTOALTREF,
@@ -465,7 +469,7 @@ static const int vp10_arg_ctrl_map[] = {
   VP9E_SET_FRAME_PERIODIC_BOOST,    VP9E_SET_NOISE_SENSITIVITY,
   VP9E_SET_TUNE_CONTENT,            VP9E_SET_COLOR_SPACE,
   VP9E_SET_MIN_GF_INTERVAL,         VP9E_SET_MAX_GF_INTERVAL,
-  0
+  VP9E_SET_ROW_MT,                  0
 };
 /* clang-format on */
 #endif